@@ -262,6 +262,8 @@ IF(ADD_TESTS)
   ADD_EXECUTABLE(UnitTest_MathMethods tests/MathMethods_TEST.cxx)
   ADD_EXECUTABLE(UnitTest_Spline tests/Spline_TEST.cxx)
   ADD_EXECUTABLE(UnitTest_Density tests/Density_distribution_TEST.cxx)
+  ADD_EXECUTABLE(UnitTest_SurvivalTable tests/SurvivalTable_TEST.cxx)
+  ADD_EXECUTABLE(UnitTest_PropagationRun tests/PropagationRun_TEST.cxx)
 
   TARGET_LINK_LIBRARIES(UnitTest_Utility PROPOSAL ${gtest_LIBRARIES})
   TARGET_LINK_LIBRARIES(UnitTest_Scattering PROPOSAL ${gtest_LIBRARIES})
@@ -290,6 +292,8 @@ IF(ADD_TESTS)
   TARGET_LINK_LIBRARIES(UnitTest_MathMethods PROPOSAL ${gtest_LIBRARIES})
   TARGET_LINK_LIBRARIES(UnitTest_Spline PROPOSAL ${gtest_LIBRARIES})
   TARGET_LINK_LIBRARIES(UnitTest_Density PROPOSAL ${gtest_LIBRARIES})
+  TARGET_LINK_LIBRARIES(UnitTest_SurvivalTable PROPOSAL ${gtest_LIBRARIES})
+  TARGET_LINK_LIBRARIES(UnitTest_PropagationRun PROPOSAL ${gtest_LIBRARIES})
 
   ADD_TEST(UnitTest_Utility bin/UnitTest_Utility)
   ADD_TEST(UnitTest_Scattering bin/UnitTest_Scattering)
@@ -318,6 +322,8 @@ IF(ADD_TESTS)
   ADD_TEST(UnitTest_MathMethods bin/UnitTest_MathMethods)
   ADD_TEST(UnitTest_Spline bin/UnitTest_Spline)
   ADD_TEST(UnitTest_Density bin/UnitTest_Density)
+  ADD_TEST(UnitTest_SurvivalTable bin/UnitTest_SurvivalTable)
+  ADD_TEST(UnitTest_PropagationRun bin/UnitTest_PropagationRun)
 
 ENDIF()
 
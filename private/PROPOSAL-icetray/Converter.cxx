@@ -136,7 +136,6 @@ PROPOSAL::Particle I3PROPOSALParticleConverter::GeneratePROPOSALParticle(const I
 
     PROPOSAL::Vector3D direction;
     direction.SetSphericalCoordinates(1.0, phi, theta);
-    direction.CalculateCartesianFromSpherical();
     particle.SetDirection(direction);
 
     particle.SetEnergy(energy);
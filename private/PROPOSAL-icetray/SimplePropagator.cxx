@@ -128,7 +128,6 @@ I3Particle SimplePropagator::propagate(const I3Particle& p,
 
     PROPOSAL::Vector3D direction;
     direction.SetSphericalCoordinates(1.0, phi, theta);
-    direction.CalculateCartesianFromSpherical();
     particle.SetDirection(direction);
 
     particle.SetEnergy(energy);
@@ -4,7 +4,9 @@
 
 using namespace PROPOSAL;
 
+std::vector<Secondary> Output::records_;
 std::vector<DynamicData*> Output::secondarys_;
+SecondarySink* Output::sink_ = NULL;
 bool Output::store_in_root_trees_ = false;
 bool Output::store_in_ASCII_file_ = false;
 
@@ -12,44 +14,61 @@ bool Output::store_in_ASCII_file_ = false;
 // ------------------------------------------------------------------------- //
 void Output::FillSecondaryVector(const std::vector<Particle*>& particles)
 {
-    // Do not copy values. This method is used to store particles from the ouput of
-    // the decay channel. The decay channel creates new particle. So the output becomes the owner
-    secondarys_.insert(secondarys_.end(), particles.begin(), particles.end());
+    // This method is used to store particles from the ouput of the decay channel.
+    // The decay channel creates new particle. So the output becomes the owner
+    // and only keeps the records.
+    for (auto particle : particles)
+    {
+        Store(Secondary::Create(*particle));
+        delete particle;
+    }
 }
 
 // ------------------------------------------------------------------------- //
 void Output::FillSecondaryVector(const Particle& particle, const DynamicData::Type& secondary, double energyloss)
 {
-    DynamicData* data = NULL;
-
     if (secondary == DynamicData::Particle)
     {
-        data = new Particle(particle);
         log_fatal("Returning a particle %s\n", particle.GetName().c_str());
-    } else
-    {
-        data = new DynamicData(secondary);
-
-        data->SetEnergy(energyloss);
-        data->SetPosition(particle.GetPosition());
-        data->SetDirection(particle.GetDirection());
-        // TODO(mario): dedcide to have an id Mon 2017/09/11
-        // data->SetParticleId(particle->GetParticleId() + 1);
-        // data->SetParentParticleId(particle->GetParentParticleId());
-        data->SetTime(particle.GetTime());
-        data->SetParentParticleEnergy(particle.GetEnergy());
-        data->SetPropagatedDistance(particle.GetPropagatedDistance());
     }
 
-    secondarys_.push_back(data);
+    Secondary data;
+
+    data.type_id      = secondary;
+    data.particle_def = NULL;
+    data.SetPosition(particle.GetPosition());
+    data.SetDirection(particle.GetDirection());
+    // TODO(mario): dedcide to have an id Mon 2017/09/11
+    // data->SetParticleId(particle->GetParticleId() + 1);
+    // data->SetParentParticleId(particle->GetParentParticleId());
+    data.energy                 = energyloss;
+    data.parent_particle_energy = particle.GetEnergy();
+    data.time                   = particle.GetTime();
+    data.propagated_distance    = particle.GetPropagatedDistance();
+    data.weight                 = particle.GetWeight();
+
+    Store(data);
 }
 
 // ------------------------------------------------------------------------- //
 void Output::FillSecondaryVector(DynamicData* continuous_loss)
 {
     // same like the decay output but for the continuous energy losses
-    secondarys_.push_back(continuous_loss);
+    Store(Secondary::Create(*continuous_loss));
+    delete continuous_loss;
 }
+
+// ------------------------------------------------------------------------- //
+std::vector<DynamicData*> Output::GetSecondarys() const
+{
+    for (size_t i = secondarys_.size(); i < records_.size(); ++i)
+    {
+        secondarys_.push_back(records_[i].CreateDynamicData());
+    }
+
+    return secondarys_;
+}
+
 // ------------------------------------------------------------------------- //
 void Output::ClearSecondaryVector()
 {
@@ -58,6 +77,7 @@ void Output::ClearSecondaryVector()
         delete secondarys_[i];
     }
     secondarys_.clear();
+    records_.clear();
 }
 
 // ------------------------------------------------------------------------- //
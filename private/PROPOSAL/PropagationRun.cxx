@@ -0,0 +1,347 @@
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "PROPOSAL/PropagationRun.h"
+#include "PROPOSAL/Propagator.h"
+
+#include "PROPOSAL/crossection/CrossSection.h"
+#include "PROPOSAL/crossection/parametrization/Parametrization.h"
+#include "PROPOSAL/geometry/Geometry.h"
+#include "PROPOSAL/math/RandomGenerator.h"
+#include "PROPOSAL/medium/Medium.h"
+
+#include "PROPOSAL/Logging.h"
+#include "PROPOSAL/methods.h"
+
+using namespace PROPOSAL;
+
+namespace {
+
+const char* CHECKPOINT_HEADER = "PROPOSAL_CHECKPOINT";
+const int CHECKPOINT_VERSION  = 1;
+
+// ----------------------------------------------------------------------------
+/// @brief Output of the stream operators without the object addresses
+///
+/// The headers contain the address of the printed object, which differs
+/// from run to run. The values are printed with all digits, so also small
+/// changes of the configuration change the identity.
+// ----------------------------------------------------------------------------
+template<class T>
+std::string Describe(const T& object)
+{
+    std::stringstream printed;
+    printed << std::setprecision(std::numeric_limits<double>::max_digits10) << object;
+
+    std::string description = printed.str();
+    size_t position         = description.find("0x");
+
+    while (position != std::string::npos)
+    {
+        size_t end = position + 2;
+        while (end < description.size() && std::isxdigit(static_cast<unsigned char>(description[end])))
+        {
+            ++end;
+        }
+
+        description.erase(position, end - position);
+        position = description.find("0x", position);
+    }
+
+    return description;
+}
+
+// ----------------------------------------------------------------------------
+/// @brief Shortens a file to the given size
+///
+/// The beginning of the file is copied to a temporary file, which replaces
+/// the file afterwards, so only the standard library is needed.
+// ----------------------------------------------------------------------------
+bool TruncateFile(const std::string& path, std::streamoff size)
+{
+    std::string tmp_path = path + ".tmp";
+
+    {
+        std::ifstream input(path.c_str(), std::ios::binary);
+        std::ofstream output(tmp_path.c_str(), std::ios::binary | std::ios::trunc);
+
+        std::vector<char> buffer(1 << 20);
+
+        while (size > 0 && input && output)
+        {
+            std::streamsize chunk = static_cast<std::streamsize>(
+                std::min(size, static_cast<std::streamoff>(buffer.size())));
+
+            input.read(&buffer[0], chunk);
+            output.write(&buffer[0], input.gcount());
+
+            size -= input.gcount();
+        }
+
+        output.close();
+
+        if (size > 0 || output.fail())
+        {
+            std::remove(tmp_path.c_str());
+            return false;
+        }
+    }
+
+    // rename does not replace an existing file on every platform
+    std::remove(path.c_str());
+    return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+// 64 bit FNV-1a hash of the description
+std::string Hash(const std::string& text)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        hash ^= static_cast<unsigned char>(text[i]);
+        hash *= 1099511628211ULL;
+    }
+
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return ss.str();
+}
+
+} // namespace
+
+/******************************************************************************
+ *                              PropagationRun                                *
+ ******************************************************************************/
+
+PropagationRun::PropagationRun(Propagator& propagator, const std::string& checkpoint_file, size_t checkpoint_interval)
+    : propagator_(propagator)
+    , checkpoint_file_(checkpoint_file)
+    , checkpoint_interval_(checkpoint_interval)
+    , identity_(GetIdentity(propagator))
+    , event_(0)
+    , resumed_(false)
+    , rng_state_()
+    , offsets_()
+    , output_paths_()
+    , outputs_()
+{
+    if (Helper::FileExist(checkpoint_file_))
+    {
+        ReadCheckpoint();
+    }
+}
+
+PropagationRun::~PropagationRun()
+{
+    for (auto output : outputs_)
+    {
+        delete output;
+    }
+}
+
+// ------------------------------------------------------------------------- //
+std::ostream& PropagationRun::OpenOutput(const std::string& path)
+{
+    std::ofstream* output = new std::ofstream();
+
+    if (resumed_)
+    {
+        auto offset = offsets_.find(path);
+        if (offset == offsets_.end())
+        {
+            log_fatal("The output '%s' is not part of the checkpoint '%s'!", path.c_str(), checkpoint_file_.c_str());
+        }
+
+        // Everything written after the checkpoint is written again
+        if (!TruncateFile(path, offset->second))
+        {
+            log_fatal("Could not truncate the output '%s' to the checkpoint!", path.c_str());
+        }
+
+        output->open(path.c_str(), std::ios::in | std::ios::out);
+        output->seekp(0, std::ios::end);
+    } else
+    {
+        output->open(path.c_str(), std::ios::out | std::ios::trunc);
+    }
+
+    if (!output->is_open())
+    {
+        log_fatal("Could not open the output '%s'!", path.c_str());
+    }
+
+    output_paths_.push_back(path);
+    outputs_.push_back(output);
+
+    return *output;
+}
+
+// ------------------------------------------------------------------------- //
+size_t PropagationRun::Run(size_t n_events, const PrimaryGenerator& generator, const EventWriter& writer)
+{
+    if (!rng_state_.empty())
+    {
+        std::stringstream rng_state(rng_state_);
+        RandomGenerator::Get().Deserialize(rng_state);
+        rng_state_.clear();
+    }
+
+    Particle& particle = propagator_.GetParticle();
+
+    while (event_ < n_events)
+    {
+        generator(event_, particle);
+
+        const std::vector<Secondary>& secondaries = propagator_.PropagateSecondaries();
+
+        writer(event_, particle, secondaries);
+
+        ++event_;
+
+        if (checkpoint_interval_ > 0 && event_ % checkpoint_interval_ == 0 && event_ < n_events)
+        {
+            Checkpoint();
+        }
+    }
+
+    Checkpoint();
+
+    return event_;
+}
+
+// ------------------------------------------------------------------------- //
+void PropagationRun::Checkpoint()
+{
+    // The checkpoint replaces the old one only when it is complete
+    std::string tmp_file = checkpoint_file_ + ".tmp";
+    std::ofstream checkpoint(tmp_file.c_str());
+
+    checkpoint << CHECKPOINT_HEADER << ' ' << CHECKPOINT_VERSION << '\n';
+    checkpoint << "identity " << identity_ << '\n';
+    checkpoint << "event " << event_ << '\n';
+    checkpoint << "outputs " << outputs_.size() << '\n';
+
+    for (size_t i = 0; i < outputs_.size(); ++i)
+    {
+        outputs_[i]->flush();
+        checkpoint << static_cast<long long>(outputs_[i]->tellp()) << ' ' << output_paths_[i] << '\n';
+    }
+
+    checkpoint << "rng ";
+    RandomGenerator::Get().Serialize(checkpoint);
+    checkpoint << '\n';
+
+    checkpoint.close();
+
+    if (checkpoint.fail() || std::rename(tmp_file.c_str(), checkpoint_file_.c_str()) != 0)
+    {
+        log_fatal("Could not write the checkpoint '%s'!", checkpoint_file_.c_str());
+    }
+
+    log_debug("Checkpoint after %lu events written to '%s'", event_, checkpoint_file_.c_str());
+}
+
+// ------------------------------------------------------------------------- //
+void PropagationRun::ReadCheckpoint()
+{
+    std::ifstream checkpoint(checkpoint_file_.c_str());
+
+    std::string key;
+    std::string identity;
+    int version = 0;
+    size_t n_outputs = 0;
+
+    checkpoint >> key >> version;
+    if (key != CHECKPOINT_HEADER || version != CHECKPOINT_VERSION)
+    {
+        log_fatal("'%s' is not a checkpoint of this version!", checkpoint_file_.c_str());
+    }
+
+    checkpoint >> key >> identity;
+    if (identity != identity_)
+    {
+        log_fatal("The checkpoint '%s' was written with another propagator configuration!", checkpoint_file_.c_str());
+    }
+
+    checkpoint >> key >> event_;
+    checkpoint >> key >> n_outputs;
+
+    for (size_t i = 0; i < n_outputs; ++i)
+    {
+        long long offset;
+        std::string path;
+
+        checkpoint >> offset;
+        checkpoint.ignore(1);
+        std::getline(checkpoint, path);
+
+        offsets_[path] = offset;
+    }
+
+    checkpoint >> key;
+    std::getline(checkpoint, rng_state_);
+
+    if (checkpoint.fail() || key != "rng" || rng_state_.empty())
+    {
+        log_fatal("The checkpoint '%s' is incomplete!", checkpoint_file_.c_str());
+    }
+
+    resumed_ = true;
+
+    log_info("Resume after %lu events from the checkpoint '%s'", event_, checkpoint_file_.c_str());
+}
+
+// ------------------------------------------------------------------------- //
+std::string PropagationRun::GetIdentity(const Propagator& propagator)
+{
+    std::stringstream description;
+    description << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+    const Propagator::Splitting& splitting = propagator.GetSplitting();
+    const std::vector<Sector*> sectors     = propagator.GetSectors();
+
+    if (!sectors.empty())
+    {
+        description << Describe(sectors.front()->GetParticle().GetParticleDef());
+    }
+
+    description << Describe(propagator.GetDetector());
+    description << "splitting " << splitting.multiplicity << ' ' << splitting.split_energy << ' '
+                << splitting.roulette_energy << ' ' << splitting.roulette_survival << '\n';
+
+    for (auto sector : sectors)
+    {
+        const Sector::Definition& def = sector->GetSectorDef();
+
+        description << Describe(*sector->GetGeometry());
+        description << Describe(def.GetMedium());
+        description << Describe(def.GetPropagationCutSettings());
+
+        description << "location " << def.location << '\n';
+        description << "scattering " << def.scattering_model << '\n';
+        description << "options " << def.do_stochastic_loss_weighting << ' ' << def.stochastic_loss_weighting << ' '
+                    << def.stopping_decay << ' ' << def.do_continuous_randomization << ' '
+                    << def.do_continuous_energy_loss_output << ' ' << def.do_exact_time_calculation << ' '
+                    << def.only_loss_inside_detector << ' ' << def.do_range_propagation << '\n';
+
+        for (auto bias : def.interaction_bias)
+        {
+            description << "bias " << bias.first << ' ' << bias.second << '\n';
+        }
+
+        for (auto cross : sector->GetUtility().GetCrosssections())
+        {
+            const Parametrization& parametrization = cross->GetParametrization();
+
+            description << "cross section " << cross->GetTypeId() << ' ' << parametrization.GetName() << ' '
+                        << parametrization.GetHash() << ' ' << parametrization.GetMultiplier() << '\n';
+        }
+    }
+
+    return Hash(description.str());
+}
@@ -7,7 +7,9 @@
 
 // #include <cmath>
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
 #include <PROPOSAL/crossection/factories/PhotoPairFactory.h>
 
 #include "PROPOSAL/Propagator.h"
@@ -15,8 +17,10 @@
 
 #include "PROPOSAL/geometry/Box.h"
 #include "PROPOSAL/geometry/Cylinder.h"
+#include "PROPOSAL/geometry/ExtrudedPolygon.h"
 #include "PROPOSAL/geometry/GeometryFactory.h"
 #include "PROPOSAL/geometry/Sphere.h"
+#include "PROPOSAL/geometry/TriangleMesh.h"
 
 #include "PROPOSAL/medium/MediumFactory.h"
 
@@ -42,9 +46,41 @@ const double Propagator::global_vcut_behind_  = -1;
 const double Propagator::global_cont_inside_  = false;
 const double Propagator::global_cont_infront_ = true;
 const double Propagator::global_cont_behind_  = false;
+const bool Propagator::global_range_propagation_ = false;
 const bool Propagator::do_interpolation_      = true;
 const bool Propagator::uniform_               = true;
 
+// ------------------------------------------------------------------------- //
+// Splitting
+// ------------------------------------------------------------------------- //
+
+Propagator::Splitting::Splitting()
+    : multiplicity(1)
+    , split_energy(0)
+    , roulette_energy(0)
+    , roulette_survival(0.1)
+{
+}
+
+bool Propagator::Splitting::operator==(const Splitting& splitting) const
+{
+    if (multiplicity != splitting.multiplicity)
+        return false;
+    else if (split_energy != splitting.split_energy)
+        return false;
+    else if (roulette_energy != splitting.roulette_energy)
+        return false;
+    else if (roulette_survival != splitting.roulette_survival)
+        return false;
+
+    return true;
+}
+
+bool Propagator::Splitting::operator!=(const Splitting& splitting) const
+{
+    return !(*this == splitting);
+}
+
 // ------------------------------------------------------------------------- //
 // Constructors & destructor
 // ------------------------------------------------------------------------- //
@@ -53,7 +89,12 @@ const bool Propagator::uniform_               = true;
 Propagator::Propagator(const std::vector<Sector*>& sectors, const Geometry& geometry) try
     : current_sector_(NULL),
       particle_(sectors.at(0)->GetParticle()),
-      detector_(geometry.clone())
+      detector_(geometry.clone()),
+      splitting_(),
+      branches_(),
+      branch_states_(),
+      pending_branches_(0),
+      propagated_weight_(1)
 {
     // --------------------------------------------------------------------- //
     // Check if all ParticleDefs are the same
@@ -71,6 +112,8 @@ Propagator::Propagator(const std::vector<Sector*>& sectors, const Geometry& geom
     }
 
     current_sector_ = sectors_.at(0);
+
+    BuildSectorTrees();
 } catch (const std::out_of_range& ex)
 {
     log_fatal("No Sectors are provided for the Propagator!");
@@ -82,10 +125,15 @@ Propagator::Propagator(const ParticleDef& particle_def,
                        const Geometry& geometry)
     : particle_(particle_def)
     , detector_(geometry.clone())
+    , splitting_()
+    , branches_()
+    , branch_states_()
+    , pending_branches_(0)
+    , propagated_weight_(1)
 {
     for (auto def: sector_defs)
     {
-        sectors_.push_back(new Sector(particle_, def));
+        sectors_.push_back(CreateSector(def));
     }
 
     try
@@ -95,6 +143,8 @@ Propagator::Propagator(const ParticleDef& particle_def,
     {
         log_fatal("No Sectors are provided for the Propagator!");
     }
+
+    BuildSectorTrees();
 }
 
 // ------------------------------------------------------------------------- //
@@ -104,10 +154,15 @@ Propagator::Propagator(const ParticleDef& particle_def,
                        const InterpolationDef& interpolation_def)
     : particle_(particle_def)
     , detector_(geometry.clone())
+    , splitting_()
+    , branches_()
+    , branch_states_()
+    , pending_branches_(0)
+    , propagated_weight_(1)
 {
     for (auto def: sector_defs)
     {
-        sectors_.push_back(new Sector(particle_, def, interpolation_def));
+        sectors_.push_back(CreateSector(def, interpolation_def));
     }
 
     try
@@ -117,6 +172,8 @@ Propagator::Propagator(const ParticleDef& particle_def,
     {
         log_fatal("No Sectors are provided for the Propagator!");
     }
+
+    BuildSectorTrees();
 }
 
 // ------------------------------------------------------------------------- //
@@ -125,16 +182,36 @@ Propagator::Propagator(const Propagator& propagator)
     , current_sector_(NULL)
     , particle_(propagator.particle_)
     , detector_(propagator.detector_->clone())
+    , splitting_(propagator.splitting_)
+    , branches_()
+    , branch_states_()
+    , pending_branches_(0)
+    , propagated_weight_(1)
 {
     for (unsigned int i = 0; i < propagator.sectors_.size(); ++i)
     {
-        sectors_[i] = new Sector(particle_, *propagator.sectors_[i]);
+        // Keep the physics shared between the same sectors as in the copied propagator
+        for (unsigned int j = 0; j < i; ++j)
+        {
+            if (propagator.sectors_[i]->SharesPhysics(*propagator.sectors_[j]))
+            {
+                sectors_[i] = new Sector(particle_, propagator.sectors_[i]->GetSectorDef(), *sectors_[j]);
+                break;
+            }
+        }
+
+        if (sectors_[i] == NULL)
+        {
+            sectors_[i] = new Sector(particle_, *propagator.sectors_[i]);
+        }
 
         if (propagator.sectors_[i] == propagator.current_sector_)
         {
             current_sector_ = sectors_[i];
         }
     }
+
+    BuildSectorTrees();
 }
 
 // ------------------------------------------------------------------------- //
@@ -142,6 +219,11 @@ Propagator::Propagator(const ParticleDef& particle_def, const std::string& confi
     : current_sector_(NULL)
     , particle_(particle_def)
     , detector_(NULL)
+    , splitting_()
+    , branches_()
+    , branch_states_()
+    , pending_branches_(0)
+    , propagated_weight_(1)
 {
     int global_seed  = global_seed_;
     bool do_interpolation = do_interpolation_;
@@ -199,7 +281,8 @@ Propagator::Propagator(const ParticleDef& particle_def, const std::string& confi
                                       "cuts_infront",
                                       global_ecut_infront_,
                                       global_vcut_infront_,
-                                      global_cont_infront_);
+                                      global_cont_infront_,
+                                      global_range_propagation_);
     cuts_infront_object = nlohmann::json::parse(cut_object_str);
 
     nlohmann::json cuts_inside_object;
@@ -207,7 +290,8 @@ Propagator::Propagator(const ParticleDef& particle_def, const std::string& confi
                                       "cuts_inside",
                                       global_ecut_inside_,
                                       global_vcut_inside_,
-                                      global_cont_inside_);
+                                      global_cont_inside_,
+                                      global_range_propagation_);
     cuts_inside_object = nlohmann::json::parse(cut_object_str);
 
     nlohmann::json cuts_behind_object;
@@ -215,7 +299,8 @@ Propagator::Propagator(const ParticleDef& particle_def, const std::string& confi
                                       "cuts_behind",
                                       global_ecut_behind_,
                                       global_vcut_behind_,
-                                      global_cont_behind_);
+                                      global_cont_behind_,
+                                      global_range_propagation_);
     cuts_behind_object = nlohmann::json::parse(cut_object_str);
 
     // Read in interpolation options
@@ -279,6 +364,51 @@ Propagator::Propagator(const ParticleDef& particle_def, const std::string& confi
     }
     particle_.GetDecayTable().SetUniformSampling(uniform);
 
+    // read in the splitting and russian roulette settings
+    if (json_global.find("splitting") != json_global.end())
+    {
+        if (json_global["splitting"].is_object())
+        {
+            nlohmann::json json_splitting = json_global["splitting"];
+            Splitting splitting;
+
+            if (json_splitting.find("multiplicity") != json_splitting.end())
+            {
+                if (!json_splitting["multiplicity"].is_number())
+                    log_fatal("Invalid input for option 'multiplicity' of the splitting. Expected a number.");
+                splitting.multiplicity = json_splitting["multiplicity"].get<int>();
+            }
+            if (json_splitting.find("split_energy") != json_splitting.end())
+            {
+                if (!json_splitting["split_energy"].is_number())
+                    log_fatal("Invalid input for option 'split_energy' of the splitting. Expected a number.");
+                splitting.split_energy = json_splitting["split_energy"].get<double>();
+            }
+            if (json_splitting.find("roulette_energy") != json_splitting.end())
+            {
+                if (!json_splitting["roulette_energy"].is_number())
+                    log_fatal("Invalid input for option 'roulette_energy' of the splitting. Expected a number.");
+                splitting.roulette_energy = json_splitting["roulette_energy"].get<double>();
+            }
+            if (json_splitting.find("roulette_survival") != json_splitting.end())
+            {
+                if (!json_splitting["roulette_survival"].is_number())
+                    log_fatal("Invalid input for option 'roulette_survival' of the splitting. Expected a number.");
+                splitting.roulette_survival = json_splitting["roulette_survival"].get<double>();
+            }
+
+            SetSplitting(splitting);
+        }
+        else
+        {
+            log_fatal("Invalid input for option 'splitting'. Expected a json object.");
+        }
+    }
+    else
+    {
+        log_debug("The 'splitting' option is not set. The particles are not split.");
+    }
+
 
     // Parse detector geometry
     if (json_config.find("detector") != json_config.end())
@@ -413,52 +543,60 @@ Propagator::Propagator(const ParticleDef& particle_def, const std::string& confi
                                           "cuts_infront",
                                           cuts_infront_object["e_cut"].get<double>(),
                                           cuts_infront_object["v_cut"].get<double>(),
-                                          cuts_infront_object["cont_rand"].get<bool>());
+                                          cuts_infront_object["cont_rand"].get<bool>(),
+                                          cuts_infront_object["range_propagation"].get<bool>());
 
         json_cutsettings = nlohmann::json::parse(cut_object_str);
         sec_def_infront.cut_settings.SetEcut(json_cutsettings["e_cut"].get<double>());
         sec_def_infront.cut_settings.SetVcut(json_cutsettings["v_cut"].get<double>());
         sec_def_infront.do_continuous_randomization = json_cutsettings["cont_rand"].get<bool>();
+        sec_def_infront.do_range_propagation = json_cutsettings["range_propagation"].get<bool>();
 
         // cut settings inside
         cut_object_str = ParseCutSettings(json_sector_str,
                                           "cuts_inside",
                                           cuts_inside_object["e_cut"].get<double>(),
                                           cuts_inside_object["v_cut"].get<double>(),
-                                          cuts_inside_object["cont_rand"].get<bool>());
+                                          cuts_inside_object["cont_rand"].get<bool>(),
+                                          cuts_inside_object["range_propagation"].get<bool>());
 
         json_cutsettings = nlohmann::json::parse(cut_object_str);
         sec_def_inside.cut_settings.SetEcut(json_cutsettings["e_cut"].get<double>());
         sec_def_inside.cut_settings.SetVcut(json_cutsettings["v_cut"].get<double>());
         sec_def_inside.do_continuous_randomization = json_cutsettings["cont_rand"].get<bool>();
+        sec_def_inside.do_range_propagation = json_cutsettings["range_propagation"].get<bool>();
 
         // cut settings behind
         cut_object_str = ParseCutSettings(json_sector_str,
                                           "cuts_behind",
                                           cuts_behind_object["e_cut"].get<double>(),
                                           cuts_behind_object["v_cut"].get<double>(),
-                                          cuts_behind_object["cont_rand"].get<bool>());
+                                          cuts_behind_object["cont_rand"].get<bool>(),
+                                          cuts_behind_object["range_propagation"].get<bool>());
 
         json_cutsettings = nlohmann::json::parse(cut_object_str);
         sec_def_behind.cut_settings.SetEcut(json_cutsettings["e_cut"].get<double>());
         sec_def_behind.cut_settings.SetVcut(json_cutsettings["v_cut"].get<double>());
         sec_def_behind.do_continuous_randomization = json_cutsettings["cont_rand"].get<bool>();
+        sec_def_behind.do_range_propagation = json_cutsettings["range_propagation"].get<bool>();
 
         if (do_interpolation)
         {
-            sectors_.push_back(new Sector(particle_, sec_def_infront, interpolation_def));
-            sectors_.push_back(new Sector(particle_, sec_def_inside, interpolation_def));
-            sectors_.push_back(new Sector(particle_, sec_def_behind, interpolation_def));
+            sectors_.push_back(CreateSector(sec_def_infront, interpolation_def));
+            sectors_.push_back(CreateSector(sec_def_inside, interpolation_def));
+            sectors_.push_back(CreateSector(sec_def_behind, interpolation_def));
         } else
         {
-            sectors_.push_back(new Sector(particle_, sec_def_infront));
-            sectors_.push_back(new Sector(particle_, sec_def_inside));
-            sectors_.push_back(new Sector(particle_, sec_def_behind));
+            sectors_.push_back(CreateSector(sec_def_infront));
+            sectors_.push_back(CreateSector(sec_def_inside));
+            sectors_.push_back(CreateSector(sec_def_behind));
         }
 
         delete geometry;
         delete med;
     }
+
+    BuildSectorTrees();
 }
 
 Propagator::~Propagator()
@@ -470,6 +608,11 @@ Propagator::~Propagator()
 
     sectors_.clear();
 
+    for (auto branch: branches_)
+    {
+        delete branch;
+    }
+
     delete detector_;
 }
 
@@ -484,6 +627,10 @@ bool Propagator::operator==(const Propagator& propagator) const
     {
         return false;
     }
+    if (splitting_ != propagator.splitting_)
+    {
+        return false;
+    }
     if (sectors_.size() != propagator.sectors_.size())
     {
         return false;
@@ -515,9 +662,38 @@ bool Propagator::operator!=(const Propagator& propagator) const
 // ------------------------------------------------------------------------- //
 std::vector<DynamicData*> Propagator::Propagate(double MaxDistance_cm)
 {
+    PropagateSecondaries(MaxDistance_cm);
+
+    return Output::getInstance().GetSecondarys();
+}
+
+// ------------------------------------------------------------------------- //
+size_t Propagator::PropagateSecondaries(SecondaryBuffer& buffer, double MaxDistance_cm)
+{
+    size_t size = buffer.GetSize();
+
+    Propagate(buffer, MaxDistance_cm);
+
+    return buffer.GetSize() - size;
+}
+
+// ------------------------------------------------------------------------- //
+void Propagator::Propagate(SecondarySink& sink, double MaxDistance_cm)
+{
+    ScopedSecondarySink scoped_sink(sink);
+    PropagateSecondaries(MaxDistance_cm);
+}
+
+// ------------------------------------------------------------------------- //
+const std::vector<Secondary>& Propagator::PropagateSecondaries(double MaxDistance_cm)
+{
+    // The records keep their capacity, so there are no allocations for them
+    // once the first events are propagated.
     Output::getInstance().ClearSecondaryVector();
 
-    Output::getInstance().GetSecondarys().reserve(1000);
+    // The weight of the event is restored at the end, so the biasing of
+    // this event does not carry over to the next one
+    double initial_weight = particle_.GetWeight();
 
 #if ROOT_SUPPORT
     Output::getInstance().StorePrimaryInTree(&particle_);
@@ -526,9 +702,7 @@ std::vector<DynamicData*> Propagator::Propagate(double MaxDistance_cm)
     if (Output::store_in_ASCII_file_)
         Output::getInstance().StorePrimaryInASCII(&particle_);
 
-    double distance = 0;
     double distance_to_closest_approach  = 0;
-    double result   = 0;
 
     // These two variables are needed to calculate the energy loss inside the detector
     // energy_at_entry_point is initialized with the current energy because this is a
@@ -542,13 +716,16 @@ std::vector<DynamicData*> Propagator::Propagate(double MaxDistance_cm)
     Vector3D particle_position  = particle_.GetPosition();
     Vector3D particle_direction = particle_.GetDirection();
 
-    bool starts_in_detector = detector_->IsInside(particle_position, particle_direction);
-    if (starts_in_detector)
+    Geometry::Intersection detector_intersection = detector_->Intersect(particle_position, particle_direction);
+
+    TrackState track;
+    track.starts_in_detector = detector_intersection.location == Geometry::ParticleLocation::InsideGeometry;
+    if (track.starts_in_detector)
     {
         particle_.SetEntryPoint(particle_position);
         particle_.SetEntryEnergy(particle_.GetEnergy());
         particle_.SetEntryTime(particle_.GetTime());
-        distance_to_closest_approach = detector_->DistanceToClosestApproach(particle_position, particle_direction);
+        distance_to_closest_approach = detector_intersection.closest_approach;
         if (distance_to_closest_approach < 0)
         {
             particle_.SetClosestApproachPoint(particle_position);
@@ -556,17 +733,77 @@ std::vector<DynamicData*> Propagator::Propagate(double MaxDistance_cm)
             particle_.SetClosestApproachTime(particle_.GetTime());
         }
     }
+    track.was_in_detector                  = false;
+    track.already_reached_closest_approach = false;
+    track.split                            = false;
+    track.roulette                         = false;
+
+    pending_branches_ = 0;
+
+    PropagateTrack(track, MaxDistance_cm);
+
+    // The copies of a split particle are propagated after the original one
+    while (pending_branches_ > 0)
+    {
+        --pending_branches_;
+        particle_.InjectState(*branches_[pending_branches_]);
+        track = branch_states_[pending_branches_];
+
+        PropagateTrack(track, MaxDistance_cm);
+    }
+
+#if ROOT_SUPPORT
+    Output::getInstance().StorePropagatedPrimaryInTree(&particle_);
+#endif
+    if (Output::store_in_ASCII_file_)
+        Output::getInstance().StorePropagatedPrimaryInASCII(&particle_);
+
+    propagated_weight_ = particle_.GetWeight();
+    particle_.SetWeight(initial_weight);
+
+    return Output::getInstance().GetSecondaryRecords();
+}
+
+// ------------------------------------------------------------------------- //
+void Propagator::PropagateTrack(TrackState& track, double MaxDistance_cm)
+{
+    double distance = 0;
+    double distance_to_closest_approach  = 0;
+    double result   = 0;
+
+    Vector3D particle_position;
+    Vector3D particle_direction;
+
+    // The trajectory of a step is intersected only once with the detector
+    // and the sector geometries
+    Geometry::Intersection detector_intersection;
+    Geometry::Intersection sector_intersection;
+
+    // Along a straight trajectory the crossed sectors are planned once
+    const SectorCrossing* crossing = NULL;
+    double distance_to_stop        = 0;
+    bool straight                  = true;
+
     bool is_in_detector     = false;
-    bool was_in_detector    = false;
     bool propagationstep_till_closest_approach = false;
-    bool already_reached_closest_approach = false;
 
     while (1)
     {
         particle_position  = particle_.GetPosition();
         particle_direction = particle_.GetDirection();
 
-        ChooseCurrentSector(particle_position, particle_direction);
+        detector_intersection = detector_->Intersect(particle_position, particle_direction);
+
+        crossing = FindSectorCrossing(
+            particle_position, particle_direction, detector_intersection, straight, distance_to_stop);
+
+        if (crossing != NULL)
+        {
+            current_sector_ = crossing->sector;
+        } else
+        {
+            ChooseCurrentSector(particle_position, particle_direction, detector_intersection, sector_intersection);
+        }
 
         if (current_sector_ == NULL)
         {
@@ -574,18 +811,48 @@ std::vector<DynamicData*> Propagator::Propagate(double MaxDistance_cm)
             break;
         }
 
+        is_in_detector = detector_intersection.location == Geometry::ParticleLocation::InsideGeometry;
+
+        // The copies continue from here with the flags of this point
+        if (!track.split && splitting_.multiplicity > 1 && is_in_detector &&
+            particle_.GetEnergy() >= splitting_.split_energy)
+        {
+            Split(track);
+        }
+
+        // Russian roulette for particles outside of the detector
+        if (!track.roulette && !track.split && !is_in_detector &&
+            particle_.GetEnergy() < splitting_.roulette_energy)
+        {
+            track.roulette = true;
+
+            if (RandomGenerator::Get().RandomDouble() >= splitting_.roulette_survival)
+            {
+                particle_.SetWeight(0);
+                break;
+            }
+
+            particle_.SetWeight(particle_.GetWeight() / splitting_.roulette_survival);
+        }
+
         // Check if have to propagate the particle_ through the whole sector
         // or only to the sector border
-        distance = CalculateEffectiveDistance(particle_position, particle_direction);
+        if (crossing != NULL)
+        {
+            distance = distance_to_stop;
+        } else
+        {
+            distance = CalculateEffectiveDistance(particle_position, particle_direction, detector_intersection, sector_intersection);
+        }
 
-        if (already_reached_closest_approach == false)
+        if (track.already_reached_closest_approach == false)
         {
-            distance_to_closest_approach = detector_->DistanceToClosestApproach(particle_position, particle_direction);
+            distance_to_closest_approach = detector_intersection.closest_approach;
             if (distance_to_closest_approach > 0)
             {
                 if (distance_to_closest_approach < distance)
                 {
-                    already_reached_closest_approach = true;
+                    track.already_reached_closest_approach = true;
 
                     if (std::abs(distance_to_closest_approach) < GEOMETRY_PRECISION)
                     {
@@ -603,36 +870,35 @@ std::vector<DynamicData*> Propagator::Propagate(double MaxDistance_cm)
         }
 
 
-        is_in_detector = detector_->IsInside(particle_position, particle_direction);
         // entry point of the detector
-        if (!starts_in_detector && !was_in_detector && is_in_detector)
+        if (!track.starts_in_detector && !track.was_in_detector && is_in_detector)
         {
             particle_.SetEntryPoint(particle_position);
             particle_.SetEntryEnergy(particle_.GetEnergy());
             particle_.SetEntryTime(particle_.GetTime());
 
-            was_in_detector = true;
+            track.was_in_detector = true;
         }
         // exit point of the detector
-        else if (was_in_detector && !is_in_detector)
+        else if (track.was_in_detector && !is_in_detector)
         {
             particle_.SetExitPoint(particle_position);
             particle_.SetExitEnergy(particle_.GetEnergy());
             particle_.SetExitTime(particle_.GetTime());
 
             // we don't want to run in this case a second time so we set was_in_detector to false
-            was_in_detector = false;
+            track.was_in_detector = false;
 
         }
         // if particle_ starts inside the detector we only ant to fill the exit point
-        else if (starts_in_detector && !is_in_detector)
+        else if (track.starts_in_detector && !is_in_detector)
         {
             particle_.SetExitPoint(particle_position);
             particle_.SetExitEnergy(particle_.GetEnergy());
             particle_.SetExitTime(particle_.GetTime());
 
             // we don't want to run in this case a second time so we set starts_in_detector to false
-            starts_in_detector = false;
+            track.starts_in_detector = false;
         }
         if (MaxDistance_cm <= particle_.GetPropagatedDistance() + distance)
         {
@@ -641,6 +907,8 @@ std::vector<DynamicData*> Propagator::Propagate(double MaxDistance_cm)
 
         result = current_sector_->Propagate(distance);
 
+        straight = particle_.GetDirection() == particle_direction;
+
         if (propagationstep_till_closest_approach)
         {
             particle_.SetClosestApproachPoint(particle_.GetPosition());
@@ -661,31 +929,114 @@ std::vector<DynamicData*> Propagator::Propagate(double MaxDistance_cm)
     }
 
     particle_.SetElost(particle_.GetEntryEnergy() - particle_.GetExitEnergy());
+}
 
-#if ROOT_SUPPORT
-    Output::getInstance().StorePropagatedPrimaryInTree(&particle_);
-#endif
-    if (Output::store_in_ASCII_file_)
-        Output::getInstance().StorePropagatedPrimaryInASCII(&particle_);
+// ------------------------------------------------------------------------- //
+void Propagator::SetSplitting(const Splitting& splitting)
+{
+    if (splitting.multiplicity < 1)
+    {
+        log_fatal("The multiplicity of the splitting must be at least 1!");
+    }
+    if (splitting.roulette_survival <= 0 || splitting.roulette_survival > 1)
+    {
+        log_fatal("The survival probability of the russian roulette must be in (0, 1]!");
+    }
 
-    return Output::getInstance().GetSecondarys();
+    splitting_ = splitting;
+}
+
+// ------------------------------------------------------------------------- //
+void Propagator::Split(TrackState& track)
+{
+    track.split = true;
+
+    particle_.SetWeight(particle_.GetWeight() / splitting_.multiplicity);
+
+    size_t size = pending_branches_ + splitting_.multiplicity - 1;
+    // The copies are only created once and reused for the next events,
+    // so the particle definition is not copied for every split.
+    while (branches_.size() < size)
+    {
+        branches_.push_back(new Particle(particle_));
+    }
+    branch_states_.resize(branches_.size());
+
+    for (; pending_branches_ < size; ++pending_branches_)
+    {
+        branches_[pending_branches_]->InjectState(particle_);
+        branch_states_[pending_branches_] = track;
+    }
+}
+
+// ------------------------------------------------------------------------- //
+Sector* Propagator::CreateSector(const Sector::Definition& sector_def)
+{
+    const Sector* physics = FindSectorWithSamePhysics(sector_def);
+
+    if (physics != NULL)
+    {
+        return new Sector(particle_, sector_def, *physics);
+    }
+
+    return new Sector(particle_, sector_def);
+}
+
+// ------------------------------------------------------------------------- //
+Sector* Propagator::CreateSector(const Sector::Definition& sector_def, const InterpolationDef& interpolation_def)
+{
+    const Sector* physics = FindSectorWithSamePhysics(sector_def);
+
+    if (physics != NULL)
+    {
+        return new Sector(particle_, sector_def, *physics);
+    }
+
+    return new Sector(particle_, sector_def, interpolation_def);
+}
+
+// ------------------------------------------------------------------------- //
+const Sector* Propagator::FindSectorWithSamePhysics(const Sector::Definition& sector_def) const
+{
+    for (auto sector: sectors_)
+    {
+        if (sector->GetSectorDef().HasSamePhysics(sector_def))
+        {
+            return sector;
+        }
+    }
+
+    return NULL;
 }
 
 // ------------------------------------------------------------------------- //
-void Propagator::ChooseCurrentSector(const Vector3D& particle_position, const Vector3D& particle_direction)
+void Propagator::ChooseCurrentSector(const Vector3D& particle_position,
+                                     const Vector3D& particle_direction,
+                                     const Geometry::Intersection& detector,
+                                     Geometry::Intersection& sector)
 {
     std::vector<int> crossed_sector;
     crossed_sector.resize(0);
+    crossed_intersections_.resize(0);
 
     // Get Location of the detector (Inside/Infront/Behind)
-    Geometry::ParticleLocation::Enum detector_location = detector_->GetLocation(particle_position, particle_direction);
+    Geometry::ParticleLocation::Enum detector_location = detector.location;
+
+    // Only the sectors whose bounding boxes contain the particle can contain
+    // it. They are found in increasing order, like looping over all sectors.
+    const std::vector<unsigned int>& location_sectors = location_sectors_[detector_location];
+    sector_trees_[detector_location].FindContaining(particle_position, sectors_found_);
 
-    for (unsigned int i = 0; i <sectors_.size(); ++i)
+    for (auto found : sectors_found_)
     {
-        if (sectors_[i]->GetGeometry()->IsInside(particle_position, particle_direction))
+        unsigned int i = location_sectors[found];
+
+        Geometry::Intersection intersection = sectors_[i]->GetGeometry()->Intersect(particle_position, particle_direction);
+
+        if (intersection.location == Geometry::ParticleLocation::InsideGeometry)
         {
-            if ( static_cast<int>(sectors_[i]->GetLocation()) == static_cast<int>(detector_location) )
-                crossed_sector.push_back(i);
+            crossed_sector.push_back(i);
+            crossed_intersections_.push_back(intersection);
         }
     }
 
@@ -728,37 +1079,51 @@ void Propagator::ChooseCurrentSector(const Vector3D& particle_position, const Ve
             current_sector_ = sectors_[*iter];
 
     }
+
+    for (size_t i = 0; i < crossed_sector.size(); ++i)
+    {
+        if (sectors_[crossed_sector[i]] == current_sector_)
+        {
+            sector = crossed_intersections_[i];
+            break;
+        }
+    }
 }
 
 // ------------------------------------------------------------------------- //
-double Propagator::CalculateEffectiveDistance(const Vector3D& particle_position, const Vector3D& particle_direction)
+double Propagator::CalculateEffectiveDistance(const Vector3D& particle_position,
+                                              const Vector3D& particle_direction,
+                                              const Geometry::Intersection& detector,
+                                              const Geometry::Intersection& sector)
 {
     double distance_to_sector_border = 0;
     double distance_to_detector = 0;
 
-    distance_to_sector_border =
-        current_sector_->GetGeometry()->DistanceToBorder(particle_position, particle_direction).first;
-    double tmp_distance_to_border;
+    distance_to_sector_border = sector.distance.first;
 
-    Geometry::ParticleLocation::Enum detector_location = detector_->GetLocation(particle_position, particle_direction);
+    Geometry::ParticleLocation::Enum detector_location = detector.location;
+    const Geometry* current_geometry                   = current_sector_->GetGeometry();
 
-    for (std::vector<Sector*>::iterator iter = sectors_.begin(); iter != sectors_.end(); ++iter)
-    {
+    const std::vector<unsigned int>& location_sectors = location_sectors_[detector_location];
+    unsigned int current_hierarchy                    = current_sector_->GetGeometry()->GetHierarchy();
+
+    // The border of a sector can't be closer than its bounding box, so only
+    // the sectors whose boxes are entered before the closest border so far
+    // are visited
+    auto visit = [&](size_t found) {
+        Geometry* geometry = sectors_[location_sectors[found]]->GetGeometry();
 
-        if ( static_cast<int>((*iter)->GetLocation()) == static_cast<int>(detector_location) )
+        if (geometry != current_geometry && geometry->GetHierarchy() >= current_hierarchy)
         {
-            if ((*iter)->GetGeometry()->GetHierarchy() >= current_sector_->GetGeometry()->GetHierarchy())
-            {
-                tmp_distance_to_border =
-                    (*iter)->GetGeometry()->DistanceToBorder(particle_position, particle_direction).first;
-                if (tmp_distance_to_border <= 0)
-                    continue;
+            double tmp_distance_to_border = geometry->DistanceToBorder(particle_position, particle_direction).first;
+            if (tmp_distance_to_border > 0)
                 distance_to_sector_border = std::min(tmp_distance_to_border, distance_to_sector_border);
-            }
         }
-    }
+    };
+
+    sector_trees_[detector_location].Traverse(particle_position, particle_direction, distance_to_sector_border, visit);
 
-    distance_to_detector = detector_->DistanceToBorder(particle_position, particle_direction).first;
+    distance_to_detector = detector.distance.first;
 
     if (distance_to_detector > 0)
     {
@@ -769,10 +1134,283 @@ double Propagator::CalculateEffectiveDistance(const Vector3D& particle_position,
     }
 }
 
+// ------------------------------------------------------------------------- //
+void Propagator::BuildSectorTrees()
+{
+    std::vector<BoundingBox> boxes[3];
+
+    for (int location = 0; location < 3; ++location)
+    {
+        location_sectors_[location].clear();
+    }
+
+    for (unsigned int i = 0; i < sectors_.size(); ++i)
+    {
+        int location = static_cast<int>(sectors_[i]->GetLocation());
+
+        // Particles on the border of a geometry count as inside, if they move
+        // inwards. The boxes are enlarged, so these are not lost by rounding.
+        BoundingBox box = sectors_[i]->GetGeometry()->GetBoundingBox();
+
+        double largest = 0;
+        for (int k = 0; k < 3; ++k)
+        {
+            largest = std::max(largest, std::max(std::abs(box.min[k]), std::abs(box.max[k])));
+        }
+        box.Pad(GEOMETRY_PRECISION + 1e-9 * largest);
+
+        location_sectors_[location].push_back(i);
+        boxes[location].push_back(box);
+    }
+
+    for (int location = 0; location < 3; ++location)
+    {
+        sector_trees_[location] = BoundingVolumeHierarchy(boxes[location]);
+    }
+
+    sector_crossings_.clear();
+    current_crossing_ = 0;
+}
+
+// ------------------------------------------------------------------------- //
+void Propagator::PlanSectorCrossings(const Vector3D& position, const Vector3D& direction)
+{
+    sector_crossings_.clear();
+    crossing_borders_.clear();
+    current_crossing_ = 0;
+
+    crossings_origin_    = position;
+    crossings_direction_ = direction;
+
+    // DistanceToBorder gives the borders of the first part of a hollow
+    // geometry, so it is asked again from the end of every part. The owner
+    // of the border is the index of the sector or -1 for the detector.
+    auto add_borders = [&](Geometry* geometry, int owner) {
+        double distance = 0;
+        Vector3D start  = position;
+
+        while (true)
+        {
+            std::pair<double, double> border = geometry->DistanceToBorder(start, direction);
+
+            if (border.first <= 0)
+                break;
+
+            crossing_borders_.push_back(std::make_pair(distance + border.first, owner));
+
+            if (border.second > 0)
+            {
+                crossing_borders_.push_back(std::make_pair(distance + border.second, owner));
+                distance += border.second;
+            } else
+            {
+                distance += border.first;
+            }
+
+            // The step might be lost by rounding far from the origin
+            Vector3D next = position + distance * direction;
+            if (next == start)
+                break;
+            start = next;
+        }
+    };
+
+    add_borders(detector_, -1);
+
+    for (int location = 0; location < 3; ++location)
+    {
+        const std::vector<unsigned int>& location_sectors = location_sectors_[location];
+        double max_distance = std::numeric_limits<double>::infinity();
+
+        sector_trees_[location].Traverse(position, direction, max_distance, [&](size_t found) {
+            add_borders(sectors_[location_sectors[found]]->GetGeometry(), location_sectors[found]);
+        });
+    }
+
+    std::sort(crossing_borders_.begin(), crossing_borders_.end());
+
+    double entry = 0;
+
+    for (size_t index = 0; index < crossing_borders_.size(); ++index)
+    {
+        const std::pair<double, int>& border = crossing_borders_[index];
+
+        // Borders closer than GEOMETRY_PRECISION are the same
+        if (border.first - entry < GEOMETRY_PRECISION)
+            continue;
+
+        SectorCrossing crossing;
+        crossing.entry  = entry;
+        crossing.exit   = border.first;
+        crossing.sector = NULL;
+
+        // Like ChooseCurrentSector in the center of the interval
+        Vector3D center   = position + 0.5 * (crossing.entry + crossing.exit) * direction;
+        crossing.location = detector_->GetLocation(center, direction);
+
+        const std::vector<unsigned int>& location_sectors = location_sectors_[crossing.location];
+        sector_trees_[crossing.location].FindContaining(center, sectors_found_);
+
+        bool unique = false;
+
+        for (auto found : sectors_found_)
+        {
+            Sector* sector = sectors_[location_sectors[found]];
+
+            if (sector->GetGeometry()->GetLocation(center, direction) != Geometry::ParticleLocation::InsideGeometry)
+                continue;
+
+            if (crossing.sector == NULL ||
+                crossing.sector->GetGeometry()->GetHierarchy() < sector->GetGeometry()->GetHierarchy())
+            {
+                crossing.sector = sector;
+                unique          = true;
+            } else if (crossing.sector->GetGeometry()->GetHierarchy() == sector->GetGeometry()->GetHierarchy())
+            {
+                unique = false;
+            }
+        }
+
+        if (!unique)
+            crossing.sector = NULL;
+
+        // Like CalculateEffectiveDistance the propagation stops at the borders
+        // of the detector and of the sectors, which are not below the current
+        // one
+        crossing.stop = crossing.exit;
+
+        if (crossing.sector != NULL)
+        {
+            unsigned int hierarchy = crossing.sector->GetGeometry()->GetHierarchy();
+
+            // The borders are sorted, the ones before the exit of this
+            // interval have already been passed
+            for (size_t next_index = index; next_index < crossing_borders_.size(); ++next_index)
+            {
+                const std::pair<double, int>& next = crossing_borders_[next_index];
+
+                if (next.first <= entry + GEOMETRY_PRECISION)
+                    continue;
+
+                if (next.second < 0 || (static_cast<int>(sectors_[next.second]->GetLocation()) == crossing.location &&
+                                        sectors_[next.second]->GetGeometry()->GetHierarchy() >= hierarchy))
+                {
+                    crossing.stop = next.first;
+                    break;
+                }
+            }
+        }
+
+        sector_crossings_.push_back(crossing);
+        entry = border.first;
+    }
+}
+
+// ------------------------------------------------------------------------- //
+const Propagator::SectorCrossing* Propagator::FindSectorCrossing(const Vector3D& particle_position,
+                                                                 const Vector3D& particle_direction,
+                                                                 const Geometry::Intersection& detector,
+                                                                 bool plan,
+                                                                 double& distance)
+{
+    // The tolerance grows with the distance to the origin like the padding
+    // of the boxes in BuildSectorTrees
+    double tolerance = GEOMETRY_PRECISION + 1e-9 * particle_position.magnitude();
+
+    Vector3D difference     = particle_position - crossings_origin_;
+    double position_on_line = difference * crossings_direction_;
+
+    bool on_trajectory = !sector_crossings_.empty() && position_on_line >= -tolerance &&
+                         (difference - position_on_line * crossings_direction_).magnitude() <= tolerance &&
+                         (particle_direction - crossings_direction_).magnitude() *
+                                 (sector_crossings_.back().exit - position_on_line) <= tolerance;
+
+    if (!on_trajectory)
+    {
+        if (!plan)
+        {
+            sector_crossings_.clear();
+            return NULL;
+        }
+
+        PlanSectorCrossings(particle_position, particle_direction);
+        position_on_line = 0;
+    }
+
+    // The crossings are walked in order, a copy of a split particle might
+    // start at an earlier one
+    if (current_crossing_ >= sector_crossings_.size() ||
+        position_on_line < sector_crossings_[current_crossing_].entry - tolerance)
+    {
+        current_crossing_ = 0;
+    }
+
+    while (current_crossing_ < sector_crossings_.size() &&
+           sector_crossings_[current_crossing_].exit - position_on_line <= GEOMETRY_PRECISION)
+    {
+        ++current_crossing_;
+    }
+
+    if (current_crossing_ == sector_crossings_.size())
+        return NULL;
+
+    const SectorCrossing& crossing = sector_crossings_[current_crossing_];
+
+    if (crossing.sector == NULL || crossing.location != detector.location)
+        return NULL;
+
+    distance = crossing.stop - position_on_line;
+
+    if (detector.distance.first > 0)
+        distance = std::min(distance, detector.distance.first);
+
+    return &crossing;
+}
+
 // ------------------------------------------------------------------------- //
 // Private member functions
 // ------------------------------------------------------------------------- //
 
+namespace {
+
+// Vertices of a polygon or a mesh given in meter as an array of arrays with
+// the given number of coordinates, missing coordinates are 0
+std::vector<Vector3D> ParseVertices(const nlohmann::json& json_vertices, size_t dimension)
+{
+    double cm_to_meter = 100.0;
+
+    std::vector<Vector3D> vertices;
+
+    if (!json_vertices.is_array())
+    {
+        log_fatal("Invalid input for option 'vertices'. Expected an array of vertices.");
+    }
+
+    for (auto& json_vertex : json_vertices)
+    {
+        if (!json_vertex.is_array() || json_vertex.size() != dimension)
+        {
+            log_fatal("Invalid input for option 'vertices'. Expected %zu coordinates for every vertex.", dimension);
+        }
+
+        double coordinates[3] = {0, 0, 0};
+        for (size_t idx = 0; idx < dimension; ++idx)
+        {
+            if (!json_vertex[idx].is_number())
+            {
+                log_fatal("Invalid input for option 'vertices'. Expected the coordinates to be numbers.");
+            }
+            coordinates[idx] = json_vertex[idx].get<double>() * cm_to_meter;
+        }
+
+        vertices.push_back(Vector3D(coordinates[0], coordinates[1], coordinates[2]));
+    }
+
+    return vertices;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------- //
 Geometry* Propagator::ParseGeometryConifg(const std::string& json_object_str)
 {
@@ -788,6 +1426,8 @@ Geometry* Propagator::ParseGeometryConifg(const std::string& json_object_str)
     std::string length_str       = "length";
     std::string width_str        = "width";
     std::string height_str       = "height";
+    std::string vertices_str     = "vertices";
+    std::string triangles_str    = "triangles";
 
     std::string warning_str = "Geometry %s needs to specify \"%s\" in the config file!";
 
@@ -1044,6 +1684,91 @@ Geometry* Propagator::ParseGeometryConifg(const std::string& json_object_str)
         cylinder->SetZ(z);
 
         return cylinder;
+    } else if (PROPOSAL::ExtrudedPolygon* polygon = dynamic_cast<PROPOSAL::ExtrudedPolygon*>(geometry))
+    {
+        std::vector<Vector3D> vertices;
+        double z = 0;
+
+        if (json_object.find(vertices_str) != json_object.end())
+        {
+            vertices = ParseVertices(json_object[vertices_str], 2);
+        }
+        else
+        {
+            log_fatal(warning_str.c_str(), polygon->GetName().c_str(), vertices_str.c_str());
+        }
+
+        if (json_object.find(height_str) != json_object.end())
+        {
+            if (json_object[height_str].is_number())
+            {
+                z = json_object[height_str].get<double>() * cm_to_meter;
+            }
+            else
+            {
+                log_fatal("Invalid input for option 'height'. Expected a number.");
+            }
+        }
+        else
+        {
+            log_fatal(warning_str.c_str(), polygon->GetName().c_str(), height_str.c_str());
+        }
+
+        polygon->SetPosition(vec);
+        polygon->SetVertices(vertices);
+        polygon->SetHeight(z);
+
+        return polygon;
+    } else if (PROPOSAL::TriangleMesh* mesh = dynamic_cast<PROPOSAL::TriangleMesh*>(geometry))
+    {
+        std::vector<Vector3D> vertices;
+        std::vector<TriangleMesh::Triangle> triangles;
+
+        if (json_object.find(vertices_str) != json_object.end())
+        {
+            vertices = ParseVertices(json_object[vertices_str], 3);
+        }
+        else
+        {
+            log_fatal(warning_str.c_str(), mesh->GetName().c_str(), vertices_str.c_str());
+        }
+
+        if (json_object.find(triangles_str) != json_object.end())
+        {
+            if (!json_object[triangles_str].is_array())
+            {
+                log_fatal("Invalid input for option 'triangles'. Expected an array of triangles.");
+            }
+
+            for (auto& triangle : json_object[triangles_str])
+            {
+                if (!triangle.is_array() || triangle.size() != 3)
+                {
+                    log_fatal("Invalid input for option 'triangles'. Expected three indices of vertices for every triangle.");
+                }
+
+                TriangleMesh::Triangle indices;
+                for (size_t idx = 0; idx < 3; ++idx)
+                {
+                    if (!triangle[idx].is_number_unsigned())
+                    {
+                        log_fatal("Invalid input for option 'triangles'. Expected the indices to be unsigned integers.");
+                    }
+                    indices[idx] = triangle[idx].get<unsigned int>();
+                }
+
+                triangles.push_back(indices);
+            }
+        }
+        else
+        {
+            log_fatal(warning_str.c_str(), mesh->GetName().c_str(), triangles_str.c_str());
+        }
+
+        mesh->SetPosition(vec);
+        mesh->SetMesh(vertices, triangles);
+
+        return mesh;
     } else
     {
         log_fatal("Dynamic casts of Geometries failed. Should not end here!");
@@ -1154,6 +1879,38 @@ InterpolationDef Propagator::CreateInterpolationDef(const std::string& json_obje
         log_debug("The 'just_use_readonly_path' option is not set. Use default (false)");
     }
 
+    if (json_object.find("do_cut_independent_dndx") != json_object.end())
+    {
+        if (json_object["do_cut_independent_dndx"].is_boolean())
+        {
+            interpolation_def.do_cut_independent_dndx = json_object["do_cut_independent_dndx"];
+        }
+        else
+        {
+            log_fatal("Invalid input for option 'do_cut_independent_dndx'. Expected a bool.");
+        }
+    }
+    else
+    {
+        log_debug("The 'do_cut_independent_dndx' option is not set. Use default (false)");
+    }
+
+    if (json_object.find("cut_independent_min_loss") != json_object.end())
+    {
+        if (json_object["cut_independent_min_loss"].is_number())
+        {
+            interpolation_def.cut_independent_min_loss = json_object["cut_independent_min_loss"];
+        }
+        else
+        {
+            log_fatal("Invalid input for option 'cut_independent_min_loss'. Expected a number.");
+        }
+    }
+    else
+    {
+        log_debug("The 'cut_independent_min_loss' option is not set. Use default (0.1 MeV)");
+    }
+
     // Parse to find path to interpolation tables
     if (json_object.find("path_to_tables") != json_object.end())
     {
@@ -1512,6 +2269,29 @@ Sector::Definition Propagator::CreateSectorDefinition(const std::string& json_ob
         log_debug("The 'stochastic_loss_weighting option' is not set. Use default (%f)", sec_def_global.stochastic_loss_weighting);
     }
 
+    if (json_global.find("interaction_bias") != json_global.end())
+    {
+        if (json_global["interaction_bias"].is_object())
+        {
+            for (auto it = json_global["interaction_bias"].begin(); it != json_global["interaction_bias"].end(); ++it)
+            {
+                if (!it.value().is_number() || it.value().get<double>() <= 0)
+                {
+                    log_fatal("Invalid input for the interaction bias of '%s'. Expected a positive number.", it.key().c_str());
+                }
+                sec_def_global.interaction_bias[DynamicData::GetTypeFromName(it.key())] = it.value().get<double>();
+            }
+        }
+        else
+        {
+            log_fatal("Invalid input for option 'interaction_bias'. Expected an object.");
+        }
+    }
+    else
+    {
+        log_debug("The 'interaction_bias' option is not set. The interaction types are not biased.");
+    }
+
 
     if (json_global.find("scattering") != json_global.end())
     {
@@ -1754,7 +2534,8 @@ std::string Propagator::ParseCutSettings(const std::string& json_object_str,
                                          const std::string& json_key,
                                          double default_ecut,
                                          double default_vcut,
-                                         bool default_contrand)
+                                         bool default_contrand,
+                                         bool default_range_propagation)
 {
     nlohmann::json json_object = nlohmann::json::parse(json_object_str);
     nlohmann::json output_object;
@@ -1764,6 +2545,8 @@ std::string Propagator::ParseCutSettings(const std::string& json_object_str,
     output_object[vcut_str] = default_vcut;
     std::string cont_str = "cont_rand";
     output_object[cont_str] = default_contrand;
+    std::string range_str = "range_propagation";
+    output_object[range_str] = default_range_propagation;
 
     if (json_object.find(json_key) != json_object.end())
     {
@@ -1832,6 +2615,25 @@ std::string Propagator::ParseCutSettings(const std::string& json_object_str,
         log_debug("The '%s' option is not set. Use default %s.", cont_str.c_str(), default_contrand ? "true" : "false");
     }
 
+    // get range propagation
+    if (json_object.find(range_str) != json_object.end())
+    {
+        if (json_object[range_str].is_boolean())
+        {
+            output_object[range_str] = json_object[range_str].get<bool>();
+        }
+        else
+        {
+            log_fatal("Invalid input for option '%s'. Expected a bool.", range_str.c_str());
+        }
+    }
+    else
+    {
+        log_debug("The '%s' option is not set. Use default %s.",
+                  range_str.c_str(),
+                  default_range_propagation ? "true" : "false");
+    }
+
     std::string output_object_str = output_object.dump();
     return output_object_str;
 }
@@ -0,0 +1,485 @@
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <sstream>
+
+#include "PROPOSAL/SurvivalTable.h"
+
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/crossection/CrossSection.h"
+#include "PROPOSAL/crossection/parametrization/Parametrization.h"
+#include "PROPOSAL/math/Interpolant.h"
+#include "PROPOSAL/math/InterpolantBuilder.h"
+#include "PROPOSAL/math/RandomGenerator.h"
+#include "PROPOSAL/medium/Medium.h"
+#include "PROPOSAL/particle/Particle.h"
+#include "PROPOSAL/particle/Secondary.h"
+#include "PROPOSAL/propagation_utility/PropagationUtility.h"
+
+#include "PROPOSAL/Logging.h"
+#include "PROPOSAL/methods.h"
+
+using namespace PROPOSAL;
+
+namespace {
+
+// The few large losses make the lowest quantiles of the final energy steep,
+// a linear interpolation between equally spaced quantiles would overestimate
+// the mean energy loss. So the quantile of node i grows with the cube of i.
+double QuantileOfNode(int node, int nodes)
+{
+    return std::pow(static_cast<double>(node) / (nodes - 1), 3);
+}
+
+// ----------------------------------------------------------------------------
+/// @brief Propagates the batch of particles the tables are built from
+///
+/// The 2D interpolants ask for all distances of one energy in increasing
+/// order, so the particles are just propagated further from node to node.
+/// The results of a node are kept for the other tables, which ask for the
+/// same nodes. The sector is only created, if the tables are not read from
+/// a file.
+// ----------------------------------------------------------------------------
+class SurvivalSampler
+{
+public:
+    SurvivalSampler(const ParticleDef& particle_def,
+                    const Sector::Definition& sector_def,
+                    const InterpolationDef& interpolation_def,
+                    const SurvivalTable::Definition& survival_def)
+        : particle_(particle_def)
+        , sector_def_(sector_def)
+        , interpolation_def_(interpolation_def)
+        , survival_def_(survival_def)
+        , sector_()
+        , energies_()
+        , positions_()
+        , directions_()
+        , energy_(-1)
+        , distance_(0)
+        , results_()
+        , rng_state_()
+    {
+    }
+
+    ~SurvivalSampler()
+    {
+        // Continue with the random numbers of the user
+        if (sector_)
+        {
+            RandomGenerator::Get().Deserialize(rng_state_);
+        }
+    }
+
+    // table 0 is the survival probability, table i > 0 the logarithm of the
+    // energy loss of quantile i - 1. The loss is smooth in the energy, for
+    // ionization it hardly depends on it, for radiative losses it is
+    // proportional to it.
+    double Get(double distance, double energy, unsigned int table)
+    {
+        std::pair<double, double> node(distance, energy);
+        std::map<std::pair<double, double>, std::vector<double> >::iterator it = results_.find(node);
+
+        if (it == results_.end())
+        {
+            it = results_.insert(std::make_pair(node, Sample(distance, energy))).first;
+        }
+
+        return it->second.at(table);
+    }
+
+private:
+    std::vector<double> Sample(double distance, double energy)
+    {
+        if (!sector_)
+        {
+            log_info("Propagate %i particles for each of the %i energies of the survival tables.",
+                     survival_def_.statistic,
+                     survival_def_.energy_nodes);
+
+            sector_.reset(new Sector(particle_, sector_def_, interpolation_def_));
+
+            // The tables should not depend on the state of the random generator
+            RandomGenerator::Get().Serialize(rng_state_);
+            RandomGenerator::Get().SetSeed(survival_def_.seed);
+        }
+
+        if (energy != energy_ || distance < distance_)
+        {
+            energies_.assign(survival_def_.statistic, energy);
+            positions_.assign(survival_def_.statistic, Vector3D(0, 0, 0));
+            directions_.assign(survival_def_.statistic, Vector3D(0, 0, -1));
+
+            energy_   = energy;
+            distance_ = 0;
+        }
+
+        // The secondaries are not needed
+        auto discard = MakeSecondaryCallback([](const Secondary&) {});
+
+        std::vector<double> survivors;
+        survivors.reserve(energies_.size());
+
+        for (unsigned int i = 0; i < energies_.size(); ++i)
+        {
+            if (energies_[i] <= 0)
+            {
+                continue;
+            }
+
+            particle_.SetEnergy(energies_[i]);
+            particle_.SetPosition(positions_[i]);
+            particle_.SetDirection(directions_[i]);
+            particle_.SetPropagatedDistance(0);
+
+            if (sector_->Propagate(distance - distance_, discard) <= 0)
+            {
+                energies_[i] = 0;
+                continue;
+            }
+
+            energies_[i]   = particle_.GetEnergy();
+            positions_[i]  = particle_.GetPosition();
+            directions_[i] = particle_.GetDirection();
+
+            survivors.push_back(energies_[i]);
+        }
+
+        distance_ = distance;
+
+        std::vector<double> result(survival_def_.quantile_nodes + 1);
+        result[0] = static_cast<double>(survivors.size()) / energies_.size();
+
+        if (survivors.empty())
+        {
+            std::fill(result.begin() + 1, result.end(), std::log(energy));
+            return result;
+        }
+
+        std::sort(survivors.begin(), survivors.end());
+
+        for (int i = 0; i < survival_def_.quantile_nodes; ++i)
+        {
+            double position = QuantileOfNode(i, survival_def_.quantile_nodes) * (survivors.size() - 1);
+            size_t lower    = static_cast<size_t>(position);
+            size_t upper    = std::min(lower + 1, survivors.size() - 1);
+            double weight   = position - lower;
+
+            double quantile = (1 - weight) * survivors[lower] + weight * survivors[upper];
+            result[i + 1]   = std::log(std::max(energy - quantile, energy * COMPUTER_PRECISION));
+        }
+
+        return result;
+    }
+
+    Particle particle_;
+    Sector::Definition sector_def_;
+    InterpolationDef interpolation_def_;
+    SurvivalTable::Definition survival_def_;
+
+    std::unique_ptr<Sector> sector_;
+
+    std::vector<double> energies_;
+    std::vector<Vector3D> positions_;
+    std::vector<Vector3D> directions_;
+    double energy_;
+    double distance_;
+
+    std::map<std::pair<double, double>, std::vector<double> > results_;
+    std::stringstream rng_state_;
+};
+
+} // namespace
+
+/******************************************************************************
+ *                              Definition                                    *
+ ******************************************************************************/
+
+SurvivalTable::Definition::Definition()
+    : energy_min(1e3)
+    , energy_max(1e9)
+    , distance_min(1e2)
+    , distance_max(1e6)
+    , energy_nodes(20)
+    , distance_nodes(30)
+    , quantile_nodes(21)
+    , statistic(500)
+    , seed(1)
+{
+}
+
+SurvivalTable::Definition::~Definition() {}
+
+bool SurvivalTable::Definition::operator==(const Definition& survival_def) const
+{
+    if (energy_min != survival_def.energy_min)
+        return false;
+    else if (energy_max != survival_def.energy_max)
+        return false;
+    else if (distance_min != survival_def.distance_min)
+        return false;
+    else if (distance_max != survival_def.distance_max)
+        return false;
+    else if (energy_nodes != survival_def.energy_nodes)
+        return false;
+    else if (distance_nodes != survival_def.distance_nodes)
+        return false;
+    else if (quantile_nodes != survival_def.quantile_nodes)
+        return false;
+    else if (statistic != survival_def.statistic)
+        return false;
+    else if (seed != survival_def.seed)
+        return false;
+
+    return true;
+}
+
+bool SurvivalTable::Definition::operator!=(const Definition& survival_def) const
+{
+    return !(*this == survival_def);
+}
+
+size_t SurvivalTable::Definition::GetHash() const
+{
+    size_t hash_digest = 0;
+    hash_combine(hash_digest,
+                 energy_min,
+                 energy_max,
+                 distance_min,
+                 distance_max,
+                 energy_nodes,
+                 distance_nodes,
+                 quantile_nodes,
+                 statistic,
+                 seed);
+
+    return hash_digest;
+}
+
+/******************************************************************************
+ *                            SurvivalTable                                   *
+ ******************************************************************************/
+
+// ------------------------------------------------------------------------- //
+// Constructors & destructor
+// ------------------------------------------------------------------------- //
+
+SurvivalTable::SurvivalTable(const ParticleDef& particle_def,
+                             const Sector::Definition& sector_definition,
+                             const InterpolationDef& interpolation_def,
+                             const Definition& survival_def)
+    : survival_def_(survival_def)
+    , low_(particle_def.low)
+    , survival_(NULL)
+    , quantiles_(survival_def.quantile_nodes, NULL)
+{
+    if (survival_def_.quantile_nodes < 2)
+    {
+        log_fatal("At least two quantiles are needed for the survival tables!");
+    }
+
+    if (survival_def_.statistic <= 0)
+    {
+        log_fatal("The survival tables need a positive number of particles!");
+    }
+
+    // Range propagation samples from these tables itself
+    Sector::Definition sector_def = sector_definition;
+    sector_def.do_range_propagation = false;
+
+    // --------------------------------------------------------------------- //
+    // Hash of the physics the tables are built with
+    // --------------------------------------------------------------------- //
+
+    // Integrals are sufficient to get the parametrizations
+    Utility utility(particle_def, sector_def.GetMedium(), sector_def.GetPropagationCutSettings(), sector_def.utility_def);
+
+    size_t hash_digest = survival_def_.GetHash();
+    for (auto cross_section : utility.GetCrosssections())
+    {
+        const Parametrization& parametrization = cross_section->GetParametrization();
+        hash_combine(hash_digest, parametrization.GetHash(), parametrization.GetMultiplier());
+    }
+
+    hash_combine(hash_digest,
+                 particle_def.low,
+                 particle_def.lifetime,
+                 sector_def.GetMedium().GetMassDensity(),
+                 sector_def.do_continuous_randomization,
+                 sector_def.stopping_decay,
+                 sector_def.do_stochastic_loss_weighting,
+                 sector_def.stochastic_loss_weighting);
+
+    // --------------------------------------------------------------------- //
+    // Builder
+    // --------------------------------------------------------------------- //
+
+    SurvivalSampler sampler(particle_def, sector_def, interpolation_def, survival_def_);
+
+    std::vector<Interpolant2DBuilder> builder(survival_def_.quantile_nodes + 1);
+    Helper::InterpolantBuilderContainer builder_container(builder.size());
+
+    for (unsigned int i = 0; i < builder.size(); ++i)
+    {
+        // The nodes are results of a simulation, so they are just
+        // interpolated linearly to avoid oscillations.
+        builder[i]
+            .SetMax1(survival_def_.distance_nodes)
+            .SetX1Min(survival_def_.distance_min)
+            .SetX1Max(survival_def_.distance_max)
+            .SetMax2(survival_def_.energy_nodes)
+            .SetX2Min(survival_def_.energy_min)
+            .SetX2Max(survival_def_.energy_max)
+            .SetRomberg1(2)
+            .SetRational1(false)
+            .SetRelative1(false)
+            .SetIsLog1(true)
+            .SetRomberg2(2)
+            .SetRational2(false)
+            .SetRelative2(false)
+            .SetIsLog2(true)
+            .SetRombergY(2)
+            .SetRationalY(false)
+            .SetRelativeY(false)
+            .SetLogSubst(false)
+            .SetFunction2D(std::bind(&SurvivalSampler::Get, &sampler, std::placeholders::_1, std::placeholders::_2, i));
+
+        builder_container[i].first = &builder[i];
+    }
+
+    builder_container[0].second = &survival_;
+    for (unsigned int i = 0; i < quantiles_.size(); ++i)
+    {
+        builder_container[i + 1].second = &quantiles_[i];
+    }
+
+    Helper::InitializeInterpolation("survival", builder_container, hash_digest, interpolation_def);
+}
+
+SurvivalTable::SurvivalTable(const SurvivalTable& table)
+    : survival_def_(table.survival_def_)
+    , low_(table.low_)
+    , survival_(new Interpolant(*table.survival_))
+    , quantiles_(table.quantiles_.size(), NULL)
+{
+    for (unsigned int i = 0; i < quantiles_.size(); ++i)
+    {
+        quantiles_[i] = new Interpolant(*table.quantiles_[i]);
+    }
+}
+
+SurvivalTable::~SurvivalTable()
+{
+    delete survival_;
+
+    for (auto quantile : quantiles_)
+    {
+        delete quantile;
+    }
+}
+
+bool SurvivalTable::operator==(const SurvivalTable& table) const
+{
+    if (survival_def_ != table.survival_def_)
+        return false;
+    else if (low_ != table.low_)
+        return false;
+    else if (*survival_ != *table.survival_)
+        return false;
+
+    for (unsigned int i = 0; i < quantiles_.size(); ++i)
+    {
+        if (*quantiles_[i] != *table.quantiles_[i])
+            return false;
+    }
+
+    return true;
+}
+
+bool SurvivalTable::operator!=(const SurvivalTable& table) const
+{
+    return !(*this == table);
+}
+
+// ------------------------------------------------------------------------- //
+// Member functions
+// ------------------------------------------------------------------------- //
+
+double SurvivalTable::GetSurvivalProbability(double energy, double distance)
+{
+    if (distance <= 0)
+    {
+        return 1.;
+    }
+
+    // Linear between the first node and the survival of one at no distance
+    double scale = std::min(distance / survival_def_.distance_min, 1.);
+
+    energy   = Clamp(energy, survival_def_.energy_min, survival_def_.energy_max, "energy");
+    distance = Clamp(distance, survival_def_.distance_min, survival_def_.distance_max, "distance");
+
+    // The interpolation of the simulated nodes can leave the interval slightly
+    double survival = std::min(std::max(survival_->Interpolate(distance, energy), 0.), 1.);
+
+    return 1 - scale * (1 - survival);
+}
+
+// ------------------------------------------------------------------------- //
+double SurvivalTable::GetEnergyQuantile(double energy, double distance, double quantile)
+{
+    if (distance <= 0)
+    {
+        return energy;
+    }
+
+    // Linear between the first node and no energy loss at no distance
+    double scale = std::min(distance / survival_def_.distance_min, 1.);
+
+    double table_energy = Clamp(energy, survival_def_.energy_min, survival_def_.energy_max, "energy");
+    distance            = Clamp(distance, survival_def_.distance_min, survival_def_.distance_max, "distance");
+    quantile            = std::min(std::max(quantile, 0.), 1.);
+
+    double position = std::cbrt(quantile) * (quantiles_.size() - 1);
+    size_t lower    = std::min(static_cast<size_t>(position), quantiles_.size() - 2);
+    double weight   = position - lower;
+
+    double log_loss = (1 - weight) * quantiles_[lower]->Interpolate(distance, table_energy) +
+                      weight * quantiles_[lower + 1]->Interpolate(distance, table_energy);
+
+    // Outside of the tables the relative loss is kept
+    double loss = scale * energy / table_energy * std::exp(log_loss);
+
+    return std::max(energy - loss, low_);
+}
+
+// ------------------------------------------------------------------------- //
+double SurvivalTable::SampleEnergy(double energy, double distance, double rnd)
+{
+    double survival = GetSurvivalProbability(energy, distance);
+
+    if (rnd >= survival)
+    {
+        return 0.;
+    }
+
+    return GetEnergyQuantile(energy, distance, rnd / survival);
+}
+
+// ------------------------------------------------------------------------- //
+double SurvivalTable::Clamp(double value, double min, double max, const char* name) const
+{
+    if (value < min)
+    {
+        log_warn("The %s %f is below the range of the survival tables. Use %f instead.", name, value, min);
+        return min;
+    }
+    else if (value > max)
+    {
+        log_warn("The %s %f is above the range of the survival tables. Use %f instead.", name, value, max);
+        return max;
+    }
+
+    return value;
+}
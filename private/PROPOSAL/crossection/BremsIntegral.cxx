@@ -30,11 +30,14 @@ double BremsIntegral::CalculatedEdxWithoutMultiplier(double energy){
         parametrization_->SetCurrentComponent(i);
         Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
-        sum += dedx_integral_.Integrate(
-            limits.vMin,
-            limits.vUp,
-            std::bind(&Parametrization::FunctionToDEdxIntegral, parametrization_, energy, std::placeholders::_1),
-            2);
+        sum += dedx_integral_.IntegrateBatch(limits.vMin,
+                                             limits.vUp,
+                                             std::bind(&Parametrization::FunctionToDEdxIntegralBatch,
+                                                       parametrization_,
+                                                       energy,
+                                                       std::placeholders::_1,
+                                                       std::placeholders::_2),
+                                             2);
     }
 
     return energy * sum;
@@ -74,11 +74,14 @@ double CrossSectionIntegral::CalculatedE2dxWithoutMultiplier(double energy)
         parametrization_->SetCurrentComponent(i);
         Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
-        sum += de2dx_integral_.Integrate(
-            limits.vMin,
-            limits.vUp,
-            std::bind(&Parametrization::FunctionToDE2dxIntegral, parametrization_, energy, std::placeholders::_1),
-            2);
+        sum += de2dx_integral_.IntegrateBatch(limits.vMin,
+                                              limits.vUp,
+                                              std::bind(&Parametrization::FunctionToDE2dxIntegralBatch,
+                                                        parametrization_,
+                                                        energy,
+                                                        std::placeholders::_1,
+                                                        std::placeholders::_2),
+                                              2);
     }
 
     return energy * energy * sum;
@@ -99,11 +102,14 @@ double CrossSectionIntegral::CalculatedNdx(double energy)
         parametrization_->SetCurrentComponent(i);
         Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
-        prob_for_component_[i] = dndx_integral_[i].Integrate(
-            limits.vUp,
-            limits.vMax,
-            std::bind(&Parametrization::FunctionToDNdxIntegral, parametrization_, energy, std::placeholders::_1),
-            4);
+        prob_for_component_[i] = dndx_integral_[i].IntegrateBatch(limits.vUp,
+                                                                  limits.vMax,
+                                                                  std::bind(&Parametrization::FunctionToDNdxIntegralBatch,
+                                                                            parametrization_,
+                                                                            energy,
+                                                                            std::placeholders::_1,
+                                                                            std::placeholders::_2),
+                                                                  4);
         sum_of_rates_ += prob_for_component_[i];
     }
     return parametrization_->GetMultiplier() * sum_of_rates_;
@@ -157,11 +163,14 @@ double CrossSectionIntegral::CalculateCumulativeCrossSection(double energy, int
     parametrization_->SetCurrentComponent(i);
     Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
-    return dndx_integral_.at(i).Integrate(
-            limits.vUp,
-            v,
-            std::bind(&Parametrization::FunctionToDNdxIntegral, parametrization_, energy, std::placeholders::_1),
-            4);
+    return dndx_integral_.at(i).IntegrateBatch(limits.vUp,
+                                               v,
+                                               std::bind(&Parametrization::FunctionToDNdxIntegralBatch,
+                                                         parametrization_,
+                                                         energy,
+                                                         std::placeholders::_1,
+                                                         std::placeholders::_2),
+                                               4);
 
 }
 
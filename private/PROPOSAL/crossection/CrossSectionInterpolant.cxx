@@ -1,6 +1,8 @@
 
 #include <functional>
 #include <cmath>
+#include <map>
+#include <mutex>
 
 #include "PROPOSAL/crossection/CrossSectionInterpolant.h"
 #include "PROPOSAL/crossection/parametrization/Parametrization.h"
@@ -15,6 +17,46 @@
 
 using namespace PROPOSAL;
 
+namespace {
+
+// The cut independent dNdx tables in use, identified by the hash of the
+// parametrization without cut settings and of the interpolation definition.
+// Only weak references are kept, so the tables are freed together with the
+// last cross section using them. Propagators in different threads share the
+// cache, therefore every access is locked.
+std::map<size_t, std::vector<std::weak_ptr<Interpolant> > >& CutIndependentDNdxCache()
+{
+    static std::map<size_t, std::vector<std::weak_ptr<Interpolant> > > cache;
+    return cache;
+}
+
+std::mutex& CutIndependentDNdxMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+// The tables of all components, if none of them has been freed
+std::vector<std::shared_ptr<Interpolant> > LockCutIndependentDNdx(
+    const std::vector<std::weak_ptr<Interpolant> >& cached)
+{
+    std::vector<std::shared_ptr<Interpolant> > interpolants;
+
+    for (auto interpolant: cached)
+    {
+        std::shared_ptr<Interpolant> locked = interpolant.lock();
+        if (!locked)
+        {
+            return std::vector<std::shared_ptr<Interpolant> >();
+        }
+        interpolants.push_back(locked);
+    }
+
+    return interpolants;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------- //
 // Constructor & Destructor
 // ------------------------------------------------------------------------- //
@@ -25,6 +67,8 @@ CrossSectionInterpolant::CrossSectionInterpolant(const DynamicData::Type& type,
     , de2dx_interpolant_(NULL)
     , dndx_interpolant_1d_(param.GetMedium().GetNumComponents(), NULL)
     , dndx_interpolant_2d_(param.GetMedium().GetNumComponents(), NULL)
+    , cut_independent_min_loss_(0.)
+    , dndx_interpolant_cut_independent_()
 {
 }
 
@@ -41,6 +85,8 @@ bool CrossSectionInterpolant::compare(const CrossSection& cross_section) const
         return false;
     else if (dndx_interpolant_2d_.size() != cross_section_interpolant->dndx_interpolant_2d_.size())
         return false;
+    else if (dndx_interpolant_cut_independent_.size() != cross_section_interpolant->dndx_interpolant_cut_independent_.size())
+        return false;
 
     for (unsigned int i = 0; i < dndx_interpolant_1d_.size(); ++i)
     {
@@ -49,7 +95,18 @@ bool CrossSectionInterpolant::compare(const CrossSection& cross_section) const
     }
     for (unsigned int i = 0; i < dndx_interpolant_2d_.size(); ++i)
     {
-        if (*dndx_interpolant_2d_[i] != *cross_section_interpolant->dndx_interpolant_2d_[i])
+        // Not built, if the cut independent tables are used
+        if (dndx_interpolant_2d_[i] == NULL || cross_section_interpolant->dndx_interpolant_2d_[i] == NULL)
+        {
+            if (dndx_interpolant_2d_[i] != cross_section_interpolant->dndx_interpolant_2d_[i])
+                return false;
+        }
+        else if (*dndx_interpolant_2d_[i] != *cross_section_interpolant->dndx_interpolant_2d_[i])
+            return false;
+    }
+    for (unsigned int i = 0; i < dndx_interpolant_cut_independent_.size(); ++i)
+    {
+        if (*dndx_interpolant_cut_independent_[i] != *cross_section_interpolant->dndx_interpolant_cut_independent_[i])
             return false;
     }
 
@@ -59,6 +116,20 @@ bool CrossSectionInterpolant::compare(const CrossSection& cross_section) const
 // ------------------------------------------------------------------------- //
 void CrossSectionInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
 {
+    if (def.do_cut_independent_dndx)
+    {
+        if (IsCutIndependentDNdxApplicable(def))
+        {
+            InitCutIndependentDNdxInterpolation(def);
+            return;
+        }
+
+        log_warn("The energy cuts of %s are not set or below the minimal energy loss of the cut independent dNdx tables (%f MeV). "
+                 "Build cut dependent tables instead.",
+                 parametrization_->GetName().c_str(),
+                 def.cut_independent_min_loss);
+    }
+
     // --------------------------------------------------------------------- //
     // Builder for dNdx
     // --------------------------------------------------------------------- //
@@ -132,8 +203,166 @@ void CrossSectionInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
     Helper::InitializeInterpolation("dNdx", builder_return, std::vector<Parametrization*>(1, parametrization_), def);
 }
 
+// ------------------------------------------------------------------------- //
+bool CrossSectionInterpolant::IsCutIndependentDNdxApplicable(const InterpolationDef& def) const
+{
+    // The tables are valid for every cut which does not fall below the
+    // lower limit of the tables, i.e. below the minimal energy loss.
+    // Without a finite cut, every loss up to vMax would be read from the
+    // tables, which do not reach below the minimal energy loss.
+    const EnergyCutSettings& cuts = parametrization_->GetEnergyCuts();
+
+    bool ecut_set = cuts.GetEcut() > 0;
+    bool vcut_set = cuts.GetVcut() > 0 && cuts.GetVcut() <= 1;
+
+    if (!ecut_set && !vcut_set)
+    {
+        return false;
+    }
+    if (ecut_set && cuts.GetEcut() < def.cut_independent_min_loss)
+    {
+        return false;
+    }
+    if (vcut_set && cuts.GetVcut() * parametrization_->GetParticleDef().mass < def.cut_independent_min_loss)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+// ------------------------------------------------------------------------- //
+void CrossSectionInterpolant::InitCutIndependentDNdxInterpolation(const InterpolationDef& def)
+{
+    cut_independent_min_loss_ = def.cut_independent_min_loss;
+
+    size_t hash_digest = parametrization_->GetCutIndependentHash();
+    hash_combine(hash_digest, def.cut_independent_min_loss);
+
+    size_t cache_key = hash_digest;
+    hash_combine(cache_key, def.GetHash());
+
+    {
+        std::lock_guard<std::mutex> lock(CutIndependentDNdxMutex());
+
+        auto cached = CutIndependentDNdxCache().find(cache_key);
+        if (cached != CutIndependentDNdxCache().end())
+        {
+            dndx_interpolant_cut_independent_ = LockCutIndependentDNdx(cached->second);
+        }
+        else
+        {
+            dndx_interpolant_cut_independent_.clear();
+        }
+    }
+
+    // The tables are built without holding the lock, another thread may
+    // store the same tables in the meantime.
+    if (dndx_interpolant_cut_independent_.size() != components_.size())
+    {
+        std::vector<Interpolant2DBuilder> builder2d(components_.size());
+        InterpolantVec interpolants(components_.size(), NULL);
+        Helper::InterpolantBuilderContainer builder_container(components_.size());
+
+        Integral integral(IROMB, IMAXS, IPREC);
+
+        for (unsigned int i = 0; i < components_.size(); ++i)
+        {
+            builder2d[i]
+                .SetMax1(def.nodes_cross_section)
+                .SetX1Min(parametrization_->GetParticleDef().mass)
+                .SetX1Max(def.max_node_energy)
+                .SetMax2(def.nodes_cross_section)
+                .SetX2Min(0.0)
+                .SetX2Max(1.0)
+                .SetRomberg1(def.order_of_interpolation)
+                .SetRational1(false)
+                .SetRelative1(false)
+                .SetIsLog1(true)
+                .SetRomberg2(def.order_of_interpolation)
+                .SetRational2(false)
+                .SetRelative2(false)
+                .SetIsLog2(false)
+                .SetRombergY(def.order_of_interpolation)
+                .SetRationalY(true)
+                .SetRelativeY(false)
+                .SetLogSubst(false)
+                .SetFunction2D(std::bind(&CrossSectionInterpolant::FunctionToBuildCutIndependentDNdxInterpolant2D,
+                                         this,
+                                         std::placeholders::_1,
+                                         std::placeholders::_2,
+                                         std::ref(integral),
+                                         i));
+
+            builder_container[i].first  = &builder2d[i];
+            builder_container[i].second = &interpolants[i];
+        }
+
+        Helper::InitializeInterpolation("dNdxCutIndependent", builder_container, hash_digest, def);
+
+        dndx_interpolant_cut_independent_.clear();
+        for (auto interpolant: interpolants)
+        {
+            dndx_interpolant_cut_independent_.push_back(std::shared_ptr<Interpolant>(interpolant));
+        }
+
+        std::lock_guard<std::mutex> lock(CutIndependentDNdxMutex());
+
+        std::map<size_t, std::vector<std::weak_ptr<Interpolant> > >& cache = CutIndependentDNdxCache();
+
+        // Remove the tables no longer in use
+        for (auto it = cache.begin(); it != cache.end();)
+        {
+            if (LockCutIndependentDNdx(it->second).empty())
+                it = cache.erase(it);
+            else
+                ++it;
+        }
+
+        // Tables stored by another thread in the meantime are shared
+        auto cached = cache.find(cache_key);
+        if (cached != cache.end())
+        {
+            dndx_interpolant_cut_independent_ = LockCutIndependentDNdx(cached->second);
+        }
+        else
+        {
+            cache[cache_key] = std::vector<std::weak_ptr<Interpolant> >(
+                dndx_interpolant_cut_independent_.begin(), dndx_interpolant_cut_independent_.end());
+        }
+    }
+
+    // --------------------------------------------------------------------- //
+    // The dNdx for the cut settings of this cross section is derived from
+    // the shared tables. This needs no integration, so the tables are just
+    // kept in memory.
+    // --------------------------------------------------------------------- //
+
+    for (unsigned int i = 0; i < components_.size(); ++i)
+    {
+        Interpolant1DBuilder builder1d;
+
+        builder1d.SetMax(def.nodes_cross_section)
+            .SetXMin(parametrization_->GetParticleDef().mass)
+            .SetXMax(def.max_node_energy)
+            .SetRomberg(def.order_of_interpolation)
+            .SetRational(false)
+            .SetRelative(false)
+            .SetIsLog(true)
+            .SetRombergY(def.order_of_interpolation)
+            .SetRationalY(true)
+            .SetRelativeY(false)
+            .SetLogSubst(false)
+            .SetFunction1D(std::bind(&CrossSectionInterpolant::FunctionToBuildDNdxInterpolant, this, std::placeholders::_1, i));
+
+        dndx_interpolant_1d_[i] = builder1d.build();
+    }
+}
+
 CrossSectionInterpolant::CrossSectionInterpolant(const CrossSectionInterpolant& cross_section)
     : CrossSection(cross_section)
+    , cut_independent_min_loss_(cross_section.cut_independent_min_loss_)
+    , dndx_interpolant_cut_independent_(cross_section.dndx_interpolant_cut_independent_)
 {
     if (cross_section.dedx_interpolant_ != NULL)
     {
@@ -169,6 +398,10 @@ CrossSectionInterpolant::CrossSectionInterpolant(const CrossSectionInterpolant&
         {
             dndx_interpolant_2d_.push_back(new Interpolant(*interpolant));
         }
+        else
+        {
+            dndx_interpolant_2d_.push_back(NULL);
+        }
     }
 }
 
@@ -281,6 +514,20 @@ double CrossSectionInterpolant::CalculateStochasticLoss(double energy, double rn
                 return energy * limits.vUp;
             }
 
+            if (!dndx_interpolant_cut_independent_.empty())
+            {
+                // The tables store the integral from v to vMax, so the
+                // sampled loss is found below the rate at vUp.
+                double v_low = GetCutIndependentLowerLimit(energy, limits);
+                double rate_up = CalculateCutIndependentDNdx(energy, i, limits.vUp);
+                double t = dndx_interpolant_cut_independent_.at(i)->FindLimit(
+                    energy, rate_up - rnd_ * prob_for_component_[i]);
+
+                double v = v_low * std::exp(t * std::log(limits.vMax / v_low));
+
+                return energy * std::min(std::max(v, limits.vUp), limits.vMax);
+            }
+
             return energy *
                    (limits.vUp * std::exp(dndx_interpolant_2d_.at(i)->FindLimit(energy, rnd_ * prob_for_component_[i]) *
                                      std::log(limits.vMax / limits.vUp)));
@@ -312,6 +559,19 @@ double CrossSectionInterpolant::CalculateStochasticLoss(double energy, double rn
 // ------------------------------------------------------------------------- //
 double CrossSectionInterpolant::FunctionToBuildDNdxInterpolant(double energy, int component)
 {
+    if (!dndx_interpolant_cut_independent_.empty())
+    {
+        parametrization_->SetCurrentComponent(component);
+        Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
+
+        if (limits.vUp == limits.vMax)
+        {
+            return 0;
+        }
+
+        return CalculateCutIndependentDNdx(energy, component, limits.vUp);
+    }
+
     return dndx_interpolant_2d_[component]->Interpolate(energy, 1.);
 }
 
@@ -320,6 +580,12 @@ double CrossSectionInterpolant::CalculateCumulativeCrossSection(double energy, i
     parametrization_->SetCurrentComponent(component);
     Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
+    if (!dndx_interpolant_cut_independent_.empty())
+    {
+        return CalculateCutIndependentDNdx(energy, component, limits.vUp) -
+               CalculateCutIndependentDNdx(energy, component, v);
+    }
+
     v = std::log(v / limits.vUp) / std::log(limits.vMax / limits.vUp);
 
     return dndx_interpolant_2d_.at(component)->Interpolate(energy, v);
@@ -341,6 +607,66 @@ double CrossSectionInterpolant::FunctionToBuildDNdxInterpolant2D(double energy,
 
     v = limits.vUp * std::exp(v * std::log(limits.vMax / limits.vUp));
 
-    return integral.Integrate(
-        limits.vUp, v, std::bind(&Parametrization::FunctionToDNdxIntegral, parametrization_, energy, std::placeholders::_1), 4);
+    return integral.IntegrateBatch(limits.vUp,
+                                   v,
+                                   std::bind(&Parametrization::FunctionToDNdxIntegralBatch,
+                                             parametrization_,
+                                             energy,
+                                             std::placeholders::_1,
+                                             std::placeholders::_2),
+                                   4);
+}
+
+//----------------------------------------------------------------------------//
+double CrossSectionInterpolant::FunctionToBuildCutIndependentDNdxInterpolant2D(double energy,
+                                                                               double t,
+                                                                               Integral& integral,
+                                                                               int component)
+{
+    parametrization_->SetCurrentComponent(component);
+    Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
+
+    double v_low = GetCutIndependentLowerLimit(energy, limits);
+
+    if (v_low >= limits.vMax)
+    {
+        return 0;
+    }
+
+    double v = v_low * std::exp(t * std::log(limits.vMax / v_low));
+
+    return integral.IntegrateBatch(v,
+                                   limits.vMax,
+                                   std::bind(&Parametrization::FunctionToDNdxIntegralBatch,
+                                             parametrization_,
+                                             energy,
+                                             std::placeholders::_1,
+                                             std::placeholders::_2),
+                                   4);
+}
+
+//----------------------------------------------------------------------------//
+double CrossSectionInterpolant::GetCutIndependentLowerLimit(double energy,
+                                                            const Parametrization::IntegralLimits& limits) const
+{
+    return std::max(limits.vMin, cut_independent_min_loss_ / energy);
+}
+
+//----------------------------------------------------------------------------//
+double CrossSectionInterpolant::CalculateCutIndependentDNdx(double energy, int component, double v)
+{
+    // Integral of dNdx from v to vMax
+    parametrization_->SetCurrentComponent(component);
+    Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
+
+    double v_low = GetCutIndependentLowerLimit(energy, limits);
+
+    if (v_low >= limits.vMax || v >= limits.vMax)
+    {
+        return 0;
+    }
+
+    double t = std::log(std::max(v, v_low) / v_low) / std::log(limits.vMax / v_low);
+
+    return std::max(dndx_interpolant_cut_independent_.at(component)->Interpolate(energy, t), 0.);
 }
@@ -52,9 +52,9 @@ Parametrization::IntegralLimits Annihilation::GetIntegralLimits(double energy)
     return limits;
 }
 
-size_t Annihilation::GetHash() const
+size_t Annihilation::GetCutIndependentHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetCutIndependentHash();
     hash_combine(seed);
 
     return seed;
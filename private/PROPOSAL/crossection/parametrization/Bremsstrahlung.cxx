@@ -1,11 +1,14 @@
 
 #include <functional>
 #include <cmath>
+#include <map>
+#include <mutex>
 
 #include "PROPOSAL/Constants.h"
 #include "PROPOSAL/crossection/parametrization/Bremsstrahlung.h"
 #include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/math/Interpolant.h"
+#include "PROPOSAL/math/UniformGridInterpolant.h"
 #include "PROPOSAL/medium/Components.h"
 #include "PROPOSAL/medium/Medium.h"
 #include "PROPOSAL/methods.h"
@@ -51,6 +54,7 @@ Bremsstrahlung::Bremsstrahlung(const ParticleDef& particle_def,
     , init_lpm_effect_(true)
     , lpm_(lpm)
     , eLpm_(0)
+    , lpm_constants_()
 {
 }
 
@@ -61,6 +65,7 @@ Bremsstrahlung::Bremsstrahlung(const Bremsstrahlung& brems)
     , init_lpm_effect_(brems.init_lpm_effect_)
     , lpm_(brems.lpm_)
     , eLpm_(brems.eLpm_)
+    , lpm_constants_(brems.lpm_constants_)
 {
 }
 
@@ -111,6 +116,60 @@ double Bremsstrahlung::DifferentialCrossSection(double energy, double v)
     return medium_->GetMolDensity() * components_[component_index_]->GetAtomInMolecule() * aux;
 }
 
+// ------------------------------------------------------------------------- //
+void Bremsstrahlung::DifferentialCrossSectionBatch(double energy,
+                                                   const std::vector<double>& v,
+                                                   std::vector<double>& result)
+{
+    CalculateParametrizationBatch(energy, v, result);
+
+    double prefactor = 2 * particle_def_.charge * particle_def_.charge * (ME / particle_def_.mass) * RE *
+                       components_[component_index_]->GetNucCharge();
+
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        result[i] = prefactor * (prefactor * (ALPHA / v[i]) * result[i]);
+    }
+
+    if (lpm_)
+    {
+        lpm(energy, v, result);
+    }
+
+    double density = medium_->GetMolDensity() * components_[component_index_]->GetAtomInMolecule();
+
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        result[i] = density * result[i];
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void Bremsstrahlung::FunctionToDEdxIntegralBatch(double energy,
+                                                 const std::vector<double>& v,
+                                                 std::vector<double>& result)
+{
+    DifferentialCrossSectionBatch(energy, v, result);
+
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        result[i] = v[i] * result[i];
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void Bremsstrahlung::CalculateParametrizationBatch(double energy,
+                                                   const std::vector<double>& v,
+                                                   std::vector<double>& result)
+{
+    result.resize(v.size());
+
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        result[i] = CalculateParametrization(energy, v[i]);
+    }
+}
+
 // ------------------------------------------------------------------------- //
 Parametrization::IntegralLimits Bremsstrahlung::GetIntegralLimits(double energy)
 {
@@ -141,12 +200,96 @@ Parametrization::IntegralLimits Bremsstrahlung::GetIntegralLimits(double energy)
 }
 
 // ------------------------------------------------------------------------- //
-double Bremsstrahlung::lpm(double energy, double v)
+// LPM suppression
+// ------------------------------------------------------------------------- //
+
+namespace {
+
+const double lpm_fi1 = 1.54954;
+const double lpm_G1  = 0.710390;
+const double lpm_G2  = 0.904912;
+
+// below this value of s, the suppression functions are calculated directly
+const double lpm_s_min = 1e-3;
+
+// Stanev et al.,  Phys. Rev. D 25 (1982), 1291 (eq. 14d)
+double StanevFi(double s)
 {
-    if (init_lpm_effect_)
+    double s2 = s * s;
+    return 1 - std::exp(-6 * s * (1 + (3 - PI) * s) + s2 * s / (0.623 + 0.796 * s + 0.658 * s2));
+}
+
+//  Stanev et al.,  Phys. Rev. D 25 (1982), 1291 (eq. 15d)
+// Klein, Rev. Mod. Phys. 71 (1999), 1501 (eq. 77)
+double StanevG(double s)
+{
+    double s2 = s * s;
+    double ps = 1 - std::exp(-4 * s - 8 * s2 / (1 + 3.936 * s + 4.97 * s2 - 0.05 * s2 * s + 7.50 * s2 * s2));
+    return 3 * ps - 2 * StanevFi(s);
+}
+
+// The suppression functions only depend on s, so they are tabulated once for
+// all media. fi ~ s and G ~ s^2 for small s, the tables store fi/s and G/s^2
+// to keep the relative precision.
+const UniformGridInterpolant1D& StanevFiTable()
+{
+    static const UniformGridInterpolant1D table(
+        [](double s) { return StanevFi(s) / s; }, lpm_s_min, lpm_fi1, 1024);
+    return table;
+}
+
+const UniformGridInterpolant1D& StanevGTable()
+{
+    static const UniformGridInterpolant1D table(
+        [](double s) { return StanevG(s) / (s * s); }, lpm_s_min, lpm_G1, 1024);
+    return table;
+}
+
+// The LPM constants only depend on the parametrization, the particle and the
+// medium, so they are shared between all instances (sectors, cut settings).
+// Propagators in different threads share the cache, therefore every access
+// is locked.
+std::map<size_t, std::weak_ptr<const Bremsstrahlung::LpmConstants> >& LpmConstantsCache()
+{
+    static std::map<size_t, std::weak_ptr<const Bremsstrahlung::LpmConstants> > cache;
+    return cache;
+}
+
+std::mutex& LpmConstantsMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------- //
+void Bremsstrahlung::InitLpmEffect()
+{
+    init_lpm_effect_ = false;
+
+    size_t hash = GetCutIndependentHash();
+    hash_combine(hash, medium_->GetMolDensity());
+
+    std::shared_ptr<const LpmConstants> constants;
+
     {
-        lpm_             = false;
-        init_lpm_effect_ = false;
+        std::lock_guard<std::mutex> lock(LpmConstantsMutex());
+
+        auto cached = LpmConstantsCache().find(hash);
+        if (cached != LpmConstantsCache().end())
+        {
+            constants = cached->second.lock();
+        }
+    }
+
+    // The constants are calculated without holding the lock, another thread
+    // may store the same constants in the meantime.
+    if (!constants)
+    {
+        LpmConstants* new_constants = new LpmConstants();
+
+        lpm_ = false;
 
         double sum = 0;
 
@@ -169,62 +312,125 @@ double Bremsstrahlung::lpm(double energy, double v)
                 limits.vUp, limits.vMax, std::bind(&Bremsstrahlung::FunctionToDEdxIntegral, this, upper_energy, std::placeholders::_1), 4);
         }
 
-        eLpm_ = ALPHA * (particle_def_.mass);
-        eLpm_ *= eLpm_ / (4 * PI * ME * RE * sum);
-
         component_index_ = tmp_index;
         lpm_             = true;
+
+        new_constants->eLpm = ALPHA * (particle_def_.mass);
+        new_constants->eLpm *= new_constants->eLpm / (4 * PI * ME * RE * sum);
+
+        new_constants->gamma_medium = 4 * PI * medium_->GetMolDensity() * medium_->GetSumCharge() * RE;
+
+        for (auto component: components_)
+        {
+            double Z3 = std::pow(component->GetNucCharge(), -1. / 3);
+            double Dn = 1.54 * std::pow(component->GetAtomicNum(), 0.27);
+            double s1 = ME * Dn / (particle_def_.mass * Z3 * component->GetLogConstant());
+            s1 *= s1 * SQRT2;
+
+            new_constants->s1.push_back(s1);
+            new_constants->log_s1.push_back(std::log(s1));
+        }
+
+        constants.reset(new_constants);
+
+        std::lock_guard<std::mutex> lock(LpmConstantsMutex());
+
+        std::map<size_t, std::weak_ptr<const LpmConstants> >& cache = LpmConstantsCache();
+
+        // Remove the constants of media and particles no longer in use
+        for (auto it = cache.begin(); it != cache.end();)
+        {
+            if (it->second.expired())
+                it = cache.erase(it);
+            else
+                ++it;
+        }
+
+        // Constants stored by another thread in the meantime are shared
+        std::shared_ptr<const LpmConstants> stored = cache[hash].lock();
+        if (stored)
+            constants = stored;
+        else
+            cache[hash] = constants;
     }
 
-    double G, fi, xi, ps, Gamma, s1;
+    lpm_constants_ = constants;
+    eLpm_          = constants->eLpm;
+}
 
-    const double fi1 = 1.54954;
-    const double G1  = 0.710390;
-    const double G2  = 0.904912;
+// ------------------------------------------------------------------------- //
+double Bremsstrahlung::lpm(double energy, double v)
+{
+    if (init_lpm_effect_)
+    {
+        InitLpmEffect();
+    }
 
-    double Z3 = std::pow(components_[component_index_]->GetNucCharge(), -1. / 3);
+    return LpmSuppression(
+        energy, v, lpm_constants_->s1[component_index_], lpm_constants_->log_s1[component_index_]);
+}
+
+// ------------------------------------------------------------------------- //
+void Bremsstrahlung::lpm(double energy, const std::vector<double>& v, std::vector<double>& result)
+{
+    if (init_lpm_effect_)
+    {
+        InitLpmEffect();
+    }
 
-    double Dn = 1.54 * std::pow(components_[component_index_]->GetAtomicNum(), 0.27);
-    s1        = ME * Dn / (particle_def_.mass * Z3 * components_[component_index_]->GetLogConstant());
-    s1 *= s1 * SQRT2;
+    double s1     = lpm_constants_->s1[component_index_];
+    double log_s1 = lpm_constants_->log_s1[component_index_];
+
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        result[i] *= LpmSuppression(energy, v[i], s1, log_s1);
+    }
+}
+
+// ------------------------------------------------------------------------- //
+double Bremsstrahlung::LpmSuppression(double energy, double v, double s1, double log_s1) const
+{
+    double G, fi, xi, Gamma;
 
     // Calc xi(s') from Stanev, Vankow, Streitmatter, Ellsworth, Bowen
     // Phys. Rev. D 25 (1982), 1291
     double sp = std::sqrt(eLpm_ * v / (8 * energy * (1 - v)));
-    double h  = std::log(sp) / std::log(s1);
+    double h  = std::log(sp) / log_s1;
 
     if (sp < s1)
     {
         xi = 2;
     } else if (sp < 1)
     {
-        xi = 1 + h - 0.08 * (1 - h) * (1 - (1 - h) * (1 - h)) / std::log(s1);
+        xi = 1 + h - 0.08 * (1 - h) * (1 - (1 - h) * (1 - h)) / log_s1;
     } else
     {
         xi = 1;
     }
 
     Gamma     = RE * ME / (ALPHA * particle_def_.mass * v);
-    Gamma     = 1 + 4 * PI * medium_->GetMolDensity() * medium_->GetSumCharge() * RE * Gamma * Gamma;
+    Gamma     = 1 + lpm_constants_->gamma_medium * Gamma * Gamma;
     double s  = sp / std::sqrt(xi) * Gamma;
     double s2 = s * s;
 
-    if (s < fi1)
+    if (s < lpm_s_min)
+    {
+        fi = StanevFi(s);
+    } else if (s < lpm_fi1)
     {
-        // Stanev et al.,  Phys. Rev. D 25 (1982), 1291 (eq. 14d)
-        fi = 1 - std::exp(-6 * s * (1 + (3 - PI) * s) + s2 * s / (0.623 + 0.796 * s + 0.658 * s2));
+        fi = s * StanevFiTable().Interpolate(s);
     } else
     {
         fi = 1 - 0.012 / (s2 * s2); // Migdal, Phys. Rev. 103 (1956), 1811 (eq. 48)
     }
 
-    if (s < G1)
+    if (s < lpm_s_min)
     {
-        //  Stanev et al.,  Phys. Rev. D 25 (1982), 1291 (eq. 15d)
-        ps = 1 - std::exp(-4 * s - 8 * s2 / (1 + 3.936 * s + 4.97 * s2 - 0.05 * s2 * s + 7.50 * s2 * s2));
-        // Klein, Rev. Mod. Phys. 71 (1999), 1501 (eq. 77)
-        G = 3 * ps - 2 * fi;
-    } else if (s < G2)
+        G = StanevG(s);
+    } else if (s < lpm_G1)
+    {
+        G = s2 * StanevGTable().Interpolate(s);
+    } else if (s < lpm_G2)
     {
         G = 36 * s2 / (36 * s2 + 1);
     } else
@@ -240,9 +446,9 @@ double Bremsstrahlung::lpm(double energy, double v)
 // Getter
 // ------------------------------------------------------------------------- //
 
-size_t Bremsstrahlung::GetHash() const
+size_t Bremsstrahlung::GetCutIndependentHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetCutIndependentHash();
     hash_combine(seed, lpm_, lorenz_);
 
     return seed;
@@ -273,92 +479,142 @@ BREMSSTRAHLUNG_IMPL(AndreevBezrukovBugaev)
 BREMSSTRAHLUNG_IMPL(SandrockSoedingreksoRhode)
 
 // ------------------------------------------------------------------------- //
-// PetrukhinShestakov parametrization
-// Canad. J. Phys. 46 (1968), 377
+// Kernels of the specific parametrizations
 // ------------------------------------------------------------------------- //
 
-double BremsPetrukhinShestakov::CalculateParametrization(double energy, double v)
+// The terms, which do not depend on v, are computed once by the constructor
+// of a kernel and the remaining terms by its call operator. The single point
+// and the batch methods both evaluate the parametrizations with these kernels.
+
+namespace {
+
+template <class Kernel>
+void EvaluateKernel(const Kernel& kernel, const std::vector<double>& v, std::vector<double>& result)
 {
-    double result = 0;
-    double Fd     = 0;
+    result.resize(v.size());
 
-    double Z3 = std::pow(components_[component_index_]->GetNucCharge(), -1. / 3);
-    // least momentum transferred to the nucleus (eq. 2)
-    double delta = particle_def_.mass * particle_def_.mass * v / (2 * energy * (1 - v));
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        result[i] = kernel(v[i]);
+    }
+}
 
-    // influence of atomic form factor
-    // for nuclear charge smaller 10, the nucleus is reated pointlike
-    // eq. 10
-    Fd = 189 * Z3 / ME;
-    Fd = (particle_def_.mass) * Fd / (1 + SQRTE * delta * Fd);
-    // 189 is the radiation logarithm
+// ------------------------------------------------------------------------- //
+// PetrukhinShestakov parametrization
+// Canad. J. Phys. 46 (1968), 377
+// ------------------------------------------------------------------------- //
 
-    // for nuclear charge greater 10, a correction for the nuclear form factor
-    // is taken into account (eq.11)
-    if (components_[component_index_]->GetNucCharge() > 10)
+struct PetrukhinShestakovKernel
+{
+    PetrukhinShestakovKernel(const Components::Component& component, double mass, double energy)
+        : energy_(energy)
+        , mass_sq_(mass * mass)
+        , Z3_(std::pow(component.GetNucCharge(), -1. / 3))
+        , Fd_const_(189 * Z3_ / ME) // 189 is the radiation logarithm
+        , mass_Fd_(mass * Fd_const_)
+        , nuclear_ff_(component.GetNucCharge() > 10)
     {
-        Fd *= (2. / 3) * Z3;
     }
 
-    // eq. 3
-    result = ((4. / 3) * (1 - v) + v * v) * std::log(Fd);
+    double operator()(double v) const
+    {
+        // least momentum transferred to the nucleus (eq. 2)
+        double delta = mass_sq_ * v / (2 * energy_ * (1 - v));
 
-    return result;
-}
+        // influence of atomic form factor
+        // for nuclear charge smaller 10, the nucleus is reated pointlike
+        // eq. 10
+        double Fd = mass_Fd_ / (1 + SQRTE * delta * Fd_const_);
+
+        // for nuclear charge greater 10, a correction for the nuclear form factor
+        // is taken into account (eq.11)
+        if (nuclear_ff_)
+        {
+            Fd *= (2. / 3) * Z3_;
+        }
+
+        // eq. 3
+        return ((4. / 3) * (1 - v) + v * v) * std::log(Fd);
+    }
+
+    double energy_;
+    double mass_sq_;
+    double Z3_;
+    double Fd_const_;
+    double mass_Fd_;
+    bool nuclear_ff_;
+};
 
 // ------------------------------------------------------------------------- //
 // BremsKelnerKokoulinPetrukhin parametrization
 // Moscow:Preprint/MEPhI 024-95 (1995)
 // ------------------------------------------------------------------------- //
 
-double BremsKelnerKokoulinPetrukhin::CalculateParametrization(double energy, double v)
+struct KelnerKokoulinPetrukhinKernel
 {
-    double formfactor_atomic_inelastic  = 0.;
-    double formfactor_nuclear_inelastic = 0.;
-    double result                       = 0.;
+    KelnerKokoulinPetrukhinKernel(const Components::Component& component, double mass, double energy)
+        : energy_(energy)
+        , mass_(mass)
+        , mass_sq_(mass * mass)
+        , nucl_Z_(component.GetNucCharge())
+        , log_const_(component.GetLogConstant())
+        , b_prime_(component.GetBPrime())
+        , Z3_(std::pow(nucl_Z_, -1. / 3))
+        , Dn_(1.54 * std::pow(component.GetAtomicNum(), 0.27))
+        , maxV_(0)
+    {
+        // TODO(mario): Better way? Sat 2017/09/02
+        double square_momentum   = (energy - mass) * (energy + mass);
+        double particle_momentum = std::sqrt(std::max(square_momentum, 0.0));
+        maxV_                    = ME * (energy - mass) / (energy * (energy - particle_momentum + ME));
+    }
 
-    // least momentum transferred to the nucleus (eq. 7)
-    double delta = particle_def_.mass * particle_def_.mass * v / (2 * energy * (1 - v));
+    double operator()(double v) const
+    {
+        double formfactor_atomic_inelastic  = 0.;
+        double formfactor_nuclear_inelastic = 0.;
 
-    double Z3 = std::pow(components_[component_index_]->GetNucCharge(), -1. / 3);
-    double Dn = 1.54 * std::pow(components_[component_index_]->GetAtomicNum(), 0.27);
-    // elastic atomic form factor (eq. 14)
-    double formfactor_atomic_elastic =
-        std::log(1 + ME / (delta * SQRTE * components_[component_index_]->GetLogConstant() * Z3));
-    // elastic nuclear form factor (eq. 18)
-    double formfactor_nuclear_elastic = std::log(Dn / (1 + delta * (Dn * SQRTE - 2) / particle_def_.mass));
+        // least momentum transferred to the nucleus (eq. 7)
+        double delta = mass_sq_ * v / (2 * energy_ * (1 - v));
 
-    // TODO(mario): Better way? Sat 2017/09/02
-    double square_momentum   = (energy - particle_def_.mass) * (energy + particle_def_.mass);
-    double particle_momentum = std::sqrt(std::max(square_momentum, 0.0));
-    double maxV              = ME * (energy - particle_def_.mass) / (energy * (energy - particle_momentum + ME));
+        // elastic atomic form factor (eq. 14)
+        double formfactor_atomic_elastic = std::log(1 + ME / (delta * SQRTE * log_const_ * Z3_));
+        // elastic nuclear form factor (eq. 18)
+        double formfactor_nuclear_elastic = std::log(Dn_ / (1 + delta * (Dn_ * SQRTE - 2) / mass_));
 
-    if (v < maxV)
-    {
-        // inelastic atomic contribution (eq. 26)
-        formfactor_atomic_inelastic =
-            std::log(particle_def_.mass / (delta * (delta * particle_def_.mass / (ME * ME) + SQRTE))) -
-            std::log(1 + ME / (delta * SQRTE * components_[component_index_]->GetBPrime() * Z3 * Z3));
-    }
+        if (v < maxV_)
+        {
+            // inelastic atomic contribution (eq. 26)
+            formfactor_atomic_inelastic = std::log(mass_ / (delta * (delta * mass_ / (ME * ME) + SQRTE))) -
+                                          std::log(1 + ME / (delta * SQRTE * b_prime_ * Z3_ * Z3_));
+        }
 
-    if (components_[component_index_]->GetNucCharge() != 1)
-    {
-        // inelastic nuclear contribution (eq. 28)
-        formfactor_nuclear_inelastic = formfactor_nuclear_elastic;
-        // the inelastic nuclear form factor describes the scattering at single nucleons in a nucleus
-        // for Hydrogen this doesn't make sense
-        // or more explicit: the min required energy to excite a proton is much higher
-        // than to excite a nucleus with more then just one nucleon
-    }
+        if (nucl_Z_ != 1)
+        {
+            // inelastic nuclear contribution (eq. 28)
+            formfactor_nuclear_inelastic = formfactor_nuclear_elastic;
+            // the inelastic nuclear form factor describes the scattering at single nucleons in a nucleus
+            // for Hydrogen this doesn't make sense
+            // or more explicit: the min required energy to excite a proton is much higher
+            // than to excite a nucleus with more then just one nucleon
+        }
 
-    // eq. 2
-    result = ((4. / 3) * (1 - v) + v * v) * (std::log(particle_def_.mass / delta) - 0.5 // eq.3
-                                             - formfactor_atomic_elastic - formfactor_nuclear_elastic +
-                                             (formfactor_nuclear_inelastic + formfactor_atomic_inelastic) /
-                                                 components_[component_index_]->GetNucCharge());
+        // eq. 2
+        return ((4. / 3) * (1 - v) + v * v) * (std::log(mass_ / delta) - 0.5 // eq.3
+                                               - formfactor_atomic_elastic - formfactor_nuclear_elastic +
+                                               (formfactor_nuclear_inelastic + formfactor_atomic_inelastic) / nucl_Z_);
+    }
 
-    return result;
-}
+    double energy_;
+    double mass_;
+    double mass_sq_;
+    double nucl_Z_;
+    double log_const_;
+    double b_prime_;
+    double Z3_;
+    double Dn_;
+    double maxV_;
+};
 
 // ------------------------------------------------------------------------- //
 // CompleteScreening parametrization (by Tsai)
@@ -366,210 +622,341 @@ double BremsKelnerKokoulinPetrukhin::CalculateParametrization(double energy, dou
 // eq. 3.83
 // ------------------------------------------------------------------------- //
 
-double BremsCompleteScreening::CalculateParametrization(double energy, double v)
+struct CompleteScreeningKernel
 {
-    (void)energy;
+    CompleteScreeningKernel(const Components::Component& component)
+        : nucl_Z_(component.GetNucCharge())
+        , screening_(0)
+    {
+        double Lr, fZ, Lp;
 
-    double aux    = 0;
-    double result = 0;
-    double Lr, fZ, Lp;
+        double Z3 = std::pow(nucl_Z_, -1. / 3);
 
-    double Z3 = std::pow(components_[component_index_]->GetNucCharge(), -1. / 3);
+        double aux = ALPHA * nucl_Z_;
+        aux *= aux;
+        fZ = aux * (1 / (1 + aux) + 0.20206 + aux * (-0.0369 + aux * (0.0083 - 0.002 * aux)));
 
-    aux = ALPHA * components_[component_index_]->GetNucCharge();
-    aux *= aux;
-    fZ = aux * (1 / (1 + aux) + 0.20206 + aux * (-0.0369 + aux * (0.0083 - 0.002 * aux)));
-
-    // check rounding
-    switch ((int)(components_[component_index_]->GetNucCharge() + 0.5))
-    {
-        case 1:
+        // check rounding
+        switch ((int)(nucl_Z_ + 0.5))
         {
-            Lr = 5.31;
-            Lp = 6.144;
-            break;
-        }
-        case 2:
-        {
-            Lr = 4.79;
-            Lp = 5.621;
-            break;
+            case 1:
+            {
+                Lr = 5.31;
+                Lp = 6.144;
+                break;
+            }
+            case 2:
+            {
+                Lr = 4.79;
+                Lp = 5.621;
+                break;
+            }
+
+            case 3:
+            {
+                Lr = 4.74;
+                Lp = 5.805;
+                break;
+            }
+
+            case 4:
+            {
+                Lr = 4.71;
+                Lp = 5.924;
+                break;
+            }
+
+            default:
+            {
+                Lr = std::log(184.15 * Z3);
+                Lp = std::log(1194 * Z3 * Z3);
+                break;
+            }
         }
 
-        case 3:
-        {
-            Lr = 4.74;
-            Lp = 5.805;
-            break;
-        }
+        screening_ = nucl_Z_ * (Lr - fZ) + Lp;
+    }
 
-        case 4:
+    double operator()(double v) const
+    {
+        return ((4. / 3 * (1 - v) + v * v) * screening_ + 1. / 9 * (1 - v) * (nucl_Z_ + 1)) / nucl_Z_;
+    }
+
+    double nucl_Z_;
+    double screening_;
+};
+
+// ------------------------------------------------------------------------- //
+// AndreevBezrukovBugaev parametrization
+// Phys. Atom. Nucl. 57 (1994), 2066
+// ------------------------------------------------------------------------- //
+
+struct AndreevBezrukovBugaevKernel
+{
+    AndreevBezrukovBugaevKernel(const Components::Component& component, double mass, double energy)
+        : energy_(energy)
+        , mass_sq_(mass * mass)
+        , nucl_Z_(component.GetNucCharge())
+        , a1_(0)
+        , a2_(0)
+        , mass_a1_(0)
+        , mass_a2_(0)
+        , d1_(0)
+        , d2_(0)
+    {
+        double Z3 = std::pow(nucl_Z_, -1. / 3);
+
+        a1_ = 184.15 * Z3 / (SQRTE * ME);    // eq 2.18
+        a2_ = 1194 * Z3 * Z3 / (SQRTE * ME); // eq.2.19
+
+        mass_a1_ = mass * a1_;
+        mass_a2_ = mass * a2_;
+
+        // calculating the contribution of elastic nuclear and atomic form factors
+        // eq. 2.30
+        double qc   = 1.9 * MMU * Z3;
+        double aux  = 2 * mass / qc;
+        double zeta = std::sqrt(1 + aux * aux);
+
+        if (nucl_Z_ != 1)
         {
-            Lr = 4.71;
-            Lp = 5.924;
-            break;
+            double aux1 = std::log(mass / qc);
+            double aux2 = 0.5 * zeta * std::log((zeta + 1) / (zeta - 1));
+            d1_         = aux1 + aux2;
+            d2_         = aux1 + 0.5 * ((3 - zeta * zeta) * aux2 + aux * aux);
         }
+    }
 
-        default:
+    double operator()(double v) const
+    {
+        // least momentum transferred to the nucleus (eq. 2.2)
+        double delta = mass_sq_ * v / (2 * energy_ * (1 - v));
+        double x1    = a1_ * delta;
+        double x2    = a2_ * delta;
+
+        // eq. 2.20 and 2.21
+        double aux1 = std::log(mass_a1_ * mass_a1_ / (1 + x1 * x1));
+        double aux2 = std::log(mass_a2_ * mass_a2_ / (1 + x2 * x2));
+        double psi1 = 0.5 * ((1 + aux1) + (1 + aux2) / nucl_Z_);
+        double psi2 = 0.5 * ((2. / 3 + aux1) + (2. / 3 + aux2) / nucl_Z_);
+
+        aux1 = x1 * std::atan(1 / x1);
+        aux2 = x2 * std::atan(1 / x2);
+        psi1 -= aux1 + aux2 / nucl_Z_;
+        double aux = x1 * x1;
+        psi2 += 2 * aux * (1 - aux1 + 0.75 * std::log(aux / (1 + aux)));
+        aux = x2 * x2;
+        psi2 += 2 * aux * (1 - aux2 + 0.75 * std::log(aux / (1 + aux))) / nucl_Z_;
+
+        psi1 -= d1_;
+        psi2 -= d2_;
+
+        double result = (2 - 2 * v + v * v) * psi1 - (2. / 3) * (1 - v) * psi2;
+
+        if (result < 0)
         {
-            Lr = std::log(184.15 * Z3);
-            Lp = std::log(1194 * Z3 * Z3);
-            break;
+            result = 0;
         }
+
+        return result;
     }
 
-    result = ((4. / 3 * (1 - v) + v * v) * (components_[component_index_]->GetNucCharge() * (Lr - fZ) + Lp) +
-              1. / 9 * (1 - v) * (components_[component_index_]->GetNucCharge() + 1)) /
-             components_[component_index_]->GetNucCharge();
-
-    return result;
-}
+    double energy_;
+    double mass_sq_;
+    double nucl_Z_;
+    double a1_;
+    double a2_;
+    double mass_a1_;
+    double mass_a2_;
+    double d1_;
+    double d2_;
+};
 
 // ------------------------------------------------------------------------- //
-// AndreevBezrukovBugaev parametrization
-// Phys. Atom. Nucl. 57 (1994), 2066
+// SandrockSoedingreksoRhode parametrization
 // ------------------------------------------------------------------------- //
 
-double BremsAndreevBezrukovBugaev::CalculateParametrization(double energy, double v)
+struct SandrockSoedingreksoRhodeKernel
 {
-    double aux    = 0;
-    double result = 0;
+    SandrockSoedingreksoRhodeKernel(const Components::Component& component, double mass, double energy)
+        : energy_(energy)
+        , mass_(mass)
+        , Z_(component.GetNucCharge())
+        , Z13_(std::pow(Z_, -1. / 3))
+        , rad_log_inel_(component.GetBPrime())
+        , delta1_(0)
+        , delta2_(0)
+        , phi1_num_(0)
+        , phi2_num_(0)
+        , phi1_den_(0)
+        , phi2_den_(0)
+        , maxV_(0)
+    {
+        double rad_log = component.GetLogConstant();
+        double Dn      = 1.54 * std::pow(component.GetAtomicNum(), 0.27);
 
-    // least momentum transferred to the nucleus (eq. 2.2)
+        double mu_qc   = mass / (MMU * std::exp(1.) / Dn);
+        double rho     = std::sqrt(1.0 + 4.0 * mu_qc * mu_qc);
+        double log_rho = std::log((rho + 1.) / (rho - 1.));
 
-    double nucl_Z = components_[component_index_]->GetNucCharge();
+        delta1_ = std::log(mu_qc) + 0.5 * rho * log_rho;
+        delta2_ = std::log(mu_qc) + 0.25 * (3.0 * rho - rho * rho * rho) * log_rho + 2.0 * mu_qc * mu_qc;
 
-    double Z3 = std::pow(nucl_Z, -1. / 3);
+        phi1_num_ = rad_log * Z13_ * (mass / ME);
+        phi2_num_ = rad_log * Z13_ * exp(-1 / 6.) * (mass / ME);
+        phi1_den_ = rad_log * Z13_ * exp(0.5);
+        phi2_den_ = rad_log * Z13_ * exp(1. / 3.);
 
-    double a1 = 184.15 * Z3 / (SQRTE * ME);    // eq 2.18
-    double a2 = 1194 * Z3 * Z3 / (SQRTE * ME); // eq.2.19
+        // s_atomic
+        double square_momentum   = (energy - mass) * (energy + mass);
+        double particle_momentum = std::sqrt(std::max(square_momentum, 0.0));
+        maxV_                    = ME * (energy - mass) / (energy * (energy - particle_momentum + ME));
+    }
 
-    // calculating the contribution of elastic nuclear and atomic form factors
-    // eq. 2.30
-    double qc   = 1.9 * MMU * Z3;
-    aux         = 2 * particle_def_.mass / qc;
-    double zeta = std::sqrt(1 + aux * aux);
+    double operator()(double v) const
+    {
+        static const double a[3] = {-0.00349, 148.84, -987.531};
+        static const double b[4] = {0.1642, 132.573, -585.361, 1407.77};
+        static const double c[6] = {-2.8922, -19.0156, 57.698, -63.418, 14.1166, 1.84206};
+        static const double d[6] = {2134.19, 581.823, -2708.85, 4767.05, 1.52918, 0.361933};
 
-    double delta = particle_def_.mass * particle_def_.mass * v / (2 * energy * (1 - v));
-    double x1    = a1 * delta;
-    double x2    = a2 * delta;
+        // least momentum transferred to the nucleus (eq. 7)
+        double delta = mass_ * mass_ * v / (2.0 * energy_ * (1.0 - v));
 
-    double aux1, aux2, d1, d2, psi1, psi2;
+        double phi1 = std::log(phi1_num_ / (1.0 + phi1_den_ * delta / ME));
+        double phi2 = std::log(phi2_num_ / (1.0 + phi2_den_ * delta / ME));
+        phi1 -= delta1_ * (1. - 1. / Z_);
+        phi2 -= delta2_ * (1. - 1. / Z_);
 
-    if (nucl_Z == 1)
-    {
-        d1 = 0;
-        d2 = 0;
-    } else
-    {
-        aux1 = std::log(particle_def_.mass / qc);
-        aux2 = 0.5 * zeta * std::log((zeta + 1) / (zeta - 1));
-        d1   = aux1 + aux2;
-        d2   = aux1 + 0.5 * ((3 - zeta * zeta) * aux2 + aux * aux);
-    }
+        double s_atomic = 0.0;
 
-    // eq. 2.20 and 2.21
-    aux  = particle_def_.mass * a1;
-    aux1 = std::log(aux * aux / (1 + x1 * x1));
-    aux  = particle_def_.mass * a2;
-    aux2 = std::log(aux * aux / (1 + x2 * x2));
-    psi1 = 0.5 * ((1 + aux1) + (1 + aux2) / nucl_Z);
-    psi2 = 0.5 * ((2. / 3 + aux1) + (2. / 3 + aux2) / nucl_Z);
+        if (v < maxV_)
+        {
+            double s_atomic_1 = std::log(mass_ / delta / (mass_ * delta / (ME * ME) + SQRTE));
+            double s_atomic_2 = std::log(1. + ME / (delta * rad_log_inel_ * Z13_ * Z13_ * SQRTE));
+            s_atomic          = (4. / 3. * (1. - v) + v * v) * (s_atomic_1 - s_atomic_2);
+        }
 
-    aux1 = x1 * std::atan(1 / x1);
-    aux2 = x2 * std::atan(1 / x2);
-    psi1 -= aux1 + aux2 / nucl_Z;
-    aux = x1 * x1;
-    psi2 += 2 * aux * (1 - aux1 + 0.75 * std::log(aux / (1 + aux)));
-    aux = x2 * x2;
-    psi2 += 2 * aux * (1 - aux2 + 0.75 * std::log(aux / (1 + aux))) / nucl_Z;
+        // s_rad
+        double s_rad;
 
-    psi1 -= d1;
-    psi2 -= d2;
-    result = (2 - 2 * v + v * v) * psi1 - (2. / 3) * (1 - v) * psi2;
+        if (v < .0 || v > 1.0)
+        {
+            s_rad = 0.;
+        } else if (v < 0.02)
+        {
+            s_rad = a[0] + a[1] * v + a[2] * v * v;
+        } else if (v < 0.1)
+        {
+            s_rad = b[0] + b[1] * v + b[2] * v * v + b[3] * v * v * v;
+        } else if (v < 0.9)
+        {
+            s_rad = c[0] + c[1] * v + c[2] * v * v;
 
-    if (result < 0)
-    {
-        result = 0;
-    }
+            double tmp = std::log(1. - v);
+            s_rad += c[3] * v * std::log(v) + c[4] * tmp + c[5] * tmp * tmp;
+        } else
+        {
+            s_rad = d[0] + d[1] * v + d[2] * v * v;
 
-    return result;
-}
+            double tmp = std::log(1. - v);
+            s_rad += d[3] * v * std::log(v) + d[4] * tmp + d[5] * tmp * tmp;
+        }
 
-double BremsSandrockSoedingreksoRhode::CalculateParametrization(double energy, double v)
-{
-    static const double a[3] = {-0.00349, 148.84, -987.531};
-    static const double b[4] = {0.1642, 132.573, -585.361, 1407.77};
-    static const double c[6] = {-2.8922, -19.0156, 57.698, -63.418, 14.1166, 1.84206};
-    static const double d[6] = {2134.19, 581.823, -2708.85, 4767.05, 1.52918, 0.361933};
+        return std::max(
+            ((2.0 - 2.0 * v + v * v) * phi1 - 2.0 / 3.0 * (1. - v) * phi2) + 1. / Z_ * s_atomic + 0.25 * ALPHA * phi1 * s_rad,
+            0.);
+    }
 
+    double energy_;
+    double mass_;
+    double Z_;
+    double Z13_;
+    double rad_log_inel_;
+    double delta1_;
+    double delta2_;
+    double phi1_num_;
+    double phi2_num_;
+    double phi1_den_;
+    double phi2_den_;
+    double maxV_;
+};
+
+} // namespace
 
-    double Z = components_[component_index_]->GetNucCharge();
-    double Z13 = std::pow(Z, -1. / 3);
-    double rad_log = components_[component_index_]->GetLogConstant();
-    double rad_log_inel = components_[component_index_]->GetBPrime();
-    double Dn = 1.54 * std::pow(components_[component_index_]->GetAtomicNum(), 0.27);
+// ------------------------------------------------------------------------- //
+// Evaluation of the specific parametrizations
+// ------------------------------------------------------------------------- //
 
-    double mu_qc = particle_def_.mass / (MMU * std::exp(1.) / Dn);
-    double rho = std::sqrt(1.0 + 4.0*mu_qc*mu_qc);
+double BremsPetrukhinShestakov::CalculateParametrization(double energy, double v)
+{
+    return PetrukhinShestakovKernel(*components_[component_index_], particle_def_.mass, energy)(v);
+}
 
-    double log_rho = std::log((rho + 1.) / (rho - 1.));
-    double delta1 = std::log(mu_qc) + 0.5 * rho * log_rho;
-    double delta2 = std::log(mu_qc) + 0.25 * (3.0*rho - rho*rho*rho) * log_rho + 2.0*mu_qc*mu_qc;
+void BremsPetrukhinShestakov::CalculateParametrizationBatch(double energy,
+                                                            const std::vector<double>& v,
+                                                            std::vector<double>& result)
+{
+    EvaluateKernel(PetrukhinShestakovKernel(*components_[component_index_], particle_def_.mass, energy), v, result);
+}
 
-    // least momentum transferred to the nucleus (eq. 7)
-    double delta = particle_def_.mass * particle_def_.mass * v / (2.0 * energy * (1.0 - v));
+// ------------------------------------------------------------------------- //
+double BremsKelnerKokoulinPetrukhin::CalculateParametrization(double energy, double v)
+{
+    return KelnerKokoulinPetrukhinKernel(*components_[component_index_], particle_def_.mass, energy)(v);
+}
 
-    double phi1 = std::log(rad_log * Z13 * (particle_def_.mass / ME) / (1.0 + rad_log * Z13 * exp(0.5) * delta / ME));
-    double phi2 = std::log(rad_log * Z13 * exp(-1/6.) * (particle_def_.mass / ME) / (1.0 + rad_log * Z13 * exp(1./3.) * delta / ME));
-    phi1 -= delta1 * (1. - 1./Z);
-    phi2 -= delta2 * (1. - 1./Z);
+void BremsKelnerKokoulinPetrukhin::CalculateParametrizationBatch(double energy,
+                                                                 const std::vector<double>& v,
+                                                                 std::vector<double>& result)
+{
+    EvaluateKernel(
+        KelnerKokoulinPetrukhinKernel(*components_[component_index_], particle_def_.mass, energy), v, result);
+}
 
-    // s_atomic
-    double square_momentum   = (energy - particle_def_.mass) * (energy + particle_def_.mass);
-    double particle_momentum = std::sqrt(std::max(square_momentum, 0.0));
-    double maxV = ME * (energy - particle_def_.mass) / (energy * (energy - particle_momentum + ME));
+// ------------------------------------------------------------------------- //
+double BremsCompleteScreening::CalculateParametrization(double energy, double v)
+{
+    (void)energy;
 
-    double s_atomic = 0.0;
+    return CompleteScreeningKernel(*components_[component_index_])(v);
+}
 
-    if (v < maxV)
-    {
-        double s_atomic_1 = std::log(particle_def_.mass / delta / ( particle_def_.mass * delta / (ME * ME) + SQRTE));
-        double s_atomic_2 = std::log(1. + ME / (delta * rad_log_inel * Z13 * Z13 * SQRTE));
-        s_atomic = (4./3. * (1. - v) + v*v) * (s_atomic_1 - s_atomic_2);
-    }
+void BremsCompleteScreening::CalculateParametrizationBatch(double energy,
+                                                           const std::vector<double>& v,
+                                                           std::vector<double>& result)
+{
+    (void)energy;
 
-    // s_rad
-    double s_rad;
+    EvaluateKernel(CompleteScreeningKernel(*components_[component_index_]), v, result);
+}
 
-    if (v < .0 || v > 1.0)
-    {
-        s_rad = 0.;
-    }
-    else if (v < 0.02)
-    {
-        s_rad = a[0] + a[1] * v + a[2] * v * v;
-    }
-    else if (v >= 0.02 && v < 0.1)
-    {
-        s_rad = b[0] + b[1] * v + b[2] * v * v + b[3] * v * v * v;
-    }
-    else if (v >= 0.01 && v < 0.9)
-    {
-        s_rad = c[0] + c[1] * v + c[2] * v * v;
+// ------------------------------------------------------------------------- //
+double BremsAndreevBezrukovBugaev::CalculateParametrization(double energy, double v)
+{
+    return AndreevBezrukovBugaevKernel(*components_[component_index_], particle_def_.mass, energy)(v);
+}
 
-        double tmp = std::log(1. - v);
-        s_rad += c[3] * v * std::log(v) + c[4] * tmp + c[5] * tmp * tmp;
-    }
-    else
-    {
-        s_rad = d[0] + d[1] * v + d[2] * v * v;
+void BremsAndreevBezrukovBugaev::CalculateParametrizationBatch(double energy,
+                                                               const std::vector<double>& v,
+                                                               std::vector<double>& result)
+{
+    EvaluateKernel(
+        AndreevBezrukovBugaevKernel(*components_[component_index_], particle_def_.mass, energy), v, result);
+}
 
-        double tmp = std::log(1. - v);
-        s_rad += d[3] * v * std::log(v) + d[4] * tmp + d[5] * tmp * tmp;
-    }
+// ------------------------------------------------------------------------- //
+double BremsSandrockSoedingreksoRhode::CalculateParametrization(double energy, double v)
+{
+    return SandrockSoedingreksoRhodeKernel(*components_[component_index_], particle_def_.mass, energy)(v);
+}
 
-    return std::max(((2.0 - 2.0 * v + v * v) * phi1 - 2.0/3.0 * (1. - v) * phi2) + 1./Z * s_atomic + 0.25*ALPHA * phi1 * s_rad, 0.);
+void BremsSandrockSoedingreksoRhode::CalculateParametrizationBatch(double energy,
+                                                                   const std::vector<double>& v,
+                                                                   std::vector<double>& result)
+{
+    EvaluateKernel(
+        SandrockSoedingreksoRhodeKernel(*components_[component_index_], particle_def_.mass, energy), v, result);
 }
 
 // ------------------------------------------------------------------------- //
@@ -627,6 +1014,14 @@ double BremsElectronScreening::DifferentialCrossSection(double energy, double v)
     return medium_->GetMolDensity() * components_[component_index_]->GetAtomInMolecule() * aux;
 }
 
+void BremsElectronScreening::DifferentialCrossSectionBatch(double energy,
+                                                           const std::vector<double>& v,
+                                                           std::vector<double>& result)
+{
+    // different prefactor than the other parametrizations
+    Parametrization::DifferentialCrossSectionBatch(energy, v, result);
+}
+
 double BremsElectronScreening::CalculateParametrization(double energy, double v)
 {
 
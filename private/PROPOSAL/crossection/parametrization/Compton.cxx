@@ -83,9 +83,9 @@ Parametrization::IntegralLimits Compton::GetIntegralLimits(double energy)
 // Getter
 // ------------------------------------------------------------------------- //
 
-size_t Compton::GetHash() const
+size_t Compton::GetCutIndependentHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetCutIndependentHash();
     hash_combine(seed);
 
     return seed;
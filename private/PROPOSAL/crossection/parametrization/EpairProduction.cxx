@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <cmath>
 
 #include "PROPOSAL/crossection/parametrization/EpairProduction.h"
@@ -111,23 +112,40 @@ Parametrization::IntegralLimits EpairProduction::GetIntegralLimits(double energy
 // J. Phys. G: Nucl Part. Phys. 28 (2002) 427
 // ------------------------------------------------------------------------- //
 
-double EpairProduction::lpm(double energy, double v, double r2, double b, double x)
+void EpairProduction::InitLpmEffect()
 {
-    if (init_lpm_effect_)
+    init_lpm_effect_ = false;
+    double sum       = 0;
+
+    for (auto component: medium_->GetComponents())
     {
-        init_lpm_effect_ = false;
-        double sum       = 0;
+        sum += component->GetNucCharge() * component->GetNucCharge() *
+               std::log(3.25 * component->GetLogConstant() * std::pow(component->GetNucCharge(), -1. / 3));
+    }
 
-        for (auto component: medium_->GetComponents())
-        {
-            sum += component->GetNucCharge() * component->GetNucCharge() *
-                   std::log(3.25 * component->GetLogConstant() * std::pow(component->GetNucCharge(), -1. / 3));
-        }
+    // eq. 29
+    eLpm_ = particle_def_.mass / (ME * RE);
+    eLpm_ *= (eLpm_ * eLpm_) * ALPHA * particle_def_.mass /
+             (2 * PI * medium_->GetMolDensity() * particle_def_.charge * particle_def_.charge * sum);
+}
+
+// ------------------------------------------------------------------------- //
+double EpairProduction::lpm(double energy, double v, double r2, double b, double x)
+{
+    return lpm(energy,
+               v,
+               r2,
+               b,
+               x,
+               ((2 + r2) * (1 + b) + x * (3 + r2)) * std::log(1 + 1 / x) + (1 - r2 - b) / (1 + x) - (3 + r2));
+}
 
-        // eq. 29
-        eLpm_ = particle_def_.mass / (ME * RE);
-        eLpm_ *= (eLpm_ * eLpm_) * ALPHA * particle_def_.mass /
-                 (2 * PI * medium_->GetMolDensity() * particle_def_.charge * particle_def_.charge * sum);
+// ------------------------------------------------------------------------- //
+double EpairProduction::lpm(double energy, double v, double r2, double b, double x, double denominator)
+{
+    if (init_lpm_effect_)
+    {
+        InitLpmEffect();
     }
 
     // Ternovskii functions calculated in appendix (eq. A.2)
@@ -155,8 +173,7 @@ double EpairProduction::lpm(double energy, double v, double r2, double b, double
     D     = d1 - d1 * d1 * x * log2;
     E     = -s6 * atan_;
 
-    return ((1 + b) * (A + (1 + r2) * B) + b * (C + (1 + r2) * D) + (1 - r2) * E) /
-           (((2 + r2) * (1 + b) + x * (3 + r2)) * std::log(1 + 1 / x) + (1 - r2 - b) / (1 + x) - (3 + r2));
+    return ((1 + b) * (A + (1 + r2) * B) + b * (C + (1 + r2) * D) + (1 - r2) * E) / denominator;
 }
 
 // ------------------------------------------------------------------------- //
@@ -220,10 +237,38 @@ double EpairProductionRhoIntegral::DifferentialCrossSection(double energy, doubl
 
     return medium_->GetMolDensity() * components_[component_index_]->GetAtomInMolecule() *
            particle_def_.charge * particle_def_.charge *
-           (integral_.Integrate(
-                1 - rMax, aux, std::bind(&EpairProductionRhoIntegral::FunctionToIntegral, this, energy, v, std::placeholders::_1), 2) +
-            integral_.Integrate(
-                aux, 1, std::bind(&EpairProductionRhoIntegral::FunctionToIntegral, this, energy, v, std::placeholders::_1), 4));
+           (integral_.IntegrateBatch(1 - rMax,
+                                     aux,
+                                     std::bind(&EpairProductionRhoIntegral::FunctionToIntegralBatch,
+                                               this,
+                                               energy,
+                                               v,
+                                               std::placeholders::_1,
+                                               std::placeholders::_2),
+                                     2) +
+            integral_.IntegrateBatch(aux,
+                                     1,
+                                     std::bind(&EpairProductionRhoIntegral::FunctionToIntegralBatch,
+                                               this,
+                                               energy,
+                                               v,
+                                               std::placeholders::_1,
+                                               std::placeholders::_2),
+                                     4));
+}
+
+// ------------------------------------------------------------------------- //
+void EpairProductionRhoIntegral::FunctionToIntegralBatch(double energy,
+                                                         double v,
+                                                         const std::vector<double>& rho,
+                                                         std::vector<double>& result)
+{
+    result.resize(rho.size());
+
+    for (size_t i = 0; i < rho.size(); ++i)
+    {
+        result[i] = FunctionToIntegral(energy, v, rho[i]);
+    }
 }
 
 // ------------------------------------------------------------------------- //
@@ -233,9 +278,9 @@ void EpairProductionRhoIntegral::print(std::ostream& os) const
 }
 
 // ------------------------------------------------------------------------- //
-size_t EpairProductionRhoIntegral::GetHash() const
+size_t EpairProductionRhoIntegral::GetCutIndependentHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetCutIndependentHash();
     hash_combine(seed, lpm_);
 
     return seed;
@@ -253,255 +298,395 @@ EPAIR_PARAM_INTEGRAL_IMPL(KelnerKokoulinPetrukhin)
 EPAIR_PARAM_INTEGRAL_IMPL(SandrockSoedingreksoRhode)
 
 // ------------------------------------------------------------------------- //
-double EpairKelnerKokoulinPetrukhin::FunctionToIntegral(double energy, double v, double r)
+// Kernels of the specific parametrizations
+// ------------------------------------------------------------------------- //
+
+// The terms, which do not depend on rho, are computed once by the
+// constructor of a kernel and the remaining terms by its call operator,
+// which returns the cross section without the LPM suppression. The single
+// point and the batch methods both evaluate the parametrizations with these
+// kernels.
+
+namespace {
+
+// ------------------------------------------------------------------------- //
+// Parametrization of Kelner/Kokoulin/Petrukhin
+// Proc. 12th ICCR (1971), 2436
+// ------------------------------------------------------------------------- //
+
+struct KelnerKokoulinPetrukhinKernel
 {
-    // Parametrization of Kelner/Kokoulin/Petrukhin
-    // Proc. 12th ICCR (1971), 2436
-    //
-    // there are two pair production diagrams taking into account here
-    // where an electron (or positron) couples to the nucleus (marked with xx_e)
-    // and where the muon couples to the nucleus (marked with xx_mu)
-    //
-    // an additional contribution comes from the scattering on atomic electrons
-    // this is described below
-
-    double g1, g2;
-    double aux, aux1, aux2, r2;
-    double diagram_e, diagram_mu, atomic_electron_contribution;
-    double medium_charge       = components_[component_index_]->GetNucCharge();
-    double medium_log_constant = components_[component_index_]->GetLogConstant();
-
-    r           = 1 - r; // only for integral optimization - do not forget to swap integration limits!
-    r2          = r * r;
-    double Z3   = std::pow(medium_charge, -1. / 3);
-    aux         = (particle_def_.mass * v) / (2 * ME);
-    double xi   = aux * aux * (1 - r2) / (1 - v);
-    double beta = (v * v) / (2 * (1 - v));
-
-    // these are the Y_e and Y_mu expressions in the original paper
-    diagram_e  = (5 - r2 + 4 * beta * (1 + r2)) / (2 * (1 + 3 * beta) * std::log(3 + 1 / xi) - r2 - 2 * beta * (2 - r2));
-    diagram_mu = (4 + r2 + 3 * beta * (1 + r2)) / ((1 + r2) * (1.5 + 2 * beta) * std::log(3 + xi) + 1 - 1.5 * r2);
-
-    // these arae the L_e and L_mu expressions
-    aux        = (1.5 * ME) / (particle_def_.mass * Z3);
-    aux1       = (1 + xi) * (1 + diagram_e);
-    aux2       = (2 * ME * SQRTE * medium_log_constant * Z3) / (energy * v * (1 - r2));
-    diagram_e  = std::log((medium_log_constant * Z3 * std::sqrt(aux1)) / (1 + aux2 * aux1)) - 0.5 * std::log(1 + aux * aux * aux1);
-    diagram_mu = std::log((medium_log_constant / aux * Z3) / (1 + aux2 * (1 + xi) * (1 + diagram_mu)));
-
-    // these are the Phi_e and Phi_mu expressions
-    // if the logarithms above are below zero, the contribution of the diagram is set to zero
-    // if lpm supression is taken into account, Phi_e is changed
-    if (diagram_e > 0)
+    KelnerKokoulinPetrukhinKernel(const Components::Component& component,
+                                  const ParticleDef& particle_def,
+                                  double energy,
+                                  double v)
+        : energy_(energy)
+        , v_(v)
+        , medium_log_constant_(component.GetLogConstant())
+        , Z3_(std::pow(component.GetNucCharge(), -1. / 3))
+        , xi_aux_(0)
+        , beta_((v * v) / (2 * (1 - v)))
+        , L_aux_((1.5 * ME) / (particle_def.mass * Z3_))
+        , L_aux2_(2 * ME * SQRTE * medium_log_constant_ * Z3_)
+        , prefactor_(0)
+        , mass_ratio_(0)
     {
-        if (1 / xi < HALF_PRECISION)
+        double g1, g2;
+        double medium_charge = component.GetNucCharge();
+
+        double aux = (particle_def.mass * v) / (2 * ME);
+        xi_aux_    = aux * aux;
+
+        // Calculating the contribution of atomic electrons as scattering partner
+        // Phys. Atom. Nucl. 61 (1998), 448
+        if (medium_charge == 1)
         {
-            // TODO: where does this short expression come from?
-            diagram_e = (1.5 - r2 / 2 + beta * (1 + r2)) / xi * diagram_e;
+            g1 = 4.4e-5;
+            g2 = 4.8e-5;
         } else
         {
-            diagram_e =
-                (((2 + r2) * (1 + beta) + xi * (3 + r2)) * std::log(1 + 1 / xi) + (1 - r2 - beta) / (1 + xi) - (3 + r2)) *
-                diagram_e;
+            g1 = 1.95e-5;
+            g2 = 5.3e-5;
         }
-    } else
-    {
-        diagram_e = 0;
-    }
 
-    if (diagram_mu > 0)
-    {
-        diagram_mu = (((1 + r2) * (1 + 1.5 * beta) - (1 + 2 * beta) * (1 - r2) / xi) * std::log(1 + xi) +
-                      xi * (1 - r2 - beta) / (1 + xi) + (1 + 2 * beta) * (1 - r2)) *
-                     diagram_mu;
-    } else
-    {
-        diagram_mu = 0;
-    }
+        double atomic_electron_contribution;
 
-    // Calculating the contribution of atomic electrons as scattering partner
-    // Phys. Atom. Nucl. 61 (1998), 448
-    if (medium_charge == 1)
-    {
-        g1 = 4.4e-5;
-        g2 = 4.8e-5;
-    } else
-    {
-        g1 = 1.95e-5;
-        g2 = 5.3e-5;
-    }
+        aux         = energy / particle_def.mass;
+        double aux1 = 0.073 * std::log(aux / (1 + g1 * aux / (Z3_ * Z3_))) - 0.26;
+        double aux2 = 0.058 * std::log(aux / (1 + g2 * aux / Z3_)) - 0.14;
 
-    aux  = energy / particle_def_.mass;
-    aux1 = 0.073 * std::log(aux / (1 + g1 * aux / (Z3 * Z3))) - 0.26;
-    aux2 = 0.058 * std::log(aux / (1 + g2 * aux / Z3)) - 0.14;
+        if (aux1 > 0 && aux2 > 0)
+        {
+            atomic_electron_contribution = aux1 / aux2;
+        } else
+        {
+            atomic_electron_contribution = 0;
+        }
 
-    if (aux1 > 0 && aux2 > 0)
-    {
-        atomic_electron_contribution = aux1 / aux2;
-    } else
-    {
-        atomic_electron_contribution = 0;
+        prefactor_ = ALPHA * RE * particle_def.charge;
+        prefactor_ *= prefactor_ / (1.5 * PI) * 2 * medium_charge * (medium_charge + atomic_electron_contribution);
+        mass_ratio_ = ME / particle_def.mass * particle_def.charge;
+        mass_ratio_ *= mass_ratio_;
     }
 
-    // combining the results
-    aux = ALPHA * RE * particle_def_.charge;
-    ;
-    aux *= aux / (1.5 * PI) * 2 * medium_charge * (medium_charge + atomic_electron_contribution);
-    aux1 = ME / particle_def_.mass * particle_def_.charge;
-    ;
-    aux *= (1 - v) / v * (diagram_e + aux1 * aux1 * diagram_mu);
-
-    if (lpm_)
+    double operator()(double rho, double& r2, double& xi) const
     {
-        aux *= lpm(energy, v, r2, beta, xi);
-    }
+        // there are two pair production diagrams taking into account here
+        // where an electron (or positron) couples to the nucleus (marked with xx_e)
+        // and where the muon couples to the nucleus (marked with xx_mu)
+        //
+        // an additional contribution comes from the scattering on atomic electrons,
+        // which is part of the prefactor
+
+        double r = 1 - rho; // only for integral optimization - do not forget to swap integration limits!
+        r2       = r * r;
+        xi       = xi_aux_ * (1 - r2) / (1 - v_);
+
+        // these are the Y_e and Y_mu expressions in the original paper
+        double diagram_e =
+            (5 - r2 + 4 * beta_ * (1 + r2)) / (2 * (1 + 3 * beta_) * std::log(3 + 1 / xi) - r2 - 2 * beta_ * (2 - r2));
+        double diagram_mu =
+            (4 + r2 + 3 * beta_ * (1 + r2)) / ((1 + r2) * (1.5 + 2 * beta_) * std::log(3 + xi) + 1 - 1.5 * r2);
+
+        // these arae the L_e and L_mu expressions
+        double aux1 = (1 + xi) * (1 + diagram_e);
+        double aux2 = L_aux2_ / (energy_ * v_ * (1 - r2));
+        diagram_e   = std::log((medium_log_constant_ * Z3_ * std::sqrt(aux1)) / (1 + aux2 * aux1)) -
+                    0.5 * std::log(1 + L_aux_ * L_aux_ * aux1);
+        diagram_mu = std::log((medium_log_constant_ / L_aux_ * Z3_) / (1 + aux2 * (1 + xi) * (1 + diagram_mu)));
+
+        // these are the Phi_e and Phi_mu expressions
+        // if the logarithms above are below zero, the contribution of the diagram is set to zero
+        // if lpm supression is taken into account, Phi_e is changed
+        if (diagram_e > 0)
+        {
+            if (1 / xi < HALF_PRECISION)
+            {
+                // TODO: where does this short expression come from?
+                diagram_e = (1.5 - r2 / 2 + beta_ * (1 + r2)) / xi * diagram_e;
+            } else
+            {
+                diagram_e = (((2 + r2) * (1 + beta_) + xi * (3 + r2)) * std::log(1 + 1 / xi) +
+                             (1 - r2 - beta_) / (1 + xi) - (3 + r2)) *
+                            diagram_e;
+            }
+        } else
+        {
+            diagram_e = 0;
+        }
 
-    if (aux < 0)
-    {
-        aux = 0;
+        if (diagram_mu > 0)
+        {
+            diagram_mu = (((1 + r2) * (1 + 1.5 * beta_) - (1 + 2 * beta_) * (1 - r2) / xi) * std::log(1 + xi) +
+                          xi * (1 - r2 - beta_) / (1 + xi) + (1 + 2 * beta_) * (1 - r2)) *
+                         diagram_mu;
+        } else
+        {
+            diagram_mu = 0;
+        }
+
+        // combining the results
+        return prefactor_ * ((1 - v_) / v_ * (diagram_e + mass_ratio_ * diagram_mu));
     }
 
-    return aux;
-}
+    double energy_;
+    double v_;
+    double medium_log_constant_;
+    double Z3_;
+    double xi_aux_;
+    double beta_;
+    double L_aux_;
+    double L_aux2_;
+    double prefactor_;
+    double mass_ratio_;
+};
 
 // ------------------------------------------------------------------------- //
-double EpairSandrockSoedingreksoRhode::FunctionToIntegral(double energy, double v, double rho)
+// Parametrization of Sandrock/Soedingrekso/Rhode
+// ------------------------------------------------------------------------- //
+
+struct SandrockSoedingreksoRhodeKernel
 {
-    double m_in = particle_def_.mass;
+    SandrockSoedingreksoRhodeKernel(const Components::Component& component,
+                                    const ParticleDef& particle_def,
+                                    double energy,
+                                    double v)
+        : energy_(energy)
+        , v_(v)
+        , beta_(v * v / (2.0 * (1.0 - v)))
+        , xi_aux_(std::pow(particle_def.mass * v / (2.0 * ME), 2.0))
+        , rad_log_Z13_(0)
+        , exp_sixth_(std::exp(-1.0 / 6.0))
+        , le1_screening_(0)
+        , le2_screening_(0)
+        , nucl_size_(0)
+        , nucl_size2_(0)
+        , lm_aux_(0)
+        , diagram_e_prefactor_(0)
+        , diagram_mu_prefactor_(0)
+    {
+        double m_in = particle_def.mass;
 
-    double nucl_Z = components_[component_index_]->GetNucCharge();
-    double nucl_A = components_[component_index_]->GetAtomicNum();
+        double nucl_Z = component.GetNucCharge();
+        double nucl_A = component.GetAtomicNum();
 
-    double rad_log = components_[component_index_]->GetLogConstant();
+        double rad_log = component.GetLogConstant();
 
-    double const_prefactor = 4.0 / (3.0 * PI) * nucl_Z * std::pow(ALPHA * RE, 2.0);
-    double Z13             = std::pow(nucl_Z, -1.0 / 3.0);
-    double d_n             = 1.54 * std::pow(nucl_A, 0.27);
+        double const_prefactor = 4.0 / (3.0 * PI) * nucl_Z * std::pow(ALPHA * RE, 2.0);
+        double Z13             = std::pow(nucl_Z, -1.0 / 3.0);
+        double d_n             = 1.54 * std::pow(nucl_A, 0.27);
 
-    rho         = 1 - rho;
-    double rho2 = rho * rho;
+        // --------------------------------------------------------------------- //
+        // Zeta
+        // --------------------------------------------------------------------- //
 
-    // --------------------------------------------------------------------- //
-    // Zeta
-    // --------------------------------------------------------------------- //
+        double g1 = 1.95e-5;
+        double g2 = 5.3e-5;
 
-    double g1 = 1.95e-5;
-    double g2 = 5.3e-5;
+        if (nucl_Z == 1.0)
+        {
+            g1 = 4.4e-5;
+            g2 = 4.8e-5;
+        }
 
-    if (nucl_Z == 1.0)
-    {
-        g1 = 4.4e-5;
-        g2 = 4.8e-5;
-    }
+        double zeta, zeta1, zeta2;
+        zeta1 = (0.073 * std::log(energy / m_in / (1.0 + g1 * std::pow(nucl_Z, 2.0 / 3.0) * energy / m_in)) - 0.26);
+        zeta2 = (0.058 * std::log(energy / m_in / (1 + g2 / Z13 * energy / m_in)) - 0.14);
 
-    double zeta, zeta1, zeta2;
-    zeta1 = (0.073 * std::log(energy / m_in / (1.0 + g1 * std::pow(nucl_Z, 2.0 / 3.0) * energy / m_in)) - 0.26);
-    zeta2 = (0.058 * std::log(energy / m_in / (1 + g2 / Z13 * energy / m_in)) - 0.14);
+        if (zeta1 > 0.0 && zeta2 > 0.0)
+        {
+            zeta = zeta1 / zeta2;
+        } else
+        {
+            zeta = 0.0;
+        }
 
-    if (zeta1 > 0.0 && zeta2 > 0.0)
-    {
-        zeta = zeta1 / zeta2;
-    } else
-    {
-        zeta = 0.0;
+        rad_log_Z13_   = rad_log * Z13;
+        le1_screening_ = 2.0 * ME * std::exp(0.5) * rad_log * Z13;
+        le2_screening_ = 2.0 * ME * std::exp(1.0 / 3.0) * rad_log * Z13;
+        nucl_size_     = std::pow(ME / m_in * d_n, 2.0);
+        nucl_size2_    = nucl_size_ * std::exp(-1.0 / 3.0);
+        lm_aux_        = m_in / ME * rad_log * Z13 / d_n;
+
+        diagram_e_prefactor_  = const_prefactor * (nucl_Z + zeta) * (1.0 - v) / v;
+        diagram_mu_prefactor_ = diagram_e_prefactor_ * std::pow(ME / m_in, 2.0);
     }
 
-    double beta = v * v / (2.0 * (1.0 - v));
-    double xi   = std::pow(m_in * v / (2.0 * ME), 2.0) * (1.0 - rho2) / (1.0 - v);
+    double operator()(double rho, double& rho2, double& xi, double& Be) const
+    {
+        double r = 1 - rho;
+        rho2     = r * r;
+        xi       = xi_aux_ * (1.0 - rho2) / (1.0 - v_);
 
-    // --------------------------------------------------------------------- //
-    // Diagram e
-    // --------------------------------------------------------------------- //
+        double beta       = beta_;
+        double log_xi     = std::log(1.0 + xi);
+        double log_xi_inv = std::log(1.0 + 1.0 / xi);
+        double screening  = (1.0 + xi) / (energy_ * v_ * (1.0 - rho2));
 
-    double Be = ((2.0 + rho2) * (1.0 + beta) + xi * (3.0 + rho2)) * std::log(1.0 + 1.0 / xi) +
-                (1.0 - rho2 - beta) / (1.0 + xi) - (3.0 + rho2);
+        // --------------------------------------------------------------------- //
+        // Diagram e
+        // --------------------------------------------------------------------- //
 
-    double Ce2 = ((1.0 - rho2) * (1.0 + beta) + xi * (3.0 - rho2)) * std::log(1.0 + 1.0 / xi) +
-                 2.0 * (1.0 - beta - rho2) / (1.0 + xi) - (3.0 - rho2);
-    double Ce1 = Be - Ce2;
+        Be = ((2.0 + rho2) * (1.0 + beta) + xi * (3.0 + rho2)) * log_xi_inv + (1.0 - rho2 - beta) / (1.0 + xi) -
+             (3.0 + rho2);
 
-    double De = ((2.0 + rho2) * (1.0 + beta) + xi * (3.0 + rho2)) * dilog(1.0 / (1.0 + xi)) -
-                (2.0 + rho2) * xi * std::log(1.0 + 1.0 / xi) - (xi + rho2 + beta) / (1.0 + xi);
+        double Ce2 = ((1.0 - rho2) * (1.0 + beta) + xi * (3.0 - rho2)) * log_xi_inv +
+                     2.0 * (1.0 - beta - rho2) / (1.0 + xi) - (3.0 - rho2);
+        double Ce1 = Be - Ce2;
 
-    double Le1, Le2;
+        double De = ((2.0 + rho2) * (1.0 + beta) + xi * (3.0 + rho2)) * dilog(1.0 / (1.0 + xi)) -
+                    (2.0 + rho2) * xi * log_xi_inv - (xi + rho2 + beta) / (1.0 + xi);
 
-    if (De / Be > 0.)
-    {
-        double Xe = std::exp(-De / Be);
-        Le1 = std::log(rad_log * Z13 * std::sqrt(1.0 + xi) /
-                         (Xe + 2.0 * ME * std::exp(0.5) * rad_log * Z13 * (1.0 + xi) / (energy * v * (1.0 - rho2)))) -
-                     De / Be - 0.5 * std::log(Xe + std::pow(ME / m_in * d_n, 2.0) * (1.0 + xi));
-
-        Le2 = std::log(rad_log * Z13 * std::exp(-1.0 / 6.0) * std::sqrt(1 + xi) /
-                         (Xe + 2.0 * ME * std::exp(1.0 / 3.0) * rad_log * Z13 * (1.0 + xi) / (energy * v * (1.0 - rho2)))) -
-                     De / Be - 0.5 * std::log(Xe + pow(ME / m_in * d_n, 2.0) * std::exp(-1.0 / 3.0) * (1.0 + xi));
-    }
-    else
-    {
-        double Xe_inv = std::exp(De / Be);
-        Le1 = std::log(rad_log * Z13 * std::sqrt(1.0 + xi) /
-                         (1. + Xe_inv * 2.0 * ME * std::exp(0.5) * rad_log * Z13 * (1.0 + xi) / (energy * v * (1.0 - rho2)))) -
-                     0.5 * De / Be - 0.5 * std::log(1. + Xe_inv * std::pow(ME / m_in * d_n, 2.0) * (1.0 + xi));
-
-        Le2 = std::log(rad_log * Z13 * std::exp(-1.0 / 6.0) * std::sqrt(1 + xi) /
-                         (1. + Xe_inv * 2.0 * ME * std::exp(1.0 / 3.0) * rad_log * Z13 * (1.0 + xi) / (energy * v * (1.0 - rho2)))) -
-                     0.5 * De / Be - 0.5 * std::log(1. + Xe_inv * std::pow(ME / m_in * d_n, 2.0) * std::exp(-1.0 / 3.0) * (1.0 + xi));
-    }
+        double Le1, Le2;
+
+        if (De / Be > 0.)
+        {
+            double Xe = std::exp(-De / Be);
+            Le1 = std::log(rad_log_Z13_ * std::sqrt(1.0 + xi) / (Xe + le1_screening_ * screening)) - De / Be -
+                  0.5 * std::log(Xe + nucl_size_ * (1.0 + xi));
+            Le2 = std::log(rad_log_Z13_ * exp_sixth_ * std::sqrt(1 + xi) / (Xe + le2_screening_ * screening)) - De / Be -
+                  0.5 * std::log(Xe + nucl_size2_ * (1.0 + xi));
+        } else
+        {
+            double Xe_inv = std::exp(De / Be);
+            Le1 = std::log(rad_log_Z13_ * std::sqrt(1.0 + xi) / (1. + Xe_inv * le1_screening_ * screening)) -
+                  0.5 * De / Be - 0.5 * std::log(1. + Xe_inv * nucl_size_ * (1.0 + xi));
+            Le2 = std::log(rad_log_Z13_ * exp_sixth_ * std::sqrt(1 + xi) / (1. + Xe_inv * le2_screening_ * screening)) -
+                  0.5 * De / Be - 0.5 * std::log(1. + Xe_inv * nucl_size2_ * (1.0 + xi));
+        }
+
+        double diagram_e = std::max(0.0, diagram_e_prefactor_ * (Ce1 * Le1 + Ce2 * Le2));
 
-    double diagram_e = std::max(0.0, const_prefactor * (nucl_Z + zeta) * (1.0 - v) / v * (Ce1 * Le1 + Ce2 * Le2));
+        // --------------------------------------------------------------------- //
+        // Diagram mu
+        // --------------------------------------------------------------------- //
+
+        double Bm = ((1.0 + rho2) * (1.0 + (3.0 * beta) / 2) - 1.0 / xi * (1.0 + 2.0 * beta) * (1.0 - rho2)) * log_xi +
+                    xi * (1.0 - rho2 - beta) / (1.0 + xi) + (1.0 + 2.0 * beta) * (1.0 - rho2);
+
+        double Cm2 = ((1.0 - beta) * (1.0 - rho2) - xi * (1.0 + rho2)) * log_xi / xi -
+                     2.0 * (1.0 - beta - rho2) / (1.0 + xi) + 1.0 - beta - (1.0 + beta) * rho2;
+        double Cm1 = Bm - Cm2;
+
+        double Dm = ((1.0 + rho2) * (1.0 + (3.0 * beta) / 2.0) - 1.0 / xi * (1.0 + 2.0 * beta) * (1.0 - rho2)) *
+                        dilog(xi / (1.0 + xi)) +
+                    (1.0 + (3.0 * beta) / 2.0) * (1.0 - rho2) / xi * log_xi +
+                    (1.0 - rho2 - beta / 2.0 * (1.0 + rho2) + (1.0 - rho2) / (2.0 * xi) * beta) * xi / (1.0 + xi);
+
+        double Lm1, Lm2;
+
+        if (Dm / Bm > 0.0)
+        {
+            double Xm = std::exp(-Dm / Bm);
+            Lm1       = std::log(Xm * lm_aux_ / (Xm + le1_screening_ * screening));
+            Lm2       = std::log(Xm * lm_aux_ / (Xm + le2_screening_ * screening));
+        } else
+        {
+            double Xm_inv = std::exp(Dm / Bm);
+            Lm1           = std::log(lm_aux_ / (1.0 + le1_screening_ * screening * Xm_inv));
+            Lm2           = std::log(lm_aux_ / (1.0 + le2_screening_ * screening * Xm_inv));
+        }
 
-    // --------------------------------------------------------------------- //
-    // Diagram mu
-    // --------------------------------------------------------------------- //
+        double diagram_mu = std::max(0.0, diagram_mu_prefactor_ * (Cm1 * Lm1 + Cm2 * Lm2));
 
-    double Bm =
-        ((1.0 + rho2) * (1.0 + (3.0 * beta) / 2) - 1.0 / xi * (1.0 + 2.0 * beta) * (1.0 - rho2)) * std::log(1.0 + xi) +
-        xi * (1.0 - rho2 - beta) / (1.0 + xi) + (1.0 + 2.0 * beta) * (1.0 - rho2);
+        return diagram_e + diagram_mu;
+    }
 
-    double Cm2 = ((1.0 - beta) * (1.0 - rho2) - xi * (1.0 + rho2)) * std::log(1.0 + xi) / xi -
-                 2.0 * (1.0 - beta - rho2) / (1.0 + xi) + 1.0 - beta - (1.0 + beta) * rho2;
-    double Cm1 = Bm - Cm2;
+    double energy_;
+    double v_;
+    double beta_;
+    double xi_aux_;
+    double rad_log_Z13_;
+    double exp_sixth_;
+    double le1_screening_;
+    double le2_screening_;
+    double nucl_size_;
+    double nucl_size2_;
+    double lm_aux_;
+    double diagram_e_prefactor_;
+    double diagram_mu_prefactor_;
+};
+
+} // namespace
 
-    double Dm = ((1.0 + rho2) * (1.0 + (3.0 * beta) / 2.0) - 1.0 / xi * (1.0 + 2.0 * beta) * (1.0 - rho2)) *
-                    dilog(xi / (1.0 + xi)) +
-                (1.0 + (3.0 * beta) / 2.0) * (1.0 - rho2) / xi * std::log(1.0 + xi) +
-                (1.0 - rho2 - beta / 2.0 * (1.0 + rho2) + (1.0 - rho2) / (2.0 * xi) * beta) * xi / (1.0 + xi);
+// ------------------------------------------------------------------------- //
+double EpairKelnerKokoulinPetrukhin::FunctionToIntegral(double energy, double v, double r)
+{
+    KelnerKokoulinPetrukhinKernel kernel(*components_[component_index_], particle_def_, energy, v);
 
-    double Lm1, Lm2;
+    double r2, xi;
+    double aux = kernel(r, r2, xi);
 
-    if (Dm / Bm > 0.0)
+    if (lpm_)
     {
-        double Xm = std::exp(-Dm / Bm);
-        Lm1 = std::log(Xm * m_in / ME * rad_log * Z13 / d_n /
-                  (Xm + 2.0 * ME * std::exp(0.5) * rad_log * Z13 * (1.0 + xi) / (energy * v * (1.0 - rho2))));
-        Lm2 = std::log(Xm * m_in / ME * rad_log * Z13 / d_n /
-                  (Xm + 2.0 * ME * std::exp(1.0 / 3.0) * rad_log * Z13 * (1.0 + xi) / (energy * v * (1.0 - rho2))));
-    } else
+        aux *= lpm(energy, v, r2, kernel.beta_, xi);
+    }
+
+    return std::max(aux, 0.);
+}
+
+// ------------------------------------------------------------------------- //
+void EpairKelnerKokoulinPetrukhin::FunctionToIntegralBatch(double energy,
+                                                           double v,
+                                                           const std::vector<double>& rho,
+                                                           std::vector<double>& result)
+{
+    KelnerKokoulinPetrukhinKernel kernel(*components_[component_index_], particle_def_, energy, v);
+
+    result.resize(rho.size());
+
+    for (size_t i = 0; i < rho.size(); ++i)
     {
-        double Xm_inv = std::exp(Dm / Bm);
-        Lm1 = std::log(m_in / ME * rad_log * Z13 / d_n /
-                  (1.0 + 2.0 * ME * std::exp(0.5) * rad_log * Z13 * (1.0 + xi) / (energy * v * (1.0 - rho2)) * Xm_inv));
-        Lm2 = std::log(
-            m_in / ME * rad_log * Z13 / d_n /
-            (1.0 + 2.0 * ME * std::exp(1.0 / 3.0) * rad_log * Z13 * (1.0 + xi) / (energy * v * (1.0 - rho2)) * Xm_inv));
+        double r2, xi;
+        double aux = kernel(rho[i], r2, xi);
+
+        if (lpm_)
+        {
+            aux *= lpm(energy, v, r2, kernel.beta_, xi);
+        }
+
+        result[i] = std::max(aux, 0.);
     }
+}
 
-    double diagram_mu = std::max(
-        0.0, const_prefactor * (nucl_Z + zeta) * (1.0 - v) / v * std::pow(ME / m_in, 2.0) * (Cm1 * Lm1 + Cm2 * Lm2));
+// ------------------------------------------------------------------------- //
+double EpairSandrockSoedingreksoRhode::FunctionToIntegral(double energy, double v, double rho)
+{
+    SandrockSoedingreksoRhodeKernel kernel(*components_[component_index_], particle_def_, energy, v);
 
-    double aux = diagram_e + diagram_mu;
+    double rho2, xi, Be;
+    double aux = kernel(rho, rho2, xi, Be);
 
     if (lpm_)
     {
-        aux *= lpm(energy, v, rho2, beta, xi);
+        aux *= lpm(energy, v, rho2, kernel.beta_, xi, Be);
     }
 
-    if (aux < 0.0)
+    return std::max(aux, 0.0);
+}
+
+// ------------------------------------------------------------------------- //
+void EpairSandrockSoedingreksoRhode::FunctionToIntegralBatch(double energy,
+                                                             double v,
+                                                             const std::vector<double>& rho,
+                                                             std::vector<double>& result)
+{
+    SandrockSoedingreksoRhodeKernel kernel(*components_[component_index_], particle_def_, energy, v);
+
+    result.resize(rho.size());
+
+    for (size_t i = 0; i < rho.size(); ++i)
     {
-        aux = 0.0;
-    }
+        double rho2, xi, Be;
+        double aux = kernel(rho[i], rho2, xi, Be);
 
-    return aux;
+        if (lpm_)
+        {
+            aux *= lpm(energy, v, rho2, kernel.beta_, xi, Be);
+        }
+
+        result[i] = std::max(aux, 0.0);
+    }
 }
 
 #undef EPAIR_PARAM_INTEGRAL_IMPL
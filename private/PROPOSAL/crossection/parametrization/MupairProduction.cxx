@@ -185,9 +185,9 @@ void MupairProductionRhoIntegral::print(std::ostream& os) const
 */
 
 // ------------------------------------------------------------------------- //
-size_t MupairProductionRhoIntegral::GetHash() const
+size_t MupairProductionRhoIntegral::GetCutIndependentHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetCutIndependentHash();
     hash_combine(seed);
 
     return seed;
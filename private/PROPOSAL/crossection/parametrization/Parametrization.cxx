@@ -101,15 +101,64 @@ double Parametrization::FunctionToDE2dxIntegral(double energy,
     return variable * variable * DifferentialCrossSection(energy, variable);
 }
 
+// ------------------------------------------------------------------------- //
+void Parametrization::DifferentialCrossSectionBatch(double energy,
+                                                    const std::vector<double>& v,
+                                                    std::vector<double>& result) {
+    result.resize(v.size());
+
+    for (size_t i = 0; i < v.size(); ++i) {
+        result[i] = DifferentialCrossSection(energy, v[i]);
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void Parametrization::FunctionToDNdxIntegralBatch(double energy,
+                                                  const std::vector<double>& v,
+                                                  std::vector<double>& result) {
+    DifferentialCrossSectionBatch(energy, v, result);
+}
+
+// ------------------------------------------------------------------------- //
+void Parametrization::FunctionToDEdxIntegralBatch(double energy,
+                                                  const std::vector<double>& v,
+                                                  std::vector<double>& result) {
+    // FunctionToDEdxIntegral may be overridden (e.g. inelastic corrections),
+    // so only parametrizations knowing better skip the single point calls
+    result.resize(v.size());
+
+    for (size_t i = 0; i < v.size(); ++i) {
+        result[i] = FunctionToDEdxIntegral(energy, v[i]);
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void Parametrization::FunctionToDE2dxIntegralBatch(double energy,
+                                                   const std::vector<double>& v,
+                                                   std::vector<double>& result) {
+    DifferentialCrossSectionBatch(energy, v, result);
+
+    for (size_t i = 0; i < v.size(); ++i) {
+        result[i] *= v[i] * v[i];
+    }
+}
+
 // ------------------------------------------------------------------------- //
 // Getter
 // ------------------------------------------------------------------------- //
 
-size_t Parametrization::GetHash() const {
+size_t Parametrization::GetCutIndependentHash() const {
     std::size_t seed = 0;
     hash_combine(seed, GetName(), std::abs(particle_def_.charge),
-                 particle_def_.mass, medium_->GetName(),
-                 cut_settings_.GetEcut(), cut_settings_.GetVcut());
+                 particle_def_.mass, medium_->GetName());
+
+    return seed;
+}
+
+// ------------------------------------------------------------------------- //
+size_t Parametrization::GetHash() const {
+    std::size_t seed = GetCutIndependentHash();
+    hash_combine(seed, cut_settings_.GetEcut(), cut_settings_.GetVcut());
 
     return seed;
 }
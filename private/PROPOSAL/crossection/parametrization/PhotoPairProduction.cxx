@@ -59,9 +59,9 @@ Parametrization::IntegralLimits PhotoPairProduction::GetIntegralLimits(double en
     return limits;
 }
 
-size_t PhotoPairProduction::GetHash() const
+size_t PhotoPairProduction::GetCutIndependentHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetCutIndependentHash();
     hash_combine(seed);
 
     return seed;
@@ -106,9 +106,9 @@ double PhotoQ2Integral::DifferentialCrossSection(double energy, double v)
 // ------------------------------------------------------------------------- //
 
 // ------------------------------------------------------------------------- //
-size_t PhotoQ2Integral::GetHash() const
+size_t PhotoQ2Integral::GetCutIndependentHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetCutIndependentHash();
     hash_combine(seed, shadow_effect_->GetHash());
 
     return seed;
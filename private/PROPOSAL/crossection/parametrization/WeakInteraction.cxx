@@ -54,9 +54,9 @@ Parametrization::IntegralLimits WeakInteraction::GetIntegralLimits(double energy
     return limits;
 }
 
-size_t WeakInteraction::GetHash() const
+size_t WeakInteraction::GetCutIndependentHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetCutIndependentHash();
     hash_combine(seed, particle_def_.charge);
 
     return seed;
@@ -72,17 +72,22 @@ WeakCooperSarkarMertsch::WeakCooperSarkarMertsch(const ParticleDef& particle_def
         : WeakInteraction(particle_def, medium, multiplier)
         , interpolant_(2, NULL)
 {
+    // The tables are built once and shared by all parametrizations
+    static const UniformGridInterpolant2D interpolant_nubar_p(energies, y_nubar_p, sigma_nubar_p, IROMB);
+    static const UniformGridInterpolant2D interpolant_nubar_n(energies, y_nubar_n, sigma_nubar_n, IROMB);
+    static const UniformGridInterpolant2D interpolant_nu_p(energies, y_nu_p, sigma_nu_p, IROMB);
+    static const UniformGridInterpolant2D interpolant_nu_n(energies, y_nu_n, sigma_nu_n, IROMB);
 
     if(particle_def.charge < 0.)
     {
         // Initialize interpolant for particles (remember crossing symmetry rules)
-        interpolant_[0] = new Interpolant(energies, y_nubar_p, sigma_nubar_p, IROMB, false, false, IROMB, false, false);
-        interpolant_[1] = new Interpolant(energies, y_nubar_n, sigma_nubar_n, IROMB, false, false, IROMB, false, false);
+        interpolant_[0] = &interpolant_nubar_p;
+        interpolant_[1] = &interpolant_nubar_n;
     }
     else if(particle_def.charge > 0.){
         // Initialize interpolant for antiparticles (remember crossing symmetry rules)
-        interpolant_[0] = new Interpolant(energies, y_nu_p, sigma_nu_p, IROMB, false, false, IROMB, false, false);
-        interpolant_[1] = new Interpolant(energies, y_nu_n, sigma_nu_n, IROMB, false, false, IROMB, false, false);
+        interpolant_[0] = &interpolant_nu_p;
+        interpolant_[1] = &interpolant_nu_n;
     }else{
         log_fatal("Weak interaction: Particle to propagate is not a charged lepton");
     }
@@ -91,23 +96,12 @@ WeakCooperSarkarMertsch::WeakCooperSarkarMertsch(const ParticleDef& particle_def
 
 WeakCooperSarkarMertsch::WeakCooperSarkarMertsch(const WeakCooperSarkarMertsch& param)
         : WeakInteraction(param)
-        , interpolant_()
+        , interpolant_(param.interpolant_)
 {
-    interpolant_.resize(param.interpolant_.size());
-
-    for (unsigned int i = 0; i < param.interpolant_.size(); ++i)
-    {
-        interpolant_[i] = new Interpolant(*param.interpolant_[i]);
-    }
 }
 
 WeakCooperSarkarMertsch::~WeakCooperSarkarMertsch()
 {
-    for (std::vector<Interpolant*>::const_iterator iter = interpolant_.begin(); iter != interpolant_.end(); ++iter)
-    {
-        delete *iter;
-    }
-
     interpolant_.clear();
 }
 
@@ -120,7 +114,7 @@ bool WeakCooperSarkarMertsch::compare(const Parametrization& parametrization) co
 
     for (unsigned int i = 0; i < interpolant_.size(); ++i)
     {
-        if (*interpolant_[i] != *weak->interpolant_[i])
+        if (interpolant_[i] != weak->interpolant_[i] && *interpolant_[i] != *weak->interpolant_[i])
             return false;
     }
 
@@ -129,8 +123,8 @@ bool WeakCooperSarkarMertsch::compare(const Parametrization& parametrization) co
 
 double WeakCooperSarkarMertsch::DifferentialCrossSection(double energy, double v)
 {
-    double proton_contribution = components_[component_index_]->GetNucCharge() * interpolant_.at(0)->InterpolateArray(std::log10(energy), v);
-    double neutron_contribution =  (components_[component_index_]->GetAtomicNum() - components_[component_index_]->GetNucCharge()) * interpolant_.at(1)->InterpolateArray(std::log10(energy), v);
+    double proton_contribution = components_[component_index_]->GetNucCharge() * interpolant_.at(0)->Interpolate(std::log10(energy), v);
+    double neutron_contribution =  (components_[component_index_]->GetAtomicNum() - components_[component_index_]->GetNucCharge()) * interpolant_.at(1)->Interpolate(std::log10(energy), v);
     double mean_contribution = (proton_contribution + neutron_contribution) / (components_[component_index_]->GetAtomicNum());
 
     return medium_->GetMolDensity() * components_[component_index_]->GetAtomInMolecule() * 1e-36 * std::max(0.0, mean_contribution); //factor 1e-36: conversion from pb to cm^2
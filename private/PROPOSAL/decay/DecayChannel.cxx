@@ -62,7 +62,6 @@ void DecayChannel::Boost(Particle& particle, const Vector3D& direction_unnormali
     particle.SetMomentum(momentum_vec.magnitude());
 
     momentum_vec.normalise();
-    momentum_vec.CalculateSphericalCoordinates();
     particle.SetDirection(momentum_vec);
 }
 
@@ -97,8 +96,6 @@ Vector3D DecayChannel::GenerateRandomDirection()
     double cos_theta = 2.0 * RandomGenerator::Get().RandomDouble() - 1.0;
     double sin_theta = std::sqrt((1.0 - cos_theta) * (1.0 + cos_theta));
     Vector3D direction = Vector3D(sin_theta * std::sin(phi), sin_theta * std::cos(phi), cos_theta);
-    direction.CalculateSphericalCoordinates();
-    // direction.SetSphericalCoordinates(1.0, phi, std::acos(cos_theta));
     return direction;
 }
 
@@ -138,7 +138,6 @@ DecayChannel::DecayProducts LeptonicDecayChannelApprox::Decay(const Particle& pa
     products[1]->SetMomentum(momentum_neutrinos);
 
     Vector3D opposite_direction = -direction;
-    opposite_direction.CalculateSphericalCoordinates();
     products[2]->SetDirection(opposite_direction);
     products[2]->SetMomentum(momentum_neutrinos);
 
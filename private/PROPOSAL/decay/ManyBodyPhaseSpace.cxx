@@ -172,7 +172,6 @@ double ManyBodyPhaseSpace::GenerateEvent(DecayProducts& products, const PhaseSpa
     products[1]->SetMomentum(kinematics.momenta[0]);
 
     Vector3D opposite_direction = -direction;
-    opposite_direction.CalculateSphericalCoordinates();
     products[0]->SetDirection(opposite_direction);
     products[0]->SetMomentum(kinematics.momenta[0]);
 
@@ -50,7 +50,6 @@ DecayChannel::DecayProducts TwoBodyPhaseSpace::Decay(const Particle& particle)
     products[0]->SetMomentum(momentum);
 
     Vector3D opposite_direction = -direction;
-    opposite_direction.CalculateSphericalCoordinates();
     products[1]->SetDirection(opposite_direction);
     products[1]->SetMomentum(momentum);
 
@@ -0,0 +1,257 @@
+
+#include <algorithm>
+#include <limits>
+
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
+
+using namespace PROPOSAL;
+
+namespace {
+
+// Largest number of boxes in a leaf
+const size_t LEAF_SIZE = 4;
+
+} // namespace
+
+/******************************************************************************
+ *                               BoundingBox                                  *
+ ******************************************************************************/
+
+BoundingBox::BoundingBox()
+{
+    // Empty box, which is enlarged by Extend
+    for (int i = 0; i < 3; ++i)
+    {
+        min[i] = std::numeric_limits<double>::max();
+        max[i] = -std::numeric_limits<double>::max();
+    }
+}
+
+BoundingBox::BoundingBox(const Vector3D& min_corner, const Vector3D& max_corner)
+{
+    min[0] = min_corner.GetX();
+    min[1] = min_corner.GetY();
+    min[2] = min_corner.GetZ();
+    max[0] = max_corner.GetX();
+    max[1] = max_corner.GetY();
+    max[2] = max_corner.GetZ();
+}
+
+bool BoundingBox::operator==(const BoundingBox& box) const
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        if (min[i] != box.min[i] || max[i] != box.max[i])
+            return false;
+    }
+    return true;
+}
+
+bool BoundingBox::operator!=(const BoundingBox& box) const
+{
+    return !(*this == box);
+}
+
+// ------------------------------------------------------------------------- //
+void BoundingBox::Extend(const BoundingBox& box)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        min[i] = std::min(min[i], box.min[i]);
+        max[i] = std::max(max[i], box.max[i]);
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void BoundingBox::Pad(double distance)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        min[i] -= distance;
+        max[i] += distance;
+    }
+}
+
+// ------------------------------------------------------------------------- //
+bool BoundingBox::Contains(const Vector3D& position) const
+{
+    double coordinates[3] = { position.GetX(), position.GetY(), position.GetZ() };
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if (coordinates[i] < min[i] || coordinates[i] > max[i])
+            return false;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------- //
+double BoundingBox::DistanceToEntry(const Vector3D& position, const Vector3D& direction) const
+{
+    double coordinates[3] = { position.GetX(), position.GetY(), position.GetZ() };
+    double components[3]  = { direction.GetX(), direction.GetY(), direction.GetZ() };
+
+    // Slab method: the ray is inside the box between the largest entry and
+    // the smallest exit of the three slabs
+    double entry = 0;
+    double exit  = std::numeric_limits<double>::infinity();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        if (components[i] == 0)
+        {
+            if (coordinates[i] < min[i] || coordinates[i] > max[i])
+                return -1;
+            continue;
+        }
+
+        double t_1 = (min[i] - coordinates[i]) / components[i];
+        double t_2 = (max[i] - coordinates[i]) / components[i];
+
+        if (t_1 > t_2)
+            std::swap(t_1, t_2);
+
+        entry = std::max(entry, t_1);
+        exit  = std::min(exit, t_2);
+
+        if (entry > exit)
+            return -1;
+    }
+
+    return entry;
+}
+
+/******************************************************************************
+ *                          BoundingVolumeHierarchy                           *
+ ******************************************************************************/
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+    : boxes_()
+    , nodes_()
+    , indices_()
+{
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const std::vector<BoundingBox>& boxes)
+    : boxes_(boxes)
+    , nodes_()
+    , indices_(boxes.size())
+{
+    if (boxes.empty())
+        return;
+
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        indices_[i] = i;
+    }
+
+    nodes_.reserve(2 * boxes.size());
+    nodes_.resize(1);
+
+    Build(boxes, 0, 0, boxes.size());
+}
+
+// ------------------------------------------------------------------------- //
+void BoundingVolumeHierarchy::Build(const std::vector<BoundingBox>& boxes, size_t node, size_t first, size_t count)
+{
+    BoundingBox box;
+    BoundingBox centers;
+
+    for (size_t i = first; i < first + count; ++i)
+    {
+        const BoundingBox& child = boxes[indices_[i]];
+        box.Extend(child);
+
+        BoundingBox center;
+        for (int k = 0; k < 3; ++k)
+        {
+            center.min[k] = center.max[k] = 0.5 * (child.min[k] + child.max[k]);
+        }
+        centers.Extend(center);
+    }
+
+    nodes_[node].box   = box;
+    nodes_[node].left  = 0;
+    nodes_[node].first = first;
+    nodes_[node].count = count;
+
+    if (count <= LEAF_SIZE)
+        return;
+
+    // Split along the axis with the largest spread of the centers. Boxes
+    // with the same center, like shells of a layered geometry, are sorted
+    // by their size instead.
+    int axis       = 0;
+    bool by_size   = false;
+    double largest = -1;
+    for (int k = 0; k < 3; ++k)
+    {
+        if (centers.max[k] - centers.min[k] > largest)
+        {
+            largest = centers.max[k] - centers.min[k];
+            axis    = k;
+        }
+    }
+
+    if (largest <= 0)
+    {
+        by_size = true;
+    }
+
+    size_t middle = first + count / 2;
+
+    std::nth_element(indices_.begin() + first,
+                     indices_.begin() + middle,
+                     indices_.begin() + first + count,
+                     [&](size_t a, size_t b) {
+                         if (by_size)
+                             return boxes[a].max[axis] - boxes[a].min[axis] < boxes[b].max[axis] - boxes[b].min[axis];
+                         return boxes[a].min[axis] + boxes[a].max[axis] < boxes[b].min[axis] + boxes[b].max[axis];
+                     });
+
+    size_t left = nodes_.size();
+    nodes_.resize(left + 2);
+
+    nodes_[node].left  = left;
+    nodes_[node].count = 0;
+
+    Build(boxes, left, first, middle - first);
+    Build(boxes, left + 1, middle, first + count - middle);
+}
+
+// ------------------------------------------------------------------------- //
+void BoundingVolumeHierarchy::FindContaining(const Vector3D& position, std::vector<size_t>& indices) const
+{
+    indices.clear();
+
+    if (nodes_.empty())
+        return;
+
+    size_t stack[64];
+    size_t size = 0;
+
+    stack[size++] = 0;
+
+    while (size > 0)
+    {
+        const Node& node = nodes_[stack[--size]];
+
+        if (!node.box.Contains(position))
+            continue;
+
+        if (node.count > 0)
+        {
+            for (size_t i = node.first; i < node.first + node.count; ++i)
+            {
+                if (boxes_[indices_[i]].Contains(position))
+                    indices.push_back(indices_[i]);
+            }
+        } else
+        {
+            stack[size++] = node.left;
+            stack[size++] = node.left + 1;
+        }
+    }
+
+    std::sort(indices.begin(), indices.end());
+}
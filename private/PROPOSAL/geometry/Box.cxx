@@ -5,6 +5,7 @@
 #include "PROPOSAL/Constants.h"
 #include "PROPOSAL/Logging.h"
 #include "PROPOSAL/geometry/Box.h"
+#include "PROPOSAL/geometry/GeometryKernels.h"
 
 using namespace PROPOSAL;
 
@@ -93,6 +94,14 @@ void Box::print(std::ostream& os) const
     os << "Width_x: " << x_ << "\tWidth_y " << y_ << "\tHeight: " << z_ << '\n';
 }
 
+// ------------------------------------------------------------------------- //
+BoundingBox Box::GetBoundingBox() const
+{
+    Vector3D half(0.5 * x_, 0.5 * y_, 0.5 * z_);
+
+    return BoundingBox(position_ - half, position_ + half);
+}
+
 // ------------------------------------------------------------------------- //
 std::pair<double, double> Box::DistanceToBorder(const Vector3D& position, const Vector3D& direction)
 {
@@ -106,201 +115,16 @@ std::pair<double, double> Box::DistanceToBorder(const Vector3D& position, const
     // E6: x3   =   position.GetZ() - 0.5*z
     // straight line (particle trajectory) g = vec(x,y,z) + t * dir_vec( cosph
     // *sinth, sinph *sinth , costh)
-    // We are only interested in postive values of t
-    // ( we want to find the intersection in direction of the particle
-    // trajectory)
+    // The trajectory is inside, where it is between all three pairs of
+    // planes. See GeometryKernels for the handling of the border cases.
 
-    double dir_vec_x = direction.GetX();
-    double dir_vec_y = direction.GetY();
-    double dir_vec_z = direction.GetZ();
+    const double center[3]     = { position_.GetX(), position_.GetY(), position_.GetZ() };
+    const double half_width[3] = { 0.5 * x_, 0.5 * y_, 0.5 * z_ };
+    const double pos[3]        = { position.GetX(), position.GetY(), position.GetZ() };
+    const double dir[3]        = { direction.GetX(), direction.GetY(), direction.GetZ() };
 
     std::pair<double, double> distance;
-    double t;
-    double intersection_x;
-    double intersection_y;
-    double intersection_z;
-
-    std::vector<double> dist;
-
-    double x_calc_pos = position_.GetX() + 0.5 * x_;
-    double x_calc_neg = position_.GetX() - 0.5 * x_;
-    double y_calc_pos = position_.GetY() + 0.5 * y_;
-    double y_calc_neg = position_.GetY() - 0.5 * y_;
-    double z_calc_pos = position_.GetZ() + 0.5 * z_;
-    double z_calc_neg = position_.GetZ() - 0.5 * z_;
-
-    // intersection with E1
-    if (dir_vec_x != 0) // if dir_vec == 0 particle trajectory is parallel to E1
-    {
-        t = (x_calc_pos - position.GetX()) / dir_vec_x;
-
-        // Computer precision controll
-        if (t > 0 && t < GEOMETRY_PRECISION)
-            t = 0;
-
-        if (t > 0) // Interection is in particle trajectory direction
-        {
-            // Check if intersection is inside the box borders
-            intersection_y = position.GetY() + t * dir_vec_y;
-            intersection_z = position.GetZ() + t * dir_vec_z;
-            if (intersection_y >= y_calc_neg && intersection_y <= y_calc_pos && intersection_z >= z_calc_neg &&
-                intersection_z <= z_calc_pos)
-            {
-                dist.push_back(t);
-            }
-        }
-    }
-
-    // intersection with E2
-    if (dir_vec_x != 0) // if dir_vec == 0 particle trajectory is parallel to E2
-    {
-        t = (x_calc_neg - position.GetX()) / dir_vec_x;
-
-        // Computer precision controll
-        if (t > 0 && t < GEOMETRY_PRECISION)
-            t = 0;
-
-        if (t > 0) // Interection is in particle trajectory direction
-        {
-            // Check if intersection is inside the box borders
-            intersection_y = position.GetY() + t * dir_vec_y;
-            intersection_z = position.GetZ() + t * dir_vec_z;
-            if (intersection_y >= y_calc_neg && intersection_y <= y_calc_pos && intersection_z >= z_calc_neg &&
-                intersection_z <= z_calc_pos)
-            {
-                dist.push_back(t);
-            }
-        }
-    }
-
-    // intersection with E3
-    if (dir_vec_y != 0) // if dir_vec == 0 particle trajectory is parallel to E3
-    {
-        t = (y_calc_pos - position.GetY()) / dir_vec_y;
-
-        // Computer precision controll
-        if (t > 0 && t < GEOMETRY_PRECISION)
-            t = 0;
-
-        if (t > 0) // Interection is in particle trajectory direction
-        {
-            // Check if intersection is inside the box borders
-            intersection_x = position.GetX() + t * dir_vec_x;
-            intersection_z = position.GetZ() + t * dir_vec_z;
-            if (intersection_x >= x_calc_neg && intersection_x <= x_calc_pos && intersection_z >= z_calc_neg &&
-                intersection_z <= z_calc_pos)
-            {
-                dist.push_back(t);
-            }
-        }
-    }
-
-    // intersection with E4
-    if (dir_vec_y != 0) // if dir_vec == 0 particle trajectory is parallel to E4
-    {
-        t = (y_calc_neg - position.GetY()) / dir_vec_y;
-
-        // Computer precision controll
-        if (t > 0 && t < GEOMETRY_PRECISION)
-            t = 0;
-
-        if (t > 0) // Interection is in particle trajectory direction
-        {
-            // Check if intersection is inside the box borders
-            intersection_x = position.GetX() + t * dir_vec_x;
-            intersection_z = position.GetZ() + t * dir_vec_z;
-            if (intersection_x >= x_calc_neg && intersection_x <= x_calc_pos && intersection_z >= z_calc_neg &&
-                intersection_z <= z_calc_pos)
-            {
-                dist.push_back(t);
-            }
-        }
-    }
-
-    // intersection with E5
-    if (dir_vec_z != 0) // if dir_vec == 0 particle trajectory is parallel to E5
-    {
-        t = (z_calc_pos - position.GetZ()) / dir_vec_z;
-
-        // Computer precision controll
-        if (t > 0 && t < GEOMETRY_PRECISION)
-            t = 0;
-
-        if (t > 0) // Interection is in particle trajectory direction
-        {
-            // Check if intersection is inside the box borders
-            intersection_x = position.GetX() + t * dir_vec_x;
-            intersection_y = position.GetY() + t * dir_vec_y;
-            if (intersection_x >= x_calc_neg && intersection_x <= x_calc_pos && intersection_y >= y_calc_neg &&
-                intersection_y <= y_calc_pos)
-            {
-                dist.push_back(t);
-            }
-        }
-    }
-
-    // intersection with E6
-    if (dir_vec_z != 0) // if dir_vec == 0 particle trajectory is parallel to E6
-    {
-        t = (z_calc_neg - position.GetZ()) / dir_vec_z;
-
-        // Computer precision controll
-        if (t > 0 && t < GEOMETRY_PRECISION)
-            t = 0;
-
-        if (t > 0) // Interection is in particle trajectory direction
-        {
-            // Check if intersection is inside the box borders
-            intersection_x = position.GetX() + t * dir_vec_x;
-            intersection_y = position.GetY() + t * dir_vec_y;
-            if (intersection_x >= x_calc_neg && intersection_x <= x_calc_pos && intersection_y >= y_calc_neg &&
-                intersection_y <= y_calc_pos)
-            {
-                dist.push_back(t);
-            }
-        }
-    }
-
-    if (dist.size() < 1) // No intersection with the box
-    {
-        distance.first  = -1;
-        distance.second = -1;
-    } else if (dist.size() == 1) // Particle is inside the box and we have one
-                                 // intersection in direction of the particle
-                                 // trajectory
-    {
-        distance.first  = dist.at(0);
-        distance.second = -1;
-    } else if (dist.size() == 2) // Particle is outside and the box is infront
-                                 // of the particle trajectory ( two
-                                 // intersections).
-    {
-        distance.first  = dist.at(0);
-        distance.second = dist.at(1);
-        if (distance.second < distance.first)
-        {
-            std::swap(distance.first, distance.second);
-        }
-
-    } else
-    {
-        log_error("This point should nerver be reached... (-1/-1) is returned");
-
-        distance.first  = -1;
-        distance.second = -1;
-    }
-
-    // Make a computer precision controll!
-    // This is necessary cause due to numerical effects it meight be happen
-    // that a particle which is located on a gemoetry border is treated as
-    // inside
-    // or outside
-    if (distance.first < GEOMETRY_PRECISION)
-        distance.first = -1;
-    if (distance.second < GEOMETRY_PRECISION)
-        distance.second = -1;
-    if (distance.first < 0)
-        std::swap(distance.first, distance.second);
+    GeometryKernels::BoxDistance(center, half_width, pos, dir, distance.first, distance.second);
 
     return distance;
 }
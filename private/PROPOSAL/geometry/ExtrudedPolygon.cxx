@@ -0,0 +1,263 @@
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/Logging.h"
+#include "PROPOSAL/geometry/ExtrudedPolygon.h"
+#include "PROPOSAL/geometry/GeometryKernels.h"
+
+using namespace PROPOSAL;
+
+ExtrudedPolygon::ExtrudedPolygon()
+    : Geometry("ExtrudedPolygon")
+    , vertices_()
+    , height_(0.0)
+    , tree_()
+    , crossings_()
+{
+    // Do nothing here
+}
+
+ExtrudedPolygon::ExtrudedPolygon(const Vector3D position, const std::vector<Vector3D>& vertices, double height)
+    : Geometry("ExtrudedPolygon", position)
+    , vertices_()
+    , height_(100 * height)
+    , tree_()
+    , crossings_()
+{
+    std::vector<Vector3D> vertices_cm;
+    for (auto vertex : vertices)
+    {
+        vertices_cm.push_back(100 * vertex);
+    }
+
+    SetVertices(vertices_cm);
+}
+
+ExtrudedPolygon::ExtrudedPolygon(const ExtrudedPolygon& polygon)
+    : Geometry(polygon)
+    , vertices_(polygon.vertices_)
+    , height_(polygon.height_)
+    , tree_(polygon.tree_)
+    , crossings_()
+{
+    // Nothing to do here
+}
+
+// ------------------------------------------------------------------------- //
+void ExtrudedPolygon::swap(Geometry& geometry)
+{
+    ExtrudedPolygon* polygon = dynamic_cast<ExtrudedPolygon*>(&geometry);
+    if (!polygon)
+    {
+        log_warn("Cannot swap ExtrudedPolygon!");
+        return;
+    }
+
+    Geometry::swap(*polygon);
+
+    vertices_.swap(polygon->vertices_);
+    std::swap(height_, polygon->height_);
+    std::swap(tree_, polygon->tree_);
+}
+
+//------------------------------------------------------------------------- //
+ExtrudedPolygon& ExtrudedPolygon::operator=(const Geometry& geometry)
+{
+    if (this != &geometry)
+    {
+        const ExtrudedPolygon* polygon = dynamic_cast<const ExtrudedPolygon*>(&geometry);
+        if (!polygon)
+        {
+            log_warn("Cannot assign ExtrudedPolygon!");
+            return *this;
+        }
+
+        ExtrudedPolygon tmp(*polygon);
+        swap(tmp);
+    }
+    return *this;
+}
+
+// ------------------------------------------------------------------------- //
+bool ExtrudedPolygon::compare(const Geometry& geometry) const
+{
+    const ExtrudedPolygon* polygon = dynamic_cast<const ExtrudedPolygon*>(&geometry);
+
+    if (!polygon)
+        return false;
+    else if (vertices_ != polygon->vertices_)
+        return false;
+    else if (height_ != polygon->height_)
+        return false;
+    else
+        return true;
+}
+
+// ------------------------------------------------------------------------- //
+void ExtrudedPolygon::print(std::ostream& os) const
+{
+    os << "Vertices: " << vertices_.size() << "\tHeight: " << height_ << '\n';
+}
+
+// ------------------------------------------------------------------------- //
+void ExtrudedPolygon::SetVertices(const std::vector<Vector3D>& vertices)
+{
+    if (vertices.size() < 3)
+    {
+        log_fatal("A polygon needs at least three vertices, but %zu are given!", vertices.size());
+    }
+
+    vertices_.clear();
+    for (auto vertex : vertices)
+    {
+        vertices_.push_back(Vector3D(vertex.GetX(), vertex.GetY(), 0));
+    }
+
+    // The boxes of the edges are flat in z, so the projected trajectory
+    // passes them at z = 0
+    std::vector<BoundingBox> boxes;
+
+    for (size_t i = 0; i < vertices_.size(); ++i)
+    {
+        const Vector3D& start = vertices_[i];
+        const Vector3D& end   = vertices_[(i + 1) % vertices_.size()];
+
+        BoundingBox box(start, start);
+        box.Extend(BoundingBox(end, end));
+        box.Pad(GEOMETRY_PRECISION);
+
+        boxes.push_back(box);
+    }
+
+    tree_ = BoundingVolumeHierarchy(boxes);
+}
+
+// ------------------------------------------------------------------------- //
+BoundingBox ExtrudedPolygon::GetBoundingBox() const
+{
+    BoundingBox box;
+
+    for (auto vertex : vertices_)
+    {
+        box.Extend(BoundingBox(position_ + vertex, position_ + vertex));
+    }
+
+    box.min[2] = position_.GetZ() - 0.5 * height_;
+    box.max[2] = position_.GetZ() + 0.5 * height_;
+
+    return box;
+}
+
+// ------------------------------------------------------------------------- //
+void ExtrudedPolygon::CrossPolygon(double x, double y, double direction_x, double direction_y, bool& inside)
+{
+    // An edge is crossed, if its corners are on different sides of the
+    // trajectory. A corner on the trajectory counts to one side, so a
+    // trajectory through a corner crosses either both or none of its edges.
+
+    crossings_.clear();
+
+    size_t size = vertices_.size();
+
+    auto visit = [&](size_t index) {
+        const Vector3D& start = vertices_[index];
+        const Vector3D& end   = vertices_[(index + 1) % size];
+
+        double side_start = direction_x * (start.GetY() - y) - direction_y * (start.GetX() - x);
+        double side_end   = direction_x * (end.GetY() - y) - direction_y * (end.GetX() - x);
+
+        if ((side_start > 0) == (side_end > 0))
+            return;
+
+        double fraction   = side_start / (side_start - side_end);
+        double crossing_x = start.GetX() + fraction * (end.GetX() - start.GetX());
+        double crossing_y = start.GetY() + fraction * (end.GetY() - start.GetY());
+
+        double t = (crossing_x - x) * direction_x + (crossing_y - y) * direction_y;
+
+        if (t > 0)
+            crossings_.push_back(t);
+    };
+
+    double max_distance = std::numeric_limits<double>::infinity();
+    tree_.Traverse(Vector3D(x, y, 0), Vector3D(direction_x, direction_y, 0), max_distance, visit);
+
+    std::sort(crossings_.begin(), crossings_.end());
+
+    // A closed polygon is left once more than entered
+    inside = crossings_.size() % 2 == 1;
+}
+
+// ------------------------------------------------------------------------- //
+std::pair<double, double> ExtrudedPolygon::DistanceToBorder(const Vector3D& position, const Vector3D& direction)
+{
+    // The trajectory is inside, where its projection is inside of the
+    // polygon and it is between the bottom and the top surface.
+
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    double x = position.GetX() - position_.GetX();
+    double y = position.GetY() - position_.GetY();
+
+    double slab_enter, slab_exit;
+    GeometryKernels::SlabInterval(position_.GetZ() - 0.5 * height_,
+                                  position_.GetZ() + 0.5 * height_,
+                                  position.GetZ(),
+                                  direction.GetZ(),
+                                  slab_enter,
+                                  slab_exit);
+
+    std::pair<double, double> distance(-1, -1);
+
+    if (vertices_.empty())
+        return distance;
+
+    double projection = std::sqrt(direction.GetX() * direction.GetX() + direction.GetY() * direction.GetY());
+
+    bool inside;
+
+    // A trajectory along z stays inside or outside of the polygon
+    if (projection == 0)
+    {
+        CrossPolygon(x, y, 1, 0, inside);
+
+        if (inside)
+            GeometryKernels::ShellDistance(
+                slab_enter, slab_exit, infinity, infinity, distance.first, distance.second);
+
+        return distance;
+    }
+
+    CrossPolygon(x, y, direction.GetX() / projection, direction.GetY() / projection, inside);
+
+    double enter = -infinity;
+
+    for (auto crossing : crossings_)
+    {
+        // Distance along the trajectory instead of its projection
+        crossing /= projection;
+
+        if (inside)
+        {
+            GeometryKernels::ShellDistance(std::max(enter, slab_enter),
+                                           std::min(crossing, slab_exit),
+                                           infinity,
+                                           infinity,
+                                           distance.first,
+                                           distance.second);
+
+            if (distance.first > 0)
+                return distance;
+        } else
+        {
+            enter = crossing;
+        }
+
+        inside = !inside;
+    }
+
+    return std::make_pair(-1., -1.);
+}
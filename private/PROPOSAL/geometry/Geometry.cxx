@@ -42,6 +42,15 @@ std::ostream& operator<<(std::ostream& os, Geometry const& geometry)
  *                                  Geometry                                   *
  ******************************************************************************/
 
+Geometry::Intersection::Intersection()
+    : distance(-1, -1)
+    , location(Geometry::ParticleLocation::BehindGeometry)
+    , closest_approach(0)
+{
+}
+
+// ------------------------------------------------------------------------- //
+
 Geometry::Geometry(const std::string name)
     : position_(Vector3D())
     , name_(name)
@@ -149,12 +158,7 @@ bool Geometry::IsBehind(const Vector3D& position, const Vector3D& direction)
 }
 
 Geometry::ParticleLocation::Enum Geometry::GetLocation(const Vector3D& position, const Vector3D& direction) {
-    if(IsInfront(position, direction))
-        return Geometry::ParticleLocation::InfrontGeometry;
-    if(IsInside(position, direction))
-        return Geometry::ParticleLocation::InsideGeometry;
-    else
-        return Geometry::ParticleLocation::BehindGeometry;
+    return Intersect(position, direction).location;
 }
 
 // ------------------------------------------------------------------------- //
@@ -162,3 +166,23 @@ double Geometry::DistanceToClosestApproach(const Vector3D& position, const Vecto
 {
     return scalar_product(position_ - position, direction);
 }
+
+// ------------------------------------------------------------------------- //
+Geometry::Intersection Geometry::Intersect(const Vector3D& position, const Vector3D& direction)
+{
+    Intersection intersection;
+
+    intersection.distance = DistanceToBorder(position, direction);
+
+    // Same conditions as IsInfront and IsInside
+    if (intersection.distance.first > 0 && intersection.distance.second > 0)
+        intersection.location = ParticleLocation::InfrontGeometry;
+    else if (intersection.distance.first > 0 && intersection.distance.second < 0)
+        intersection.location = ParticleLocation::InsideGeometry;
+    else
+        intersection.location = ParticleLocation::BehindGeometry;
+
+    intersection.closest_approach = scalar_product(position_ - position, direction);
+
+    return intersection;
+}
@@ -4,8 +4,10 @@
 #include "PROPOSAL/Logging.h"
 #include "PROPOSAL/geometry/Box.h"
 #include "PROPOSAL/geometry/Cylinder.h"
+#include "PROPOSAL/geometry/ExtrudedPolygon.h"
 #include "PROPOSAL/geometry/GeometryFactory.h"
 #include "PROPOSAL/geometry/Sphere.h"
+#include "PROPOSAL/geometry/TriangleMesh.h"
 
 using namespace PROPOSAL;
 
@@ -14,6 +16,8 @@ GeometryFactory::GeometryFactory()
     Register("sphere", Sphere, &Sphere::create);
     Register("box", Box, &Box::create);
     Register("cylinder", Cylinder, &Cylinder::create);
+    Register("extrudedpolygon", ExtrudedPolygon, &ExtrudedPolygon::create);
+    Register("trianglemesh", TriangleMesh, &TriangleMesh::create);
 }
 
 GeometryFactory::~GeometryFactory()
@@ -81,6 +85,15 @@ Geometry* GeometryFactory::CreateGeometry(const Definition& def)
         cylinder->SetPosition(def.position);
         cylinder->SetRadius(def.radius);
         cylinder->SetInnerRadius(def.inner_radius);
+    } else if (PROPOSAL::ExtrudedPolygon* polygon = dynamic_cast<PROPOSAL::ExtrudedPolygon*>(geometry))
+    {
+        polygon->SetPosition(def.position);
+        polygon->SetVertices(def.vertices);
+        polygon->SetHeight(def.height);
+    } else if (PROPOSAL::TriangleMesh* mesh = dynamic_cast<PROPOSAL::TriangleMesh*>(geometry))
+    {
+        mesh->SetPosition(def.position);
+        mesh->SetMesh(def.vertices, def.triangles);
     } else
     {
         log_fatal("Geometry %s not registerd!", typeid(geometry).name());
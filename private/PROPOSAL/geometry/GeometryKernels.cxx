@@ -0,0 +1,146 @@
+
+#include "PROPOSAL/geometry/Box.h"
+#include "PROPOSAL/geometry/Cylinder.h"
+#include "PROPOSAL/geometry/GeometryKernels.h"
+#include "PROPOSAL/geometry/Sphere.h"
+
+using namespace PROPOSAL;
+using namespace PROPOSAL::GeometryKernels;
+
+/******************************************************************************
+ *                                SphereArray                                 *
+ ******************************************************************************/
+
+void SphereArray::Add(const Sphere& sphere)
+{
+    x.push_back(sphere.GetPosition().GetX());
+    y.push_back(sphere.GetPosition().GetY());
+    z.push_back(sphere.GetPosition().GetZ());
+    radius.push_back(sphere.GetRadius());
+    inner_radius.push_back(sphere.GetInnerRadius());
+}
+
+void SphereArray::Clear()
+{
+    x.clear();
+    y.clear();
+    z.clear();
+    radius.clear();
+    inner_radius.clear();
+}
+
+/******************************************************************************
+ *                                  BoxArray                                  *
+ ******************************************************************************/
+
+void BoxArray::Add(const Box& box)
+{
+    x.push_back(box.GetPosition().GetX());
+    y.push_back(box.GetPosition().GetY());
+    z.push_back(box.GetPosition().GetZ());
+    half_x.push_back(0.5 * box.GetX());
+    half_y.push_back(0.5 * box.GetY());
+    half_z.push_back(0.5 * box.GetZ());
+}
+
+void BoxArray::Clear()
+{
+    x.clear();
+    y.clear();
+    z.clear();
+    half_x.clear();
+    half_y.clear();
+    half_z.clear();
+}
+
+/******************************************************************************
+ *                               CylinderArray                                *
+ ******************************************************************************/
+
+void CylinderArray::Add(const Cylinder& cylinder)
+{
+    x.push_back(cylinder.GetPosition().GetX());
+    y.push_back(cylinder.GetPosition().GetY());
+    z.push_back(cylinder.GetPosition().GetZ());
+    radius.push_back(cylinder.GetRadius());
+    inner_radius.push_back(cylinder.GetInnerRadius());
+    half_height.push_back(0.5 * cylinder.GetZ());
+}
+
+void CylinderArray::Clear()
+{
+    x.clear();
+    y.clear();
+    z.clear();
+    radius.clear();
+    inner_radius.clear();
+    half_height.clear();
+}
+
+/******************************************************************************
+ *                              Batched kernels                               *
+ ******************************************************************************/
+
+void GeometryKernels::DistanceToBorder(const SphereArray& spheres,
+                                       const Vector3D& position,
+                                       const Vector3D& direction,
+                                       double* first,
+                                       double* second)
+{
+    const double pos[3] = { position.GetX(), position.GetY(), position.GetZ() };
+    const double dir[3] = { direction.GetX(), direction.GetY(), direction.GetZ() };
+
+    size_t size = spheres.GetSize();
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        const double center[3] = { spheres.x[i], spheres.y[i], spheres.z[i] };
+        SphereDistance(center, spheres.radius[i], spheres.inner_radius[i], pos, dir, first[i], second[i]);
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void GeometryKernels::DistanceToBorder(const BoxArray& boxes,
+                                       const Vector3D& position,
+                                       const Vector3D& direction,
+                                       double* first,
+                                       double* second)
+{
+    const double pos[3] = { position.GetX(), position.GetY(), position.GetZ() };
+    const double dir[3] = { direction.GetX(), direction.GetY(), direction.GetZ() };
+
+    size_t size = boxes.GetSize();
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        const double center[3]     = { boxes.x[i], boxes.y[i], boxes.z[i] };
+        const double half_width[3] = { boxes.half_x[i], boxes.half_y[i], boxes.half_z[i] };
+        BoxDistance(center, half_width, pos, dir, first[i], second[i]);
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void GeometryKernels::DistanceToBorder(const CylinderArray& cylinders,
+                                       const Vector3D& position,
+                                       const Vector3D& direction,
+                                       double* first,
+                                       double* second)
+{
+    const double pos[3] = { position.GetX(), position.GetY(), position.GetZ() };
+    const double dir[3] = { direction.GetX(), direction.GetY(), direction.GetZ() };
+
+    size_t size = cylinders.GetSize();
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        const double center[3] = { cylinders.x[i], cylinders.y[i], cylinders.z[i] };
+        CylinderDistance(center,
+                         cylinders.radius[i],
+                         cylinders.inner_radius[i],
+                         cylinders.half_height[i],
+                         pos,
+                         dir,
+                         first[i],
+                         second[i]);
+    }
+}
@@ -0,0 +1,264 @@
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/Logging.h"
+#include "PROPOSAL/geometry/GeometryKernels.h"
+#include "PROPOSAL/geometry/TriangleMesh.h"
+
+using namespace PROPOSAL;
+
+TriangleMesh::TriangleMesh()
+    : Geometry("TriangleMesh")
+    , vertices_()
+    , triangles_()
+    , tree_()
+    , crossings_()
+{
+    // Do nothing here
+}
+
+TriangleMesh::TriangleMesh(const Vector3D position,
+                           const std::vector<Vector3D>& vertices,
+                           const std::vector<Triangle>& triangles)
+    : Geometry("TriangleMesh", position)
+    , vertices_()
+    , triangles_()
+    , tree_()
+    , crossings_()
+{
+    std::vector<Vector3D> vertices_cm;
+    for (auto vertex : vertices)
+    {
+        vertices_cm.push_back(100 * vertex);
+    }
+
+    SetMesh(vertices_cm, triangles);
+}
+
+TriangleMesh::TriangleMesh(const TriangleMesh& mesh)
+    : Geometry(mesh)
+    , vertices_(mesh.vertices_)
+    , triangles_(mesh.triangles_)
+    , tree_(mesh.tree_)
+    , crossings_()
+{
+    // Nothing to do here
+}
+
+// ------------------------------------------------------------------------- //
+void TriangleMesh::swap(Geometry& geometry)
+{
+    TriangleMesh* mesh = dynamic_cast<TriangleMesh*>(&geometry);
+    if (!mesh)
+    {
+        log_warn("Cannot swap TriangleMesh!");
+        return;
+    }
+
+    Geometry::swap(*mesh);
+
+    vertices_.swap(mesh->vertices_);
+    triangles_.swap(mesh->triangles_);
+    std::swap(tree_, mesh->tree_);
+}
+
+//------------------------------------------------------------------------- //
+TriangleMesh& TriangleMesh::operator=(const Geometry& geometry)
+{
+    if (this != &geometry)
+    {
+        const TriangleMesh* mesh = dynamic_cast<const TriangleMesh*>(&geometry);
+        if (!mesh)
+        {
+            log_warn("Cannot assign TriangleMesh!");
+            return *this;
+        }
+
+        TriangleMesh tmp(*mesh);
+        swap(tmp);
+    }
+    return *this;
+}
+
+// ------------------------------------------------------------------------- //
+bool TriangleMesh::compare(const Geometry& geometry) const
+{
+    const TriangleMesh* mesh = dynamic_cast<const TriangleMesh*>(&geometry);
+
+    if (!mesh)
+        return false;
+    else if (vertices_ != mesh->vertices_)
+        return false;
+    else if (triangles_ != mesh->triangles_)
+        return false;
+    else
+        return true;
+}
+
+// ------------------------------------------------------------------------- //
+void TriangleMesh::print(std::ostream& os) const
+{
+    os << "Vertices: " << vertices_.size() << "\tTriangles: " << triangles_.size() << '\n';
+}
+
+// ------------------------------------------------------------------------- //
+void TriangleMesh::SetMesh(const std::vector<Vector3D>& vertices, const std::vector<Triangle>& triangles)
+{
+    vertices_  = vertices;
+    triangles_ = triangles;
+
+    // Every directed edge of a closed surface with a consistent orientation
+    // is used once, and once in the opposite direction
+    std::map<std::pair<unsigned int, unsigned int>, int> edges;
+    double volume = 0;
+
+    for (auto triangle : triangles_)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            if (triangle[i] >= vertices_.size())
+            {
+                log_fatal("The vertex %u of a triangle does not exist!", triangle[i]);
+            }
+
+            ++edges[std::make_pair(triangle[i], triangle[(i + 1) % 3])];
+        }
+
+        volume += vertices_[triangle[0]] * vector_product(vertices_[triangle[1]], vertices_[triangle[2]]);
+    }
+
+    for (auto edge : edges)
+    {
+        auto reverse = edges.find(std::make_pair(edge.first.second, edge.first.first));
+
+        if (edge.second != 1 || reverse == edges.end() || reverse->second != 1)
+        {
+            log_fatal("The triangles do not form a closed surface with a consistent orientation!");
+        }
+    }
+
+    // The normals point inwards for a negative volume
+    if (volume < 0)
+    {
+        for (auto& triangle : triangles_)
+        {
+            std::swap(triangle[1], triangle[2]);
+        }
+    }
+
+    std::vector<BoundingBox> boxes;
+
+    for (auto triangle : triangles_)
+    {
+        BoundingBox box;
+        for (int i = 0; i < 3; ++i)
+        {
+            box.Extend(BoundingBox(vertices_[triangle[i]], vertices_[triangle[i]]));
+        }
+
+        // Triangles in a coordinate plane have flat boxes
+        box.Pad(GEOMETRY_PRECISION);
+        boxes.push_back(box);
+    }
+
+    tree_ = BoundingVolumeHierarchy(boxes);
+}
+
+// ------------------------------------------------------------------------- //
+BoundingBox TriangleMesh::GetBoundingBox() const
+{
+    BoundingBox box;
+
+    for (auto vertex : vertices_)
+    {
+        box.Extend(BoundingBox(position_ + vertex, position_ + vertex));
+    }
+
+    return box;
+}
+
+// ------------------------------------------------------------------------- //
+std::pair<double, double> TriangleMesh::DistanceToBorder(const Vector3D& position, const Vector3D& direction)
+{
+    // The trajectory is intersected with the triangles of the leaves of the
+    // hierarchy it passes (Moeller-Trumbore). The normals point outwards, so
+    // the sign of the determinant tells, if the surface is entered or left.
+    // Crossings of edges are found in both triangles, but only the first
+    // entry and exit change the state.
+
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    Vector3D origin = position - position_;
+
+    crossings_.clear();
+
+    auto visit = [&](size_t index) {
+        const Triangle& triangle = triangles_[index];
+
+        const Vector3D& vertex = vertices_[triangle[0]];
+        Vector3D edge_1        = vertices_[triangle[1]] - vertex;
+        Vector3D edge_2        = vertices_[triangle[2]] - vertex;
+
+        Vector3D p_vector  = vector_product(direction, edge_2);
+        double determinant = edge_1 * p_vector;
+
+        if (determinant == 0)
+            return;
+
+        Vector3D t_vector = origin - vertex;
+        double u          = (t_vector * p_vector) / determinant;
+
+        if (u < 0 || u > 1)
+            return;
+
+        Vector3D q_vector = vector_product(t_vector, edge_1);
+        double v          = (direction * q_vector) / determinant;
+
+        if (v < 0 || u + v > 1)
+            return;
+
+        double t = (edge_2 * q_vector) / determinant;
+
+        // Crossings at the position decide on the border
+        if (t > -GEOMETRY_PRECISION)
+            crossings_.push_back(std::make_pair(t, determinant > 0 ? 1 : -1));
+    };
+
+    double max_distance = infinity;
+    tree_.Traverse(origin, direction, max_distance, visit);
+
+    std::sort(crossings_.begin(), crossings_.end());
+
+    std::pair<double, double> distance(-1, -1);
+
+    if (crossings_.empty())
+        return distance;
+
+    // Left first, so it starts inside
+    bool inside  = crossings_.front().second < 0;
+    double enter = -infinity;
+
+    for (auto crossing : crossings_)
+    {
+        if (crossing.second > 0 && !inside)
+        {
+            enter  = crossing.first;
+            inside = true;
+        } else if (crossing.second < 0 && inside)
+        {
+            GeometryKernels::ShellDistance(
+                enter, crossing.first, infinity, infinity, distance.first, distance.second);
+
+            if (distance.first > 0)
+                return distance;
+
+            inside = false;
+        }
+    }
+
+    return std::make_pair(-1., -1.);
+}
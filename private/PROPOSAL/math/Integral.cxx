@@ -102,6 +102,30 @@ double Integral::IntegrateWithRandomRatio(double min,
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 
+double Integral::IntegrateBatch(double min,
+                                double max,
+                                BatchIntegrand integrand,
+                                int method,
+                                double powerOfSubstitution)
+{
+    // single points are evaluated by the usual scalar path
+    std::function<double(double)> scalar_integrand = [integrand](double x) {
+        std::vector<double> point(1, x);
+        std::vector<double> value;
+        integrand(point, value);
+        return value[0];
+    };
+
+    batch_integrand_ = integrand;
+    double result    = Integrate(min, max, scalar_integrand, method, powerOfSubstitution);
+    batch_integrand_ = nullptr;
+
+    return result;
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
 double Integral::GetUpperLimit()
 {
 
@@ -638,6 +662,83 @@ double Integral::Function(double x)
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 
+void Integral::EvaluatePanel()
+{
+    size_t size = panel_x_.size();
+
+    if (!batch_integrand_)
+    {
+        panel_f_.resize(size);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            panel_f_[i] = Function(panel_x_[i]);
+        }
+        return;
+    }
+
+    panel_t_.resize(size);
+    panel_weight_.resize(size);
+
+    // same substitutions as in Function, applied to all points at once
+    for (size_t i = 0; i < size; ++i)
+    {
+        double x = panel_x_[i];
+        double t, weight;
+
+        if (reverse_)
+        {
+            x = reverseX_ - x;
+        }
+
+        if (powerOfSubstitution_ == 0)
+        {
+            t      = x;
+            weight = 1;
+        } else if (powerOfSubstitution_ > 0)
+        {
+            t      = std::pow(x, -powerOfSubstitution_);
+            weight = powerOfSubstitution_ * (t / x);
+        } else
+        {
+            t      = -std::pow(-x, powerOfSubstitution_);
+            weight = -powerOfSubstitution_ * (t / x);
+        }
+
+        if (useLog_)
+        {
+            t = std::exp(t);
+            weight *= t;
+        }
+
+        panel_t_[i]      = t;
+        panel_weight_[i] = weight;
+    }
+
+    batch_integrand_(panel_t_, panel_f_);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        double result = panel_weight_[i] * panel_f_[i];
+
+        if (result != result)
+        {
+            if (panel_f_[i] == 0)
+            {
+                log_info("substitution not suitable! returning 0!");
+                result = 0;
+            } else
+            {
+                log_fatal("result is nan! returning 0");
+            }
+        }
+        panel_f_[i] = result;
+    }
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
 double Integral::Trapezoid(int n, double oldSum)
 {
     double xStep, stepSize, resultSum;
@@ -651,9 +752,17 @@ double Integral::Trapezoid(int n, double oldSum)
     stepSize  = (max_ - min_) / n;
     resultSum = 0;
 
+    panel_x_.clear();
     for (xStep = min_ + stepSize / 2; xStep < max_; xStep += stepSize)
     {
-        resultSum += Function(xStep);
+        panel_x_.push_back(xStep);
+    }
+
+    EvaluatePanel();
+
+    for (size_t i = 0; i < panel_f_.size(); ++i)
+    {
+        resultSum += panel_f_[i];
     }
 
     return (oldSum + resultSum * stepSize) / 2;
@@ -674,11 +783,19 @@ double Integral::Trapezoid3(int n, double oldSum)
     stepSize  = (max_ - min_) / n;
     resultSum = 0;
 
+    panel_x_.clear();
     for (xStep = min_ + stepSize / 2; xStep < max_; xStep += stepSize)
     {
-        resultSum += Function(xStep);
+        panel_x_.push_back(xStep);
         xStep += 2 * stepSize;
-        resultSum += Function(xStep);
+        panel_x_.push_back(xStep);
+    }
+
+    EvaluatePanel();
+
+    for (size_t i = 0; i < panel_f_.size(); ++i)
+    {
+        resultSum += panel_f_[i];
     }
 
     return oldSum / 3 + resultSum * stepSize;
@@ -716,11 +833,22 @@ double Integral::Trapezoid3S(int n, double oldSum, int stepNumber)
     }
     resultSum = 0;
     flag      = false;
+
+    panel_x_.clear();
     for (xStep = min_ + stepSize / 2; xStep < max_; xStep += stepSize)
     {
-        resultSum += functionValue1 = Function(xStep);
+        panel_x_.push_back(xStep);
         xStep += 2 * stepSize;
-        resultSum += functionValue2 = Function(xStep);
+        panel_x_.push_back(xStep);
+    }
+
+    EvaluatePanel();
+
+    for (size_t i = 0; i < panel_f_.size(); i += 2)
+    {
+        xStep = panel_x_[i + 1];
+        resultSum += functionValue1 = panel_f_[i];
+        resultSum += functionValue2 = panel_f_[i + 1];
 
         if (!flag)
             if (stepNumber >= romberg_ - 1)
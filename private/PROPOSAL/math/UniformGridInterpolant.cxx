@@ -0,0 +1,316 @@
+
+#include <cmath>
+
+#include "PROPOSAL/math/UniformGridInterpolant.h"
+#include "PROPOSAL/Logging.h"
+
+using namespace PROPOSAL;
+
+UniformGridInterpolant1D::UniformGridInterpolant1D()
+    : x_min_(0)
+    , x_max_(0)
+    , inverse_step_(0)
+    , y_()
+{
+}
+
+UniformGridInterpolant1D::UniformGridInterpolant1D(std::function<double(double)> function,
+                                                   double x_min,
+                                                   double x_max,
+                                                   unsigned int number_of_points)
+    : x_min_(x_min)
+    , x_max_(x_max)
+    , inverse_step_(0)
+    , y_(number_of_points)
+{
+    double step = (x_max_ - x_min_) / (number_of_points - 1);
+
+    for (unsigned int i = 0; i < number_of_points; ++i)
+    {
+        y_[i] = function(x_min_ + i * step);
+    }
+
+    CheckGrid();
+}
+
+UniformGridInterpolant1D::UniformGridInterpolant1D(const std::vector<double>& y, double x_min, double x_max)
+    : x_min_(x_min)
+    , x_max_(x_max)
+    , inverse_step_(0)
+    , y_(y)
+{
+    CheckGrid();
+}
+
+bool UniformGridInterpolant1D::operator==(const UniformGridInterpolant1D& interpolant) const
+{
+    if (x_min_ != interpolant.x_min_)
+        return false;
+    else if (x_max_ != interpolant.x_max_)
+        return false;
+    else if (y_ != interpolant.y_)
+        return false;
+    else
+        return true;
+}
+
+bool UniformGridInterpolant1D::operator!=(const UniformGridInterpolant1D& interpolant) const
+{
+    return !(*this == interpolant);
+}
+
+void UniformGridInterpolant1D::CheckGrid()
+{
+    if (y_.size() < 4)
+    {
+        log_fatal("At least 4 grid points are needed for the cubic interpolation, %u given.",
+                  static_cast<unsigned int>(y_.size()));
+    }
+
+    if (x_max_ <= x_min_)
+    {
+        log_fatal("The upper grid limit %f must be larger than the lower one %f.", x_max_, x_min_);
+    }
+
+    inverse_step_ = (y_.size() - 1) / (x_max_ - x_min_);
+}
+
+// ------------------------------------------------------------------------- //
+// Two dimensional tables
+// ------------------------------------------------------------------------- //
+
+UniformGridInterpolant2D::UniformGridInterpolant2D(const std::vector<double>& x1,
+                                                   const std::vector<std::vector<double> >& x2,
+                                                   const std::vector<std::vector<double> >& y,
+                                                   int romberg)
+    : romberg_(romberg)
+    , x1_axis_()
+    , x2_axes_()
+    , y_(y)
+{
+    if (romberg_ < 1 || romberg_ > max_romberg_)
+    {
+        log_fatal("The romberg order must be between 1 and %i, %i given.", max_romberg_, romberg_);
+    }
+
+    if (x1.size() != y.size() || x1.size() != x2.size())
+    {
+        log_fatal("size of x1(%i), x2(%i) and y(%i) do not match!",
+                  (int)(x1.size()), (int)(x2.size()), (int)(y.size()));
+    }
+
+    x1_axis_ = Axis(x1, romberg_, false);
+
+    x2_axes_.reserve(x2.size());
+    for (unsigned int i = 0; i < x2.size(); ++i)
+    {
+        if (x2[i].size() != y[i].size())
+        {
+            log_fatal("size of x2(%i) and y(%i) in row %u do not match!",
+                      (int)(x2[i].size()), (int)(y[i].size()), i);
+        }
+
+        x2_axes_.push_back(Axis(x2[i], romberg_, true));
+    }
+}
+
+bool UniformGridInterpolant2D::operator==(const UniformGridInterpolant2D& interpolant) const
+{
+    if (romberg_ != interpolant.romberg_)
+        return false;
+    else if (x1_axis_.nodes_ != interpolant.x1_axis_.nodes_)
+        return false;
+    else if (y_ != interpolant.y_)
+        return false;
+
+    for (unsigned int i = 0; i < x2_axes_.size(); ++i)
+    {
+        if (x2_axes_[i].nodes_ != interpolant.x2_axes_[i].nodes_)
+            return false;
+    }
+
+    return true;
+}
+
+bool UniformGridInterpolant2D::operator!=(const UniformGridInterpolant2D& interpolant) const
+{
+    return !(*this == interpolant);
+}
+
+double UniformGridInterpolant2D::Interpolate(double x1, double x2) const
+{
+    double weights1[max_romberg_];
+    double weights2[max_romberg_];
+
+    int start1 = x1_axis_.FindStart(x1);
+    x1_axis_.Weights(x1, start1, weights1);
+
+    double result = 0;
+
+    for (int i = 0; i < romberg_; ++i)
+    {
+        const Axis& axis = x2_axes_[start1 + i];
+        const std::vector<double>& row = y_[start1 + i];
+
+        int start2 = axis.FindStart(x2);
+        axis.Weights(x2, start2, weights2);
+
+        double aux = 0;
+        for (int j = 0; j < romberg_; ++j)
+        {
+            aux += weights2[j] * row[start2 + j];
+        }
+
+        result += weights1[i] * aux;
+    }
+
+    return result;
+}
+
+UniformGridInterpolant2D::Axis::Axis()
+    : nodes_()
+    , inverse_denominators_()
+    , origin_(0)
+    , inverse_step_(0)
+    , log_spacing_(false)
+    , romberg_(1)
+{
+}
+
+UniformGridInterpolant2D::Axis::Axis(const std::vector<double>& nodes, int romberg, bool log_spacing)
+    : nodes_(nodes)
+    , inverse_denominators_()
+    , origin_(0)
+    , inverse_step_(0)
+    , log_spacing_(log_spacing)
+    , romberg_(romberg)
+{
+    int max = nodes_.size();
+
+    if (max < std::max(romberg_, 2))
+    {
+        log_fatal("At least %i grid points are needed for the interpolation, %i given.", std::max(romberg_, 2), max);
+    }
+
+    for (int i = 1; i < max; ++i)
+    {
+        if (!(nodes_[i] > nodes_[i - 1]))
+        {
+            log_fatal("The grid points must be strictly increasing.");
+        }
+    }
+
+    if (log_spacing_)
+    {
+        if (!(nodes_.front() > 0))
+        {
+            log_fatal("A logarithmic grid must be positive, but starts at %f.", nodes_.front());
+        }
+
+        origin_       = std::log(nodes_.front());
+        inverse_step_ = (max - 1) / (std::log(nodes_.back()) - origin_);
+    } else
+    {
+        origin_       = nodes_.front();
+        inverse_step_ = (max - 1) / (nodes_.back() - origin_);
+    }
+
+    // The denominators of the Lagrange basis polynomials for every stencil
+    inverse_denominators_.resize((max - romberg_ + 1) * romberg_);
+
+    for (int start = 0; start + romberg_ <= max; ++start)
+    {
+        for (int k = 0; k < romberg_; ++k)
+        {
+            double aux = 1;
+            for (int j = 0; j < romberg_; ++j)
+            {
+                if (j != k)
+                {
+                    aux *= nodes_[start + k] - nodes_[start + j];
+                }
+            }
+
+            inverse_denominators_[start * romberg_ + k] = 1 / aux;
+        }
+    }
+}
+
+int UniformGridInterpolant2D::Axis::FindStart(double x) const
+{
+    int max = nodes_.size();
+
+    // The spacing only gives a first guess, the interval itself is always
+    // checked against the nodes. The stencil is then chosen exactly like in
+    // Interpolant::InterpolateArray.
+    double u;
+    if (log_spacing_)
+    {
+        u = x > nodes_.front() ? (std::log(x) - origin_) * inverse_step_ : 0;
+    } else
+    {
+        u = (x - origin_) * inverse_step_;
+    }
+
+    int i;
+    if (!(u > 0))
+    {
+        i = 0;
+    } else if (u >= max - 2)
+    {
+        i = max - 2;
+    } else
+    {
+        i = static_cast<int>(u);
+    }
+
+    while (i > 0 && !(x > nodes_[i]))
+    {
+        --i;
+    }
+
+    while (i < max - 2 && x > nodes_[i + 1])
+    {
+        ++i;
+    }
+
+    int auxdir = ((x - nodes_[i]) < (nodes_[i + 1] - x)) ? 0 : 1;
+    int start  = i - (int)(0.5 * (romberg_ - 1 - auxdir));
+
+    if (start < 0)
+    {
+        start = 0;
+    }
+
+    if (start + romberg_ > max)
+    {
+        start = max - romberg_;
+    }
+
+    return start;
+}
+
+void UniformGridInterpolant2D::Axis::Weights(double x, int start, double* weights) const
+{
+    double dx[max_romberg_];
+
+    for (int j = 0; j < romberg_; ++j)
+    {
+        dx[j] = x - nodes_[start + j];
+    }
+
+    // products over all other nodes without a division, so x may hit a node
+    double aux = 1;
+    for (int k = 0; k < romberg_; ++k)
+    {
+        weights[k] = aux;
+        aux *= dx[k];
+    }
+
+    aux = 1;
+    for (int k = romberg_ - 1; k >= 0; --k)
+    {
+        weights[k] *= aux * inverse_denominators_[start * romberg_ + k];
+        aux *= dx[k];
+    }
+}
@@ -17,12 +17,6 @@ Vector3D::Vector3D()
     : x_(0)
     , y_(0)
     , z_(0)
-    , spheric_radius_(0)
-    , spheric_azimuth_(0)
-    , spheric_zenith_(0)
-// , cylindric_radius_  (0)
-// , cylindric_azimuth_ (0)
-// , cylindric_height_  (0)
 {
 }
 
@@ -30,46 +24,13 @@ Vector3D::Vector3D(const double x, const double y, const double z)
     : x_(x)
     , y_(y)
     , z_(z)
-    , spheric_radius_(0)
-    , spheric_azimuth_(0)
-    , spheric_zenith_(0)
-// , cylindric_radius_  (0)
-// , cylindric_azimuth_ (0)
-// , cylindric_height_  (0)
 {
 }
 
-// copy constructor
-Vector3D::Vector3D(const Vector3D& vector_3d)
-    : x_(vector_3d.x_)
-    , y_(vector_3d.y_)
-    , z_(vector_3d.z_)
-    , spheric_radius_(vector_3d.spheric_radius_)
-    , spheric_azimuth_(vector_3d.spheric_azimuth_)
-    , spheric_zenith_(vector_3d.spheric_zenith_)
-// , cylindric_radius_  (vector_3d.cylindric_radius_)
-// , cylindric_azimuth_ (vector_3d.cylindric_azimuth_)
-// , cylindric_height_  (vector_3d.cylindric_height_)
-{
-}
-
-// destructor
-Vector3D::~Vector3D() {}
-
 //----------------------------------------------------------------------//
 //-----------------------operator functions and swap--------------------//
 //----------------------------------------------------------------------//
 
-Vector3D& Vector3D::operator=(const Vector3D& vector_3d)
-{
-    if (this != &vector_3d)
-    {
-        Vector3D tmp(vector_3d);
-        swap(tmp);
-    }
-    return *this;
-}
-
 bool Vector3D::operator==(const Vector3D& vector_3d) const
 {
     if (x_ != vector_3d.x_)
@@ -78,15 +39,6 @@ bool Vector3D::operator==(const Vector3D& vector_3d) const
         return false;
     else if (z_ != vector_3d.z_)
         return false;
-    else if (spheric_radius_ != vector_3d.spheric_radius_)
-        return false;
-    else if (spheric_azimuth_ != vector_3d.spheric_azimuth_)
-        return false;
-    else if (spheric_zenith_ != vector_3d.spheric_zenith_)
-        return false;
-    // else if (cylindric_radius_  != vector_3d.cylindric_radius_)  return false;
-    // else if (cylindric_azimuth_ != vector_3d.cylindric_azimuth_) return false;
-    // else if (cylindric_height_  != vector_3d.cylindric_height_)  return false;
 
     return true;
 }
@@ -103,12 +55,6 @@ void Vector3D::swap(Vector3D& vector_3d)
     swap(x_, vector_3d.x_);
     swap(y_, vector_3d.y_);
     swap(z_, vector_3d.z_);
-    swap(spheric_radius_, vector_3d.spheric_radius_);
-    swap(spheric_azimuth_, vector_3d.spheric_azimuth_);
-    swap(spheric_zenith_, vector_3d.spheric_zenith_);
-    // swap(cylindric_radius_,  vector_3d.cylindric_radius_);
-    // swap(cylindric_azimuth_, vector_3d.cylindric_azimuth_);
-    // swap(cylindric_height_,  vector_3d.cylindric_height_);
 }
 
 namespace PROPOSAL {
@@ -120,11 +66,9 @@ std::ostream& operator<<(std::ostream& os, Vector3D const& vector_3d)
 
     os << "Cartesian Coordinates (x[cm],y[cm],z[cm]):\n"
        << vector_3d.x_ << "\t" << vector_3d.y_ << "\t" << vector_3d.z_ << std::endl;
+    Vector3D::SphericalCoordinates spherical = vector_3d.GetSphericalCoordinates();
     os << "Spherical Coordinates (radius[cm],azimut[rad],zenith[rad]):\n"
-       << vector_3d.spheric_radius_ << "\t" << vector_3d.spheric_azimuth_ << "\t" << vector_3d.spheric_zenith_
-       << std::endl;
-    // os<<"\tCylindrical Coordinates
-    // (radius,azimut,height):\t"<<vector_3d.cylindric_radius_<<"\t"<<vector_3d.cylindric_azimuth_<<"\t"<<vector_3d.cylindric_height_<<std::endl;
+       << spherical.radius << "\t" << spherical.azimuth << "\t" << spherical.zenith << std::endl;
 
     os << Helper::Centered(60, "");
     return os;
@@ -214,35 +158,36 @@ void Vector3D::normalise()
     x_              = x_ / length;
     y_              = y_ / length;
     z_              = z_ / length;
-    spheric_radius_ = 1;
 }
 
 //----------------------------------------------------------------------//
 //---------------Spherical and cylindrical coordinates------------------//
 //----------------------------------------------------------------------//
 
-void Vector3D::CalculateCartesianFromSpherical()
+Vector3D::SphericalCoordinates Vector3D::GetSphericalCoordinates() const
 {
-    x_ = spheric_radius_ * std::cos(spheric_azimuth_) * std::sin(spheric_zenith_);
-    y_ = spheric_radius_ * std::sin(spheric_azimuth_) * std::sin(spheric_zenith_);
-    z_ = spheric_radius_ * std::cos(spheric_zenith_);
-}
+    SphericalCoordinates spherical;
 
-void Vector3D::CalculateSphericalCoordinates()
-{
-    spheric_radius_  = std::sqrt(x_ * x_ + y_ * y_ + z_ * z_);
-    spheric_azimuth_ = std::atan2(y_, x_);
-    if (spheric_radius_ > 0.)
-    {
-        spheric_zenith_ = std::acos(z_ / spheric_radius_);
-    } else if (spheric_radius_ == 0.)
+    spherical.radius  = std::sqrt(x_ * x_ + y_ * y_ + z_ * z_);
+    spherical.azimuth = std::atan2(y_, x_);
+
+    if (spherical.radius > 0.)
     {
-        // log_warn("If the radius is zero, the zenith is not defined! Zero is returned!");
-        spheric_zenith_ = 0.;
+        spherical.zenith = std::acos(z_ / spherical.radius);
     } else
     {
-        // log_fatal("The radius is negativ, which is not possible!");
+        // If the radius is zero, the zenith is not defined! Zero is returned!
+        spherical.zenith = 0.;
     }
+
+    return spherical;
+}
+
+void Vector3D::SetSphericalCoordinates(const double radius, const double azimuth, const double zenith)
+{
+    x_ = radius * std::cos(azimuth) * std::sin(zenith);
+    y_ = radius * std::sin(azimuth) * std::sin(zenith);
+    z_ = radius * std::cos(zenith);
 }
 
 // void Vector3D::CalculateCartesianFromCylindrical()
@@ -213,6 +213,13 @@ Medium& Medium::operator=(const Medium& medium) {
 
 // ------------------------------------------------------------------------- //
 bool Medium::operator==(const Medium& medium) const {
+    if (*dens_distr_ != *medium.dens_distr_)
+        return false;
+
+    return HasSameComposition(medium);
+}
+
+bool Medium::HasSameComposition(const Medium& medium) const {
     if (name_ != medium.name_)
         return false;
     else if (numComponents_ != medium.numComponents_)
@@ -253,8 +260,6 @@ bool Medium::operator==(const Medium& medium) const {
         return false;
     else if (sumNucleons_ != medium.sumNucleons_)
         return false;
-    else if (*dens_distr_ != *medium.dens_distr_)
-        return false;
     else {
         bool Return = true;
         for (unsigned int i = 0; i < components_.size(); ++i) {
@@ -399,7 +404,9 @@ void Medium::SetSumNucleons(double sumNucleons) {
 }
 
 void Medium::SetDensityDistribution(Density_distr& density_distr) {
-    dens_distr_ = density_distr.clone();
+    Density_distr* dens_distr = density_distr.clone();
+    delete dens_distr_;
+    dens_distr_ = dens_distr;
 }
 
 /******************************************************************************
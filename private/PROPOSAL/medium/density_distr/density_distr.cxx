@@ -1,16 +1,22 @@
 #include "PROPOSAL/medium/density_distr/density_distr.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include "PROPOSAL/Logging.h"
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
+#include "PROPOSAL/geometry/Geometry.h"
 #include "PROPOSAL/math/Vector3D.h"
 
 using namespace PROPOSAL;
 
-Density_distr::Density_distr() : axis_(CartesianAxis().clone()) {}
+Density_distr::Density_distr() : axis_(CartesianAxis().clone()), grammage_table_() {}
 
 Density_distr::Density_distr(const Density_distr& density_distr)
-    : axis_(density_distr.axis_->clone()) {}
+    : axis_(density_distr.axis_->clone()),
+      grammage_table_(density_distr.grammage_table_) {}
 
-Density_distr::Density_distr(const Axis& axis) : axis_(axis.clone()) {}
+Density_distr::Density_distr(const Axis& axis) : axis_(axis.clone()), grammage_table_() {}
 
 bool Density_distr::operator==(const Density_distr& dens_distr) const
 {
@@ -26,6 +32,142 @@ bool Density_distr::operator!=(const Density_distr& dens_distr) const {
     return !(*this == dens_distr);
 }
 
+void Density_distr::BuildGrammageTable(const Geometry& geometry) {
+    std::pair<double, double> depth_range = axis_->GetDepthRange(geometry.GetBoundingBox());
+
+    if (!std::isfinite(depth_range.first) || !std::isfinite(depth_range.second) ||
+        depth_range.first >= depth_range.second) {
+        return;
+    }
+
+    // Particles on the border of the geometry may lie slightly outside
+    double padding = 1e-3 * (depth_range.second - depth_range.first);
+
+    TabulateGrammage(depth_range.first - padding, depth_range.second + padding);
+}
+
+bool Density_distr::InvertGrammageTable(double depth,
+                                        double delta,
+                                        double grammage,
+                                        double distance_to_border,
+                                        double& distance) const {
+    if (!grammage_table_.IsTabulated() || delta == 0) {
+        return false;
+    }
+
+    if (!grammage_table_.Contains(depth) ||
+        !grammage_table_.Contains(depth + distance_to_border * delta)) {
+        return false;
+    }
+
+    double depth_interaction = grammage_table_.GetDepth(grammage);
+
+    distance = (depth_interaction - depth) / delta;
+
+    // The whole trajectory to the border is tabulated, so the grammage is
+    // not reached in front of the border
+    if (std::isnan(depth_interaction) || distance < 0 || distance > distance_to_border) {
+        distance = std::numeric_limits<double>::infinity();
+    }
+
+    return true;
+}
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// %%%%%%%%%%%%%%%%%%%    GrammageTable   %%%%%%%%%%%%%%%%%%%%
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+GrammageTable::GrammageTable()
+    : depth_min_(0), depth_max_(0), step_(0), grammage_(), density_() {}
+
+GrammageTable::GrammageTable(std::function<double(double)> density,
+                             std::function<double(double)> antiderivative,
+                             double depth_min,
+                             double depth_max,
+                             double precision,
+                             unsigned int max_nodes)
+    : depth_min_(depth_min), depth_max_(depth_max), step_(0), grammage_(), density_() {
+    // The nodes are doubled till the inverse reaches the precision in the
+    // middle between the nodes, where the error of the interpolation is
+    // largest
+    for (unsigned int nodes = 256; nodes <= max_nodes; nodes = 2 * nodes - 1) {
+        if (!Tabulate(density, antiderivative, nodes)) {
+            log_warn("The density is not positive between the depths %f and %f, the grammage will not be "
+                     "tabulated.", depth_min_, depth_max_);
+            break;
+        }
+
+        double error = 0;
+        for (unsigned int i = 0; i + 1 < grammage_.size(); ++i) {
+            double depth = depth_min_ + (i + 0.5) * step_;
+            error = std::max(error, std::abs(GetDepth(antiderivative(depth)) - depth));
+        }
+
+        if (error <= precision * (depth_max_ - depth_min_)) {
+            return;
+        }
+    }
+
+    // Correct searches the distance iteratively instead
+    log_debug("The grammage between the depths %f and %f can not be tabulated with a relative precision of %g.",
+              depth_min_, depth_max_, precision);
+
+    step_ = 0;
+    grammage_.clear();
+    density_.clear();
+}
+
+bool GrammageTable::Tabulate(const std::function<double(double)>& density,
+                             const std::function<double(double)>& antiderivative,
+                             unsigned int nodes) {
+    step_ = (depth_max_ - depth_min_) / (nodes - 1);
+    grammage_.resize(nodes);
+    density_.resize(nodes);
+
+    for (unsigned int i = 0; i < nodes; ++i) {
+        double depth = depth_min_ + i * step_;
+
+        grammage_[i] = antiderivative(depth);
+        density_[i] = density(depth);
+
+        // The inverse needs a strictly increasing antiderivative
+        if (!(density_[i] > 0) || !std::isfinite(grammage_[i]) ||
+            (i > 0 && !(grammage_[i] > grammage_[i - 1]))) {
+            step_ = 0;
+            grammage_.clear();
+            density_.clear();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool GrammageTable::Contains(double depth) const {
+    return depth >= depth_min_ && depth <= depth_max_;
+}
+
+double GrammageTable::GetDepth(double grammage) const {
+    if (grammage_.empty() || grammage < grammage_.front() || grammage > grammage_.back()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    size_t i = std::upper_bound(grammage_.begin(), grammage_.end(), grammage) - grammage_.begin();
+    i = std::min(std::max(i, size_t(1)), grammage_.size() - 1) - 1;
+
+    // Cubic Hermite interpolation of the depth with the derivatives
+    // 1 / density at the nodes
+    double h = grammage_[i + 1] - grammage_[i];
+    double t = (grammage - grammage_[i]) / h;
+    double t2 = t * t;
+    double t3 = t2 * t;
+
+    double depth = depth_min_ + i * step_;
+
+    return (2 * t3 - 3 * t2 + 1) * depth + (t3 - 2 * t2 + t) * h / density_[i] +
+           (-2 * t3 + 3 * t2) * (depth + step_) + (t3 - t2) * h / density_[i + 1];
+}
+
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 // %%%%%%%%%%%%%%%%%%%        Axis        %%%%%%%%%%%%%%%%%%%%
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -70,6 +212,22 @@ double RadialAxis::GetEffectiveDistance(const Vector3D& xi, const Vector3D& dire
     return -aux * direction;
 }
 
+std::pair<double, double> RadialAxis::GetDepthRange(const BoundingBox& box) const {
+    double p0[3] = {fp0_.GetX(), fp0_.GetY(), fp0_.GetZ()};
+    double distance_near = 0;
+    double distance_far = 0;
+
+    for (int i = 0; i < 3; ++i) {
+        double closest = std::min(std::max(p0[i], box.min[i]), box.max[i]);
+        double farthest = std::max(std::abs(box.min[i] - p0[i]), std::abs(box.max[i] - p0[i]));
+
+        distance_near += (closest - p0[i]) * (closest - p0[i]);
+        distance_far += farthest * farthest;
+    }
+
+    return std::make_pair(std::sqrt(distance_near), std::sqrt(distance_far));
+}
+
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 // %%%%%%%%%%%%%%%%%%%      Cartesian     %%%%%%%%%%%%%%%%%%%%
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -91,3 +249,20 @@ double CartesianAxis::GetEffectiveDistance(const Vector3D& xi,
 
     return fAxis_ * direction;
 }
+
+std::pair<double, double> CartesianAxis::GetDepthRange(const BoundingBox& box) const {
+    double axis[3] = {fAxis_.GetX(), fAxis_.GetY(), fAxis_.GetZ()};
+    double p0[3] = {fp0_.GetX(), fp0_.GetY(), fp0_.GetZ()};
+    double depth_min = 0;
+    double depth_max = 0;
+
+    for (int i = 0; i < 3; ++i) {
+        double lower = axis[i] * (box.min[i] - p0[i]);
+        double upper = axis[i] * (box.max[i] - p0[i]);
+
+        depth_min += std::min(lower, upper);
+        depth_max += std::max(lower, upper);
+    }
+
+    return std::make_pair(depth_min, depth_max);
+}
@@ -0,0 +1,168 @@
+#include "PROPOSAL/medium/density_distr/density_layered.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "PROPOSAL/Logging.h"
+#include "PROPOSAL/geometry/GeometryKernels.h"
+
+using namespace PROPOSAL;
+
+Density_layered::Density_layered()
+    : Density_distr(RadialAxis()), radii_(), layers_() {}
+
+Density_layered::Density_layered(const RadialAxis& axis)
+    : Density_distr(axis), radii_(), layers_() {}
+
+Density_layered::Density_layered(const Density_layered& dens_layered)
+    : Density_distr(dens_layered),
+      radii_(dens_layered.radii_),
+      layers_(dens_layered.layers_) {}
+
+bool Density_layered::compare(const Density_distr& dens_distr) const {
+    const Density_layered* dens_layered = dynamic_cast<const Density_layered*>(&dens_distr);
+    if (!dens_layered)
+        return false;
+    if (radii_ != dens_layered->radii_)
+        return false;
+    for (unsigned int i = 0; i < layers_.size(); ++i) {
+        if (*layers_[i] != *dens_layered->layers_[i])
+            return false;
+    }
+    return true;
+}
+
+void Density_layered::AddLayer(double radius, const Density_distr& density) {
+    if (!radii_.empty() && radius <= radii_.back()) {
+        log_fatal("The radius %f of a layer must be larger than the radius %f of the layer below!",
+                  radius, radii_.back());
+    }
+
+    radii_.push_back(radius);
+    layers_.push_back(std::shared_ptr<const Density_distr>(density.clone()));
+}
+
+unsigned int Density_layered::GetLayer(const Vector3D& xi) const {
+    if (layers_.empty()) {
+        log_fatal("The layered density distribution has no layers!");
+    }
+
+    unsigned int layer =
+        std::upper_bound(radii_.begin(), radii_.end(), axis_->GetDepth(xi)) - radii_.begin();
+
+    return std::min(layer, GetNumberOfLayers() - 1);
+}
+
+std::vector<double> Density_layered::GetSegments(const Vector3D& xi,
+                                                 const Vector3D& direction,
+                                                 double distance) const {
+    Vector3D difference = xi - axis_->GetFp0();
+
+    double difference_length_squared = difference * difference;
+    double projection = difference * direction;
+
+    std::vector<double> segments;
+
+    // The outermost radius is no border
+    if (radii_.size() < 2) {
+        segments.push_back(distance);
+        return segments;
+    }
+
+    // Only the borders between the smallest and the largest radius of the
+    // trajectory are crossed: inwards the borders below the start radius,
+    // after the closest approach the borders below the end radius
+    double radius_start = std::sqrt(difference_length_squared);
+    double radius_end = std::isinf(distance) ? distance : (difference + distance * direction).magnitude();
+    double radius_closest = -projection > 0 && -projection < distance
+                                ? std::sqrt(std::max(difference_length_squared - projection * projection, 0.))
+                                : std::min(radius_start, radius_end);
+
+    std::vector<double>::const_iterator borders_end = radii_.end() - 1;
+    std::vector<double>::const_iterator lower = std::lower_bound(radii_.begin(), borders_end, radius_closest);
+    std::vector<double>::const_iterator inwards = std::upper_bound(lower, borders_end, radius_start);
+    std::vector<double>::const_iterator outwards = std::upper_bound(lower, borders_end, radius_end);
+
+    double enter, exit;
+
+    // Entering the borders from the outside, then leaving them, so the
+    // distances are sorted
+    for (std::vector<double>::const_iterator radius = inwards; radius != lower;) {
+        --radius;
+        GeometryKernels::SphereInterval(difference_length_squared, projection, *radius, enter, exit);
+
+        if (enter > 0 && enter < distance)
+            segments.push_back(enter);
+    }
+
+    for (std::vector<double>::const_iterator radius = lower; radius != outwards; ++radius) {
+        GeometryKernels::SphereInterval(difference_length_squared, projection, *radius, enter, exit);
+
+        if (exit > 0 && exit < distance)
+            segments.push_back(exit);
+    }
+
+    segments.push_back(distance);
+
+    return segments;
+}
+
+const Density_distr& Density_layered::GetSegmentLayer(const Vector3D& xi,
+                                                      const Vector3D& direction,
+                                                      double start,
+                                                      double end) const {
+    // The center of the segment decides on the layer, as its ends are on
+    // the borders between the layers. The last segment may be infinite.
+    double center = std::isinf(end) ? start + 1 : 0.5 * (start + end);
+
+    return *layers_[GetLayer(xi + center * direction)];
+}
+
+double Density_layered::Correct(const Vector3D& xi,
+                                const Vector3D& direction,
+                                double res,
+                                double distance_to_border) const {
+    double start = 0;
+
+    for (double end : GetSegments(xi, direction, distance_to_border)) {
+        const Density_distr& layer = GetSegmentLayer(xi, direction, start, end);
+        Vector3D position = xi + start * direction;
+
+        double grammage = layer.Calculate(position, direction, end - start);
+
+        if (grammage >= res) {
+            return start + layer.Correct(position, direction, res, end - start);
+        }
+
+        res -= grammage;
+        start = end;
+    }
+
+    return std::numeric_limits<double>::infinity();
+}
+
+double Density_layered::Integrate(const Vector3D& xi,
+                                  const Vector3D& direction,
+                                  double l) const {
+    // Antiderivative along the trajectory, which vanishes at the position
+    return Calculate(xi, direction, l);
+}
+
+double Density_layered::Calculate(const Vector3D& xi,
+                                  const Vector3D& direction,
+                                  double distance) const {
+    double start = 0;
+    double grammage = 0;
+
+    for (double end : GetSegments(xi, direction, distance)) {
+        const Density_distr& layer = GetSegmentLayer(xi, direction, start, end);
+
+        grammage += layer.Calculate(xi + start * direction, direction, end - start);
+        start = end;
+    }
+
+    return grammage;
+}
+
+double Density_layered::Evaluate(const Vector3D& xi) const {
+    return layers_[GetLayer(xi)]->Evaluate(xi);
+}
@@ -56,6 +56,16 @@ double Density_polynomial::Correct(const Vector3D& xi,
                                    const Vector3D& direction,
                                    double res,
                                    double distance_to_border) const {
+    double delta = axis_->GetEffectiveDistance(xi, direction);
+    double depth = axis_->GetDepth(xi);
+    double distance;
+
+    // Integrate is the antiderivative divided by delta^2
+    if (InvertGrammageTable(depth, delta, antiderived_density_distribution(depth) + res * delta * delta,
+                            distance_to_border, distance)) {
+        return distance;
+    }
+
     std::function<double(double)> F =
         std::bind(&Density_polynomial::Helper_function, this, xi, direction,
                   res, std::placeholders::_1);
@@ -95,3 +105,8 @@ double Density_polynomial::Calculate(const Vector3D& xi,
 double Density_polynomial::Evaluate(const Vector3D& xi) const {
     return density_distribution(axis_->GetDepth(xi));
 }
+
+void Density_polynomial::TabulateGrammage(double depth_min, double depth_max) {
+    grammage_table_ = GrammageTable(density_distribution, antiderived_density_distribution,
+                                    depth_min, depth_max);
+}
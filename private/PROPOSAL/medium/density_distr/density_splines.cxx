@@ -1,23 +1,116 @@
 #include "PROPOSAL/medium/density_distr/density_splines.h"
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include "PROPOSAL/Constants.h"
 #include "PROPOSAL/math/MathMethods.h"
 #include "PROPOSAL/math/Spline.h"
 
 using namespace PROPOSAL;
 
+namespace {
+
+// Horner scheme, the coefficients start with the constant one
+double EvaluatePolynom(const std::vector<double>& coefficients, double x) {
+    double result = 0;
+
+    for (auto it = coefficients.rbegin(); it != coefficients.rend(); ++it)
+        result = result * x + *it;
+
+    return result;
+}
+
+}  // namespace
+
 Density_splines::Density_splines(const Axis& axis, const Spline& splines)
     : Density_distr(axis),
       spline_(splines.clone()),
-      integrated_spline_(splines.clone()) {
+      integrated_spline_(splines.clone()),
+      invertible_(false) {
     integrated_spline_->Antiderivative(0);
+    InitSegments();
 }
 
 Density_splines::Density_splines(const Density_splines& dens_splines)
     : Density_distr(dens_splines),
       spline_(dens_splines.spline_),
-      integrated_spline_(dens_splines.integrated_spline_) {}
+      integrated_spline_(dens_splines.integrated_spline_),
+      subintervalls_(dens_splines.subintervalls_),
+      density_coefficients_(dens_splines.density_coefficients_),
+      antiderivative_coefficients_(dens_splines.antiderivative_coefficients_),
+      antiderivative_nodes_(dens_splines.antiderivative_nodes_),
+      invertible_(dens_splines.invertible_) {}
+
+void Density_splines::InitSegments() {
+    subintervalls_ = spline_->GetSubintervalls();
+
+    for (auto polynom : spline_->GetFunctions())
+        density_coefficients_.push_back(polynom.GetCoefficient());
+
+    for (auto polynom : integrated_spline_->GetFunctions())
+        antiderivative_coefficients_.push_back(polynom.GetCoefficient());
+
+    antiderivative_nodes_.push_back(
+        EvaluatePolynom(antiderivative_coefficients_.front(), subintervalls_.front()));
+
+    for (unsigned int i = 0; i < antiderivative_coefficients_.size(); ++i)
+        antiderivative_nodes_.push_back(
+            EvaluatePolynom(antiderivative_coefficients_[i], subintervalls_[i + 1]));
+
+    invertible_ = true;
+    for (unsigned int i = 0; i + 1 < antiderivative_nodes_.size(); ++i) {
+        if (!(antiderivative_nodes_[i + 1] > antiderivative_nodes_[i]))
+            invertible_ = false;
+    }
+}
+
+unsigned int Density_splines::GetSegment(double depth) const {
+    unsigned int segment =
+        std::upper_bound(subintervalls_.begin() + 1, subintervalls_.end() - 1, depth) -
+        (subintervalls_.begin() + 1);
+
+    return segment;
+}
+
+double Density_splines::InvertSegment(unsigned int segment, double grammage) const {
+    const std::vector<double>& antiderivative = antiderivative_coefficients_[segment];
+    const std::vector<double>& density = density_coefficients_[segment];
+
+    double low = subintervalls_[segment];
+    double high = subintervalls_[segment + 1];
+
+    // Start with the solution for a constant density in the segment
+    double depth = low + (grammage - antiderivative_nodes_[segment]) /
+                             (antiderivative_nodes_[segment + 1] - antiderivative_nodes_[segment]) *
+                             (high - low);
+
+    for (int i = 0; i < 100; ++i) {
+        double difference = EvaluatePolynom(antiderivative, depth) - grammage;
+
+        if (difference < 0)
+            low = depth;
+        else if (difference > 0)
+            high = depth;
+        else
+            return depth;
+
+        double slope = EvaluatePolynom(density, depth);
+        double next = depth - difference / slope;
+
+        // Bisection, if the Newton step leaves the bracket
+        if (!(slope > 0) || next <= low || next >= high)
+            next = 0.5 * (low + high);
+
+        if (std::abs(next - depth) <= COMPUTER_PRECISION * std::max(1.0, std::abs(depth)))
+            return next;
+
+        depth = next;
+    }
+
+    return depth;
+}
 
 bool Density_splines::compare(const Density_distr& dens_distr) const {
     const Density_splines* dens_splines= dynamic_cast<const Density_splines*>(&dens_distr);
@@ -49,6 +142,42 @@ double Density_splines::Correct(const Vector3D& xi,
                                 const Vector3D& direction,
                                 double res,
                                 double distance_to_border) const {
+    double delta = axis_->GetEffectiveDistance(xi, direction);
+    double depth = axis_->GetDepth(xi);
+    double distance;
+
+    // Integrate is the antiderivative divided by delta^2
+    double grammage =
+        EvaluatePolynom(antiderivative_coefficients_[GetSegment(depth)], depth) + res * delta * delta;
+
+    // Inside of the domain of the spline, the segment reaching the grammage
+    // is searched and inverted. Against the axis, the depth and the
+    // antiderivative decrease along the trajectory.
+    double border_depth = depth + delta * distance_to_border;
+
+    if (invertible_ && delta != 0 && std::min(depth, border_depth) >= subintervalls_.front() &&
+        std::max(depth, border_depth) <= subintervalls_.back()) {
+        double border_grammage =
+            EvaluatePolynom(antiderivative_coefficients_[GetSegment(border_depth)], border_depth);
+
+        // The grammage lies behind the border or behind the position
+        if ((delta > 0 && (grammage > border_grammage || res < 0)) ||
+            (delta < 0 && (grammage < border_grammage || res > 0)))
+            return std::numeric_limits<double>::infinity();
+
+        unsigned int segment =
+            std::upper_bound(antiderivative_nodes_.begin() + 1, antiderivative_nodes_.end() - 1, grammage) -
+            (antiderivative_nodes_.begin() + 1);
+
+        distance = (InvertSegment(segment, grammage) - depth) / delta;
+
+        return std::max(0., std::min(distance, distance_to_border));
+    }
+
+    if (InvertGrammageTable(depth, delta, grammage, distance_to_border, distance)) {
+        return distance;
+    }
+
     std::function<double(double)> F =
         std::bind(&Density_splines::Helper_function, this, xi, direction, res,
                   std::placeholders::_1);
@@ -72,8 +201,10 @@ double Density_splines::Integrate(const Vector3D& xi,
                                   double l) const {
     double delta = axis_->GetEffectiveDistance(xi, direction);
 
+    double depth = axis_->GetDepth(xi) + l * delta;
+
     return 1 / (delta * delta) *
-           integrated_spline_->evaluate(axis_->GetDepth(xi) + l * delta);
+           EvaluatePolynom(antiderivative_coefficients_[GetSegment(depth)], depth);
 }
 
 double Density_splines::Calculate(const Vector3D& xi,
@@ -83,5 +214,13 @@ double Density_splines::Calculate(const Vector3D& xi,
 }
 
 double Density_splines::Evaluate(const Vector3D& xi) const {
-    return spline_->evaluate(axis_->GetDepth(xi));
+    double depth = axis_->GetDepth(xi);
+
+    return EvaluatePolynom(density_coefficients_[GetSegment(depth)], depth);
+}
+
+void Density_splines::TabulateGrammage(double depth_min, double depth_max) {
+    grammage_table_ = GrammageTable([this](double depth) { return spline_->evaluate(depth); },
+                                    [this](double depth) { return integrated_spline_->evaluate(depth); },
+                                    depth_min, depth_max);
 }
@@ -296,8 +296,6 @@ void InitializeInterpolation(
     InterpolantBuilderContainer& builder_container,
     const std::vector<Parametrization*>& parametrizations,
     const InterpolationDef interpolation_def) {
-    log_debug("Initialize %s interpolation.", name.c_str());
-
     // --------------------------------------------------------------------- //
     // Create hash for the file name
     // --------------------------------------------------------------------- //
@@ -317,6 +315,18 @@ void InitializeInterpolation(
                          parametrizations[0]->GetParticleDef().lifetime);
         }
     }
+
+    InitializeInterpolation(name, builder_container, hash_digest, interpolation_def);
+}
+
+// ------------------------------------------------------------------------- //
+void InitializeInterpolation(
+    const std::string name,
+    InterpolantBuilderContainer& builder_container,
+    size_t hash_digest,
+    const InterpolationDef interpolation_def) {
+    log_debug("Initialize %s interpolation.", name.c_str());
+
     hash_combine(hash_digest, interpolation_def.GetHash());
 
     bool storing_failed = false;
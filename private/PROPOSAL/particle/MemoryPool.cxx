@@ -0,0 +1,205 @@
+
+#include <mutex>
+#include <new>
+
+#include "PROPOSAL/particle/MemoryPool.h"
+
+using namespace PROPOSAL;
+
+namespace {
+
+// Pools of finished threads, which are reused by new threads
+std::vector<MemoryPool*>& ReleasedPools()
+{
+    static std::vector<MemoryPool*>* pools = new std::vector<MemoryPool*>();
+    return *pools;
+}
+
+std::mutex& ReleasedPoolsMutex()
+{
+    static std::mutex* mutex = new std::mutex();
+    return *mutex;
+}
+
+// Hands the pool of a thread back, when the thread ends
+struct PoolRelease
+{
+    explicit PoolRelease(MemoryPool*& pool)
+        : pool_(pool)
+    {
+    }
+
+    ~PoolRelease()
+    {
+        std::lock_guard<std::mutex> lock(ReleasedPoolsMutex());
+        ReleasedPools().push_back(pool_);
+
+        // Later requests of this thread take another pool
+        pool_ = NULL;
+    }
+
+    MemoryPool*& pool_;
+};
+
+} // namespace
+
+// ------------------------------------------------------------------------- //
+MemoryPool& MemoryPool::Get()
+{
+    // A plain pointer stays valid during the whole destruction of the thread
+    static thread_local MemoryPool* pool = NULL;
+
+    if (pool == NULL)
+    {
+        pool = Acquire();
+
+        static thread_local PoolRelease release(pool);
+    }
+
+    return *pool;
+}
+
+// ------------------------------------------------------------------------- //
+MemoryPool* MemoryPool::Acquire()
+{
+    std::lock_guard<std::mutex> lock(ReleasedPoolsMutex());
+
+    std::vector<MemoryPool*>& pools = ReleasedPools();
+
+    if (pools.empty())
+    {
+        return new MemoryPool();
+    }
+
+    MemoryPool* pool = pools.back();
+    pools.pop_back();
+
+    return pool;
+}
+
+MemoryPool::MemoryPool()
+    : free_lists_(max_size_ / granularity_, NULL)
+    , chunks_()
+    , chunk_position_(NULL)
+    , chunk_end_(NULL)
+    , remote_mutex_()
+    , remote_free_lists_(max_size_ / granularity_, NULL)
+    , remote_pending_(false)
+{
+}
+
+MemoryPool::~MemoryPool()
+{
+    for (auto chunk : chunks_)
+    {
+        ::operator delete(chunk);
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void* MemoryPool::Allocate(std::size_t size)
+{
+    if (size == 0 || size > max_size_)
+    {
+        return ::operator new(size);
+    }
+
+    std::size_t size_class = (size - 1) / granularity_;
+
+    if (free_lists_[size_class] == NULL && remote_pending_.load(std::memory_order_acquire))
+    {
+        CollectRemote();
+    }
+
+    FreeNode* node = free_lists_[size_class];
+
+    if (node != NULL)
+    {
+        free_lists_[size_class] = node->next;
+        return node;
+    }
+
+    std::size_t block_size = sizeof(BlockHeader) + (size_class + 1) * granularity_;
+
+    if (chunk_position_ == NULL || static_cast<std::size_t>(chunk_end_ - chunk_position_) < block_size)
+    {
+        // The rest of the old chunk is lost, at most one block of the largest size class
+        chunk_position_ = static_cast<char*>(::operator new(chunk_size_));
+        chunk_end_      = chunk_position_ + chunk_size_;
+        chunks_.push_back(chunk_position_);
+    }
+
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(chunk_position_);
+    header->owner       = this;
+    chunk_position_ += block_size;
+
+    return header + 1;
+}
+
+// ------------------------------------------------------------------------- //
+void MemoryPool::Deallocate(void* ptr, std::size_t size)
+{
+    if (ptr == NULL)
+    {
+        return;
+    }
+
+    if (size == 0 || size > max_size_)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    std::size_t size_class = (size - 1) / granularity_;
+    MemoryPool* owner      = (static_cast<BlockHeader*>(ptr) - 1)->owner;
+
+    if (owner != this)
+    {
+        owner->DeallocateRemote(ptr, size_class);
+        return;
+    }
+
+    FreeNode* node          = static_cast<FreeNode*>(ptr);
+    node->next              = free_lists_[size_class];
+    free_lists_[size_class] = node;
+}
+
+// ------------------------------------------------------------------------- //
+void MemoryPool::DeallocateRemote(void* ptr, std::size_t size_class)
+{
+    std::lock_guard<std::mutex> lock(remote_mutex_);
+
+    FreeNode* node                 = static_cast<FreeNode*>(ptr);
+    node->next                     = remote_free_lists_[size_class];
+    remote_free_lists_[size_class] = node;
+
+    remote_pending_.store(true, std::memory_order_release);
+}
+
+// ------------------------------------------------------------------------- //
+void MemoryPool::CollectRemote()
+{
+    std::lock_guard<std::mutex> lock(remote_mutex_);
+
+    for (std::size_t size_class = 0; size_class < remote_free_lists_.size(); ++size_class)
+    {
+        FreeNode* node = remote_free_lists_[size_class];
+
+        if (node == NULL)
+        {
+            continue;
+        }
+
+        FreeNode* last = node;
+        while (last->next != NULL)
+        {
+            last = last->next;
+        }
+
+        last->next                     = free_lists_[size_class];
+        free_lists_[size_class]        = node;
+        remote_free_lists_[size_class] = NULL;
+    }
+
+    remote_pending_.store(false, std::memory_order_relaxed);
+}
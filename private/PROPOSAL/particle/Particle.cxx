@@ -9,6 +9,7 @@
 
 #include <cmath>
 #include "PROPOSAL/particle/Particle.h"
+#include "PROPOSAL/Logging.h"
 #include "PROPOSAL/methods.h"
 
 using namespace PROPOSAL;
@@ -25,6 +26,7 @@ DynamicData::DynamicData(DynamicData::Type type)
     , parent_particle_energy_(0)
     , time_(0)
     , propagated_distance_(0)
+    , weight_(1)
 {
 }
 
@@ -36,6 +38,7 @@ DynamicData::DynamicData(const DynamicData& data)
     , parent_particle_energy_(data.parent_particle_energy_)
     , time_(data.time_)
     , propagated_distance_(data.propagated_distance_)
+    , weight_(data.weight_)
 {
 }
 
@@ -57,6 +60,7 @@ std::ostream& PROPOSAL::operator<<(std::ostream& os, DynamicData const& data)
     os << "parent_particle_energy: " << data.parent_particle_energy_ << '\n';
     os << "time: " << data.time_ << '\n';
     os << "propagated distance: " << data.propagated_distance_ << '\n';
+    os << "weight: " << data.weight_ << '\n';
 
     data.print(os);
 
@@ -96,6 +100,21 @@ std::string DynamicData::GetNameFromType(Type type)
     }
 }
 
+// ------------------------------------------------------------------------- //
+DynamicData::Type DynamicData::GetTypeFromName(const std::string& name)
+{
+    for (int type = None; type <= Compton; ++type)
+    {
+        if (GetNameFromType(static_cast<Type>(type)) == name)
+        {
+            return static_cast<Type>(type);
+        }
+    }
+
+    log_fatal("DynamicData type '%s' not found", name.c_str());
+    return None; // just to prevent warnings
+}
+
 /******************************************************************************
  *                              Particle                                       *
  ******************************************************************************/
@@ -202,6 +221,8 @@ bool Particle::operator==(const Particle& particle) const
         return false;
     if (elost_ != particle.elost_)
         return false;
+    if (weight_ != particle.weight_)
+        return false;
     if (particle_def_ != particle.particle_def_)
     {
         return false;
@@ -228,6 +249,7 @@ void Particle::InjectState(const Particle& particle)
     parent_particle_energy_  = particle.parent_particle_energy_;
     time_                    = particle.time_;
     propagated_distance_     = particle.propagated_distance_;
+    weight_                  = particle.weight_;
     momentum_                = particle.momentum_;
     entry_point_             = particle.entry_point_;
     entry_time_              = particle.entry_time_;
@@ -262,7 +284,7 @@ void Particle::DeflectDirection(double cosphi_deflect, double theta_deflect) {
 
     Vector3D old_direction = GetDirection();
 
-    old_direction.CalculateSphericalCoordinates();
+    Vector3D::SphericalCoordinates spherical = old_direction.GetSphericalCoordinates();
     double sinphi_deflect = std::sqrt( std::max(0., (1. - cosphi_deflect) * (1. + cosphi_deflect) ));
     double tx = sinphi_deflect * std::cos(theta_deflect);
     double ty = sinphi_deflect * std::sin(theta_deflect);
@@ -273,10 +295,10 @@ void Particle::DeflectDirection(double cosphi_deflect, double theta_deflect) {
     }
 
     long double sinth, costh, sinph, cosph;
-    sinth = (long double)std::sin(old_direction.GetTheta());
-    costh = (long double)std::cos(old_direction.GetTheta());
-    sinph = (long double)std::sin(old_direction.GetPhi());
-    cosph = (long double)std::cos(old_direction.GetPhi());
+    sinth = (long double)std::sin(spherical.zenith);
+    costh = (long double)std::cos(spherical.zenith);
+    sinph = (long double)std::sin(spherical.azimuth);
+    cosph = (long double)std::cos(spherical.azimuth);
 
     const Vector3D rotate_vector_x = Vector3D(costh * cosph, costh * sinph, -sinth);
     const Vector3D rotate_vector_y = Vector3D(-sinph, cosph, 0.);
@@ -8,8 +8,11 @@
  */
 
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "PROPOSAL/Constants.h"
 #include "PROPOSAL/decay/LeptonicDecayChannel.h"
@@ -171,6 +174,30 @@ const ParticleDef* ParticleDef::GetWeakPartner() const {
     }
 }
 
+const ParticleDef& ParticleDef::GetShared(const ParticleDef& particle_def)
+{
+    // The definitions are looked up by their name first, so just the few
+    // definitions of the same name are compared. Propagators in different
+    // threads share the definitions, therefore the lookup is locked.
+    static std::unordered_map<std::string, std::vector<std::unique_ptr<const ParticleDef> > > shared_defs;
+    static std::mutex shared_defs_mutex;
+
+    std::lock_guard<std::mutex> lock(shared_defs_mutex);
+
+    std::vector<std::unique_ptr<const ParticleDef> >& defs = shared_defs[particle_def.name];
+
+    for (const auto& def : defs)
+    {
+        if (def.get() == &particle_def || *def == particle_def)
+        {
+            return *def;
+        }
+    }
+
+    defs.emplace_back(particle_def.clone());
+    return *defs.back();
+}
+
 // ParticleDef& ParticleDef::operator=(const ParticleDef& def)
 // {
 //     if (this != &def)
@@ -0,0 +1,69 @@
+
+#include <type_traits>
+
+#include "PROPOSAL/particle/Secondary.h"
+
+using namespace PROPOSAL;
+
+static_assert(std::is_pod<Secondary>::value, "Secondary must stay plain data");
+
+// ------------------------------------------------------------------------- //
+Vector3D Secondary::GetPosition() const
+{
+    return Vector3D(position[0], position[1], position[2]);
+}
+
+// ------------------------------------------------------------------------- //
+Vector3D Secondary::GetDirection() const
+{
+    return Vector3D(direction[0], direction[1], direction[2]);
+}
+
+// ------------------------------------------------------------------------- //
+Secondary Secondary::Create(const DynamicData& data)
+{
+    Secondary secondary;
+
+    secondary.type_id      = data.GetTypeId();
+    secondary.particle_def = NULL;
+
+    if (secondary.type_id == DynamicData::Particle)
+    {
+        const Particle& particle = static_cast<const Particle&>(data);
+        secondary.particle_def   = &ParticleDef::GetShared(particle.GetParticleDef());
+    }
+
+    secondary.SetPosition(data.GetPosition());
+    secondary.SetDirection(data.GetDirection());
+    secondary.energy                 = data.GetEnergy();
+    secondary.parent_particle_energy = data.GetParentParticleEnergy();
+    secondary.time                   = data.GetTime();
+    secondary.propagated_distance    = data.GetPropagatedDistance();
+    secondary.weight                 = data.GetWeight();
+
+    return secondary;
+}
+
+// ------------------------------------------------------------------------- //
+DynamicData* Secondary::CreateDynamicData() const
+{
+    DynamicData* data = NULL;
+
+    if (particle_def != NULL)
+    {
+        data = new Particle(*particle_def);
+    } else
+    {
+        data = new DynamicData(type_id);
+    }
+
+    data->SetPosition(GetPosition());
+    data->SetDirection(GetDirection());
+    data->SetEnergy(energy);
+    data->SetParentParticleEnergy(parent_particle_energy);
+    data->SetTime(time);
+    data->SetPropagatedDistance(propagated_distance);
+    data->SetWeight(weight);
+
+    return data;
+}
@@ -0,0 +1,159 @@
+
+#include <algorithm>
+
+#include "PROPOSAL/particle/SecondaryBuffer.h"
+
+using namespace PROPOSAL;
+
+SecondaryBuffer::SecondaryBuffer()
+    : type_id_()
+    , particle_def_()
+    , x_()
+    , y_()
+    , z_()
+    , direction_x_()
+    , direction_y_()
+    , direction_z_()
+    , energy_()
+    , parent_particle_energy_()
+    , time_()
+    , propagated_distance_()
+    , weight_()
+{
+}
+
+bool SecondaryBuffer::operator==(const SecondaryBuffer& buffer) const
+{
+    if (type_id_ != buffer.type_id_)
+        return false;
+    else if (particle_def_ != buffer.particle_def_)
+        return false;
+    else if (x_ != buffer.x_ || y_ != buffer.y_ || z_ != buffer.z_)
+        return false;
+    else if (direction_x_ != buffer.direction_x_ || direction_y_ != buffer.direction_y_ ||
+             direction_z_ != buffer.direction_z_)
+        return false;
+    else if (energy_ != buffer.energy_)
+        return false;
+    else if (parent_particle_energy_ != buffer.parent_particle_energy_)
+        return false;
+    else if (time_ != buffer.time_)
+        return false;
+    else if (propagated_distance_ != buffer.propagated_distance_)
+        return false;
+    else if (weight_ != buffer.weight_)
+        return false;
+    else
+        return true;
+}
+
+bool SecondaryBuffer::operator!=(const SecondaryBuffer& buffer) const
+{
+    return !(*this == buffer);
+}
+
+// ------------------------------------------------------------------------- //
+void SecondaryBuffer::Push(const Secondary& secondary)
+{
+    type_id_.push_back(secondary.type_id);
+    particle_def_.push_back(secondary.particle_def);
+
+    x_.push_back(secondary.position[0]);
+    y_.push_back(secondary.position[1]);
+    z_.push_back(secondary.position[2]);
+
+    direction_x_.push_back(secondary.direction[0]);
+    direction_y_.push_back(secondary.direction[1]);
+    direction_z_.push_back(secondary.direction[2]);
+
+    energy_.push_back(secondary.energy);
+    parent_particle_energy_.push_back(secondary.parent_particle_energy);
+    time_.push_back(secondary.time);
+    propagated_distance_.push_back(secondary.propagated_distance);
+    weight_.push_back(secondary.weight);
+}
+
+// ------------------------------------------------------------------------- //
+void SecondaryBuffer::Append(const std::vector<Secondary>& secondaries)
+{
+    // Grow all columns once, like a single push_back would do
+    size_t size = GetSize() + secondaries.size();
+
+    if (size > type_id_.capacity())
+    {
+        Reserve(std::max(size, 2 * type_id_.capacity()));
+    }
+
+    for (auto& secondary : secondaries)
+    {
+        Push(secondary);
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void SecondaryBuffer::Reserve(size_t size)
+{
+    type_id_.reserve(size);
+    particle_def_.reserve(size);
+
+    x_.reserve(size);
+    y_.reserve(size);
+    z_.reserve(size);
+
+    direction_x_.reserve(size);
+    direction_y_.reserve(size);
+    direction_z_.reserve(size);
+
+    energy_.reserve(size);
+    parent_particle_energy_.reserve(size);
+    time_.reserve(size);
+    propagated_distance_.reserve(size);
+    weight_.reserve(size);
+}
+
+// ------------------------------------------------------------------------- //
+void SecondaryBuffer::Clear()
+{
+    // The capacity is kept, so the buffer can be reused for the next events
+    type_id_.clear();
+    particle_def_.clear();
+
+    x_.clear();
+    y_.clear();
+    z_.clear();
+
+    direction_x_.clear();
+    direction_y_.clear();
+    direction_z_.clear();
+
+    energy_.clear();
+    parent_particle_energy_.clear();
+    time_.clear();
+    propagated_distance_.clear();
+    weight_.clear();
+}
+
+// ------------------------------------------------------------------------- //
+Secondary SecondaryBuffer::Get(size_t index) const
+{
+    Secondary secondary;
+
+    secondary.type_id      = static_cast<DynamicData::Type>(type_id_.at(index));
+    secondary.particle_def = particle_def_[index];
+
+    secondary.position[0] = x_[index];
+    secondary.position[1] = y_[index];
+    secondary.position[2] = z_[index];
+
+    secondary.direction[0] = direction_x_[index];
+    secondary.direction[1] = direction_y_[index];
+    secondary.direction[2] = direction_z_[index];
+
+    secondary.energy                 = energy_[index];
+    secondary.parent_particle_energy = parent_particle_energy_[index];
+    secondary.time                   = time_[index];
+    secondary.propagated_distance    = propagated_distance_[index];
+    secondary.weight                 = weight_[index];
+
+    return secondary;
+}
@@ -315,9 +315,11 @@ double UtilityDecorator::Calculate(double ei,
                                    double ef,
                                    double rnd,
                                    Vector3D xi,
-                                   Vector3D direction) {
+                                   Vector3D direction,
+                                   const Density_distr& density) {
     (void)xi;
     (void)direction;
+    (void)density;
 
     return this->Calculate(ei, ef, rnd);
 }
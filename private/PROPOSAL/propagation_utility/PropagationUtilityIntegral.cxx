@@ -82,14 +82,14 @@ double UtilityIntegralDisplacement::Calculate(double ei,
                                               double ef,
                                               double distance_to_border,
                                               Vector3D xi,
-                                              Vector3D direction) {
+                                              Vector3D direction,
+                                              const Density_distr& density) {
     double aux = integral_.IntegrateWithRandomRatio(
         ei, ef,
         std::bind(&UtilityIntegralDisplacement::FunctionToIntegral, this,
                   std::placeholders::_1),
         4, -distance_to_border);
-    return utility_.GetMedium().GetDensityDistribution().Correct(
-        xi, direction, aux, distance_to_border);
+    return density.Correct(xi, direction, aux, distance_to_border);
 }
 
 /******************************************************************************
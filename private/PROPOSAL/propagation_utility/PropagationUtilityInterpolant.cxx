@@ -180,7 +180,8 @@ double UtilityInterpolantDisplacement::Calculate(double ei,
                                                  double ef,
                                                  double distance_to_border,
                                                  Vector3D xi,
-                                                 Vector3D direction) {
+                                                 Vector3D direction,
+                                                 const Density_distr& density) {
     /* (void) rnd; */
 
     if (std::abs(ei - ef) > std::abs(ei) * HALF_PRECISION) {
@@ -190,8 +191,7 @@ double UtilityInterpolantDisplacement::Calculate(double ei,
         stored_result_ = interpolant_->Interpolate(ei);
         aux = stored_result_ - interpolant_->Interpolate(ef);
 
-        displacement = utility_.GetMedium().GetDensityDistribution().Correct(
-            xi, direction, aux, distance_to_border);
+        displacement = density.Correct(xi, direction, aux, distance_to_border);
 
         if (std::abs(aux) > std::abs(stored_result_) * HALF_PRECISION) {
             return std::max(displacement, 0.0);
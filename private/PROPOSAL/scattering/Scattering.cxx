@@ -10,6 +10,7 @@
 #include <cmath>
 
 #include "PROPOSAL/math/Vector3D.h"
+#include "PROPOSAL/medium/Medium.h"
 #include "PROPOSAL/particle/Particle.h"
 #include "PROPOSAL/scattering/Scattering.h"
 
@@ -21,11 +22,13 @@ using namespace PROPOSAL;
 
 Scattering::Scattering(Particle& particle)
     : particle_(particle)
+    , density_distr_()
 {
 }
 
 Scattering::Scattering(const Scattering& scattering)
     : particle_(scattering.particle_)
+    , density_distr_(scattering.density_distr_)
 {
 }
 
@@ -44,6 +47,19 @@ bool Scattering::operator!=(const Scattering& scattering) const
     return !(*this == scattering);
 }
 
+void Scattering::SetDensityDistribution(const Density_distr& density_distr)
+{
+    density_distr_.reset(density_distr.clone());
+}
+
+const Density_distr& Scattering::GetDensityDistribution(const Medium& medium) const
+{
+    if (density_distr_)
+        return *density_distr_;
+
+    return medium.GetDensityDistribution();
+}
+
 void Scattering::Scatter(double dr, double ei, double ef)
 {
     double sz, tz;
@@ -56,12 +72,13 @@ void Scattering::Scatter(double dr, double ei, double ef)
     Vector3D position;
     Vector3D direction;
     const Vector3D old_direction = particle_.GetDirection();
+    const Vector3D::SphericalCoordinates spherical = old_direction.GetSphericalCoordinates();
 
     long double sinth, costh, sinph, cosph;
-    sinth = (long double)std::sin(old_direction.GetTheta());
-    costh = (long double)std::cos(old_direction.GetTheta());
-    sinph = (long double)std::sin(old_direction.GetPhi());
-    cosph = (long double)std::cos(old_direction.GetPhi());
+    sinth = (long double)std::sin(spherical.zenith);
+    costh = (long double)std::cos(spherical.zenith);
+    sinph = (long double)std::sin(spherical.azimuth);
+    cosph = (long double)std::cos(spherical.azimuth);
 
     if(dr<=0){
         /*TODO: This statement should be at the beginning of the method to avoid unnecessary sampling of random numbers,
@@ -88,8 +105,6 @@ void Scattering::Scatter(double dr, double ei, double ef)
     direction = direction + random_angles.tx * rotate_vector_x;
     direction = direction + random_angles.ty * rotate_vector_y;
 
-    direction.CalculateSphericalCoordinates();
-
     particle_.SetPosition(position);
     particle_.SetDirection(direction);
 }
@@ -57,7 +57,8 @@ bool ScatteringHighland::compare(const Scattering& scattering) const {
 double ScatteringHighland::CalculateTheta0(double dr) {
     // eq 6 of Lynch, Dahl
     // Nuclear Instruments and Methods in Physics Research Section B 58 (1991)
-    double y = dr / medium_->GetRadiationLength(particle_.GetPosition());
+    double y = dr * GetDensityDistribution(*medium_).Evaluate(particle_.GetPosition()) /
+               medium_->GetRadiationLength();
     double beta =
         1. / sqrt(1 + particle_.GetMass() * particle_.GetMass() /
                           (particle_.GetMomentum() * particle_.GetMomentum()));
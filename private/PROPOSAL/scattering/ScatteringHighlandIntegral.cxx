@@ -95,12 +95,11 @@ bool ScatteringHighlandIntegral::compare(const Scattering& scattering) const
 //----------------------------------------------------------------------------//
 long double ScatteringHighlandIntegral::CalculateTheta0(double dr, double ei, double ef)
 {
-    double aux              = scatter_->Calculate(ei, ef, 0.0) *
-                              scatter_->GetUtility().GetMedium().GetDensityDistribution().Evaluate(
-                                      particle_.GetPosition());
+    const Medium& medium    = scatter_->GetUtility().GetMedium();
+    double density          = GetDensityDistribution(medium).Evaluate(particle_.GetPosition());
+    double aux              = scatter_->Calculate(ei, ef, 0.0) * density;
     double cutoff           = 1;
-    double radiation_length = scatter_->GetUtility().GetMedium().GetRadiationLength(
-                                      particle_.GetPosition());
+    double radiation_length = medium.GetRadiationLength() / density;
 
     aux = 13.6 * std::sqrt(std::max(aux, 0.0) / radiation_length) * std::abs(particle_.GetCharge());
     aux *= std::max(1 + 0.038 * std::log(dr / radiation_length), 0.0);
@@ -46,7 +46,7 @@ Scattering::RandomAngles ScatteringMoliere::CalculateRandomAngle(double dr,
     chiCSq_ =
         ((4. * PI * NA * ALPHA * ALPHA * HBAR * HBAR * SPEED * SPEED) *
          (medium_->GetMassDensity() *
-          medium_->GetDensityDistribution().Evaluate(particle_.GetPosition()) *
+          GetDensityDistribution(*medium_).Evaluate(particle_.GetPosition()) *
           dr) /
          (momentum * momentum * beta_Sq)) *
         ZSq_A_average_;
@@ -2,11 +2,13 @@
 #include "PROPOSAL/Constants.h"
 #include "PROPOSAL/Logging.h"
 #include "PROPOSAL/Output.h"
+#include "PROPOSAL/SurvivalTable.h"
 
 #include "PROPOSAL/crossection/CrossSection.h"
 #include "PROPOSAL/decay/DecayChannel.h"
 
 #include "PROPOSAL/medium/density_distr/density_distr.h"
+#include "PROPOSAL/medium/density_distr/density_homogeneous.h"
 
 #include "PROPOSAL/geometry/Geometry.h"
 #include "PROPOSAL/geometry/Sphere.h"
@@ -22,6 +24,60 @@
 
 using namespace PROPOSAL;
 
+namespace {
+
+// Copy of the medium, whose density distribution tabulates the grammage over
+// the depths covered by the geometry of the sector
+std::shared_ptr<const Medium> TabulateGrammage(const Medium& medium, const Geometry& geometry)
+{
+    std::unique_ptr<Density_distr> density(medium.GetDensityDistribution().clone());
+    density->BuildGrammageTable(geometry);
+
+    std::shared_ptr<Medium> tabulated(medium.clone());
+    tabulated->SetDensityDistribution(*density);
+
+    return tabulated;
+}
+
+// Tables of the energy after a distance for range propagation. They are
+// built by full propagation in the medium at its nominal density, the
+// density distribution of the sector scales the distance. Only the energy
+// matters, so only the losses above 1% of the energy are sampled, which keeps
+// their number independent of the energy. The others are not randomized: the
+// tables are filled in short steps between the distance nodes and the
+// randomization, truncated at the initial energy, biases short steps low.
+std::shared_ptr<SurvivalTable> BuildSurvivalTable(const ParticleDef& particle_def,
+                                                  const Sector::Definition& sector_def,
+                                                  const InterpolationDef& interpolation_def)
+{
+    if (!sector_def.do_range_propagation)
+        return std::shared_ptr<SurvivalTable>();
+
+    std::unique_ptr<Medium> medium(sector_def.GetMedium().clone());
+    Density_homogeneous nominal_density;
+    medium->SetDensityDistribution(nominal_density);
+
+    Sector::Definition table_def = sector_def;
+    table_def.SetMedium(*medium);
+    table_def.cut_settings = EnergyCutSettings(-1, 0.01);
+    table_def.do_continuous_randomization = false;
+    table_def.do_exact_time_calculation = false;
+    table_def.scattering_model = ScatteringFactory::NoScattering;
+
+    // All energies the cross sections are tabulated for. The tables are
+    // interpolated linearly, so six nodes per decade keep the error of the
+    // mean energy loss below a percent between the nodes.
+    SurvivalTable::Definition survival_def;
+    survival_def.energy_min   = particle_def.low;
+    survival_def.energy_max   = interpolation_def.max_node_energy;
+    survival_def.energy_nodes = std::max(2, static_cast<int>(6 * std::log10(survival_def.energy_max / survival_def.energy_min)));
+    survival_def.statistic    = 1000;
+
+    return std::make_shared<SurvivalTable>(particle_def, table_def, interpolation_def, survival_def);
+}
+
+} // namespace
+
 /******************************************************************************
  *                                 Sector                                 *
  ******************************************************************************/
@@ -29,11 +85,13 @@ using namespace PROPOSAL;
 Sector::Definition::Definition()
     : do_stochastic_loss_weighting(false),
       stochastic_loss_weighting(0),
+      interaction_bias(),
       stopping_decay(true),
       do_continuous_randomization(true),
       do_continuous_energy_loss_output(false),
       do_exact_time_calculation(true),
       only_loss_inside_detector(false),
+      do_range_propagation(false),
       scattering_model(ScatteringFactory::HighlandIntegral),
       location(Sector::ParticleLocation::InsideDetector),
       utility_def(),
@@ -44,11 +102,13 @@ Sector::Definition::Definition()
 Sector::Definition::Definition(const Definition& def)
     : do_stochastic_loss_weighting(def.do_stochastic_loss_weighting),
       stochastic_loss_weighting(def.stochastic_loss_weighting),
+      interaction_bias(def.interaction_bias),
       stopping_decay(def.stopping_decay),
       do_continuous_randomization(def.do_continuous_randomization),
       do_continuous_energy_loss_output(def.do_continuous_energy_loss_output),
       do_exact_time_calculation(def.do_exact_time_calculation),
       only_loss_inside_detector(def.only_loss_inside_detector),
+      do_range_propagation(def.do_range_propagation),
       scattering_model(def.scattering_model),
       location(def.location),
       utility_def(def.utility_def),
@@ -61,6 +121,8 @@ bool Sector::Definition::operator==(const Definition& sector_def) const {
         return false;
     else if (stochastic_loss_weighting != sector_def.stochastic_loss_weighting)
         return false;
+    else if (interaction_bias != sector_def.interaction_bias)
+        return false;
     else if (stopping_decay != sector_def.stopping_decay)
         return false;
     else if (do_continuous_randomization !=
@@ -73,6 +135,8 @@ bool Sector::Definition::operator==(const Definition& sector_def) const {
         return false;
     else if (only_loss_inside_detector != sector_def.only_loss_inside_detector)
         return false;
+    else if (do_range_propagation != sector_def.do_range_propagation)
+        return false;
     else if (scattering_model != sector_def.scattering_model)
         return false;
     else if (location != sector_def.location)
@@ -95,12 +159,14 @@ void Sector::Definition::swap(Definition& definition) {
 
     swap(do_stochastic_loss_weighting, definition.do_stochastic_loss_weighting);
     swap(stochastic_loss_weighting, definition.stochastic_loss_weighting);
+    swap(interaction_bias, definition.interaction_bias);
     swap(stopping_decay, definition.stopping_decay);
     swap(do_continuous_randomization, definition.do_continuous_randomization);
     swap(do_continuous_energy_loss_output,
          definition.do_continuous_energy_loss_output);
     swap(do_exact_time_calculation, definition.do_exact_time_calculation);
     swap(only_loss_inside_detector, definition.only_loss_inside_detector);
+    swap(do_range_propagation, definition.do_range_propagation);
     swap(scattering_model, definition.scattering_model);
     swap(location, definition.location);
     swap(utility_def, definition.utility_def);
@@ -121,6 +187,24 @@ Sector::Definition::~Definition() {
     delete geometry_;
 }
 
+bool Sector::Definition::HasSamePhysics(const Definition& sector_def) const {
+    if (do_continuous_randomization != sector_def.do_continuous_randomization)
+        return false;
+    else if (do_exact_time_calculation != sector_def.do_exact_time_calculation)
+        return false;
+    else if (do_range_propagation != sector_def.do_range_propagation)
+        return false;
+    else if (scattering_model != sector_def.scattering_model)
+        return false;
+    else if (utility_def != sector_def.utility_def)
+        return false;
+    else if (GetPropagationCutSettings() != sector_def.GetPropagationCutSettings())
+        return false;
+    else if (!medium_->HasSameComposition(*sector_def.medium_))
+        return false;
+    return true;
+}
+
 void Sector::Definition::SetMedium(const Medium& medium) {
     delete medium_;
     medium_ = medium.clone();
@@ -131,6 +215,14 @@ void Sector::Definition::SetGeometry(const Geometry& geometry) {
     geometry_ = geometry.clone();
 }
 
+EnergyCutSettings Sector::Definition::GetPropagationCutSettings() const {
+    if (do_range_propagation) {
+        // Negative ecut is neglected, so vcut = 1 makes every loss continuous
+        return EnergyCutSettings(-1, 1);
+    }
+    return cut_settings;
+}
+
 // ------------------------------------------------------------------------- //
 // Constructors
 // ------------------------------------------------------------------------- //
@@ -139,26 +231,28 @@ Sector::Sector(Particle& particle, const Definition& sector_def)
     : sector_def_(sector_def),
       particle_(particle),
       geometry_(sector_def.GetGeometry().clone()),
-      utility_(particle_.GetParticleDef(),
-               sector_def.GetMedium(),
-               sector_def.cut_settings,
-               sector_def.utility_def),
-      displacement_calculator_(new UtilityIntegralDisplacement(utility_)),
-      interaction_calculator_(new UtilityIntegralInteraction(utility_)),
-      decay_calculator_(new UtilityIntegralDecay(utility_)),
-      exact_time_calculator_(NULL),
-      cont_rand_(NULL),
+      medium_(TabulateGrammage(sector_def.GetMedium(), sector_def.GetGeometry())),
+      utility_(new Utility(particle_.GetParticleDef(),
+                           sector_def.GetMedium(),
+                           sector_def.GetPropagationCutSettings(),
+                           sector_def.utility_def)),
+      displacement_calculator_(new UtilityIntegralDisplacement(*utility_)),
+      interaction_calculator_(new UtilityIntegralInteraction(*utility_)),
+      decay_calculator_(new UtilityIntegralDecay(*utility_)),
+      exact_time_calculator_(),
+      cont_rand_(),
       scattering_(ScatteringFactory::Get().CreateScattering(
           sector_def_.scattering_model,
           particle_,
-          utility_)) {
+          *utility_)),
+      survival_table_(BuildSurvivalTable(particle_.GetParticleDef(), sector_def, InterpolationDef())) {
     // These are optional, therfore check NULL
     if (sector_def_.do_exact_time_calculation) {
-        exact_time_calculator_ = new UtilityIntegralTime(utility_);
+        exact_time_calculator_.reset(new UtilityIntegralTime(*utility_));
     }
 
     if (sector_def_.do_continuous_randomization) {
-        cont_rand_ = new ContinuousRandomizer(utility_);
+        cont_rand_.reset(new ContinuousRandomizer(*utility_));
     }
 }
 
@@ -168,32 +262,34 @@ Sector::Sector(Particle& particle,
     : sector_def_(sector_def),
       particle_(particle),
       geometry_(sector_def.GetGeometry().clone()),
-      utility_(particle_.GetParticleDef(),
-               sector_def.GetMedium(),
-               sector_def.cut_settings,
-               sector_def.utility_def,
-               interpolation_def),
+      medium_(TabulateGrammage(sector_def.GetMedium(), sector_def.GetGeometry())),
+      utility_(new Utility(particle_.GetParticleDef(),
+                           sector_def.GetMedium(),
+                           sector_def.GetPropagationCutSettings(),
+                           sector_def.utility_def,
+                           interpolation_def)),
       displacement_calculator_(
-          new UtilityInterpolantDisplacement(utility_, interpolation_def)),
+          new UtilityInterpolantDisplacement(*utility_, interpolation_def)),
       interaction_calculator_(
-          new UtilityInterpolantInteraction(utility_, interpolation_def)),
+          new UtilityInterpolantInteraction(*utility_, interpolation_def)),
       decay_calculator_(
-          new UtilityInterpolantDecay(utility_, interpolation_def)),
-      exact_time_calculator_(NULL),
-      cont_rand_(NULL),
+          new UtilityInterpolantDecay(*utility_, interpolation_def)),
+      exact_time_calculator_(),
+      cont_rand_(),
       scattering_(ScatteringFactory::Get().CreateScattering(
           sector_def_.scattering_model,
           particle_,
-          utility_,
-          interpolation_def)) {
+          *utility_,
+          interpolation_def)),
+      survival_table_(BuildSurvivalTable(particle_.GetParticleDef(), sector_def, interpolation_def)) {
     // These are optional, therfore check NULL
     if (sector_def_.do_exact_time_calculation) {
-        exact_time_calculator_ =
-            new UtilityInterpolantTime(utility_, interpolation_def);
+        exact_time_calculator_.reset(
+            new UtilityInterpolantTime(*utility_, interpolation_def));
     }
 
     if (sector_def_.do_continuous_randomization) {
-        cont_rand_ = new ContinuousRandomizer(utility_, interpolation_def);
+        cont_rand_.reset(new ContinuousRandomizer(*utility_, interpolation_def));
     }
 }
 
@@ -201,13 +297,15 @@ Sector::Sector(Particle& particle, const Sector& sector)
     : sector_def_(sector.sector_def_),
       particle_(particle),
       geometry_(sector.geometry_->clone()),
-      utility_(sector.utility_),
-      displacement_calculator_(sector.displacement_calculator_->clone(utility_)),
-      interaction_calculator_(sector.interaction_calculator_->clone(utility_)),
-      decay_calculator_(sector.decay_calculator_->clone(utility_)),
-      exact_time_calculator_(NULL),
-      cont_rand_(NULL),
-      scattering_(sector.scattering_->clone(particle_, utility_))
+      medium_(sector.medium_),
+      utility_(new Utility(*sector.utility_)),
+      displacement_calculator_(sector.displacement_calculator_->clone(*utility_)),
+      interaction_calculator_(sector.interaction_calculator_->clone(*utility_)),
+      decay_calculator_(sector.decay_calculator_->clone(*utility_)),
+      exact_time_calculator_(),
+      cont_rand_(),
+      scattering_(sector.scattering_->clone(particle_, *utility_)),
+      survival_table_()
 {
     if (particle.GetParticleDef() != sector.GetParticle().GetParticleDef())
     {
@@ -215,12 +313,52 @@ Sector::Sector(Particle& particle, const Sector& sector)
     }
 
     // These are optional, therfore check NULL
-    if (sector.exact_time_calculator_ != NULL) {
-        exact_time_calculator_ = sector.exact_time_calculator_->clone(utility_);
+    if (sector.exact_time_calculator_) {
+        exact_time_calculator_.reset(sector.exact_time_calculator_->clone(*utility_));
+    }
+
+    if (sector.cont_rand_) {
+        cont_rand_.reset(new ContinuousRandomizer(*utility_, *sector.cont_rand_));
+    }
+
+    if (sector.survival_table_) {
+        survival_table_.reset(new SurvivalTable(*sector.survival_table_));
+    }
+
+    scattering_->SetDensityDistribution(medium_->GetDensityDistribution());
+}
+
+Sector::Sector(Particle& particle, const Definition& sector_def, const Sector& physics)
+    : sector_def_(sector_def),
+      particle_(particle),
+      geometry_(sector_def.GetGeometry().clone()),
+      medium_(TabulateGrammage(sector_def.GetMedium(), sector_def.GetGeometry())),
+      utility_(physics.utility_),
+      displacement_calculator_(physics.displacement_calculator_),
+      interaction_calculator_(physics.interaction_calculator_),
+      decay_calculator_(physics.decay_calculator_),
+      exact_time_calculator_(physics.exact_time_calculator_),
+      cont_rand_(physics.cont_rand_),
+      scattering_(physics.scattering_),
+      survival_table_(physics.survival_table_)
+{
+    if (particle.GetParticleDef() != physics.GetParticle().GetParticleDef())
+    {
+        log_fatal("Particle definition should be equal to the sector particle definition!");
+    }
+
+    if (!sector_def.HasSamePhysics(physics.sector_def_))
+    {
+        log_fatal("The physics of the sector definitions differ, so they cannot be shared!");
     }
 
-    if (sector.cont_rand_ != NULL) {
-        cont_rand_ = new ContinuousRandomizer(utility_, *sector.cont_rand_);
+    // The scattering keeps a reference to the particle it deflects and
+    // evaluates the density at its position
+    bool same_density = medium_->GetDensityDistribution() == physics.medium_->GetDensityDistribution();
+
+    if (&particle != &physics.particle_ || !same_density) {
+        scattering_.reset(physics.scattering_->clone(particle_, *utility_));
+        scattering_->SetDensityDistribution(medium_->GetDensityDistribution());
     }
 }
 
@@ -228,21 +366,27 @@ Sector::Sector(const Sector& sector)
     : sector_def_(sector.sector_def_),
       particle_(sector.particle_),
       geometry_(sector.geometry_->clone()),
-      utility_(sector.utility_),
+      medium_(sector.medium_),
+      utility_(new Utility(*sector.utility_)),
       displacement_calculator_(
-          sector.displacement_calculator_->clone(utility_)),
-      interaction_calculator_(sector.interaction_calculator_->clone(utility_)),
-      decay_calculator_(sector.decay_calculator_->clone(utility_)),
-      exact_time_calculator_(NULL),
-      cont_rand_(NULL),
-      scattering_(sector.scattering_->clone()) {
+          sector.displacement_calculator_->clone(*utility_)),
+      interaction_calculator_(sector.interaction_calculator_->clone(*utility_)),
+      decay_calculator_(sector.decay_calculator_->clone(*utility_)),
+      exact_time_calculator_(),
+      cont_rand_(),
+      scattering_(sector.scattering_->clone()),
+      survival_table_() {
     // These are optional, therfore check NULL
-    if (sector.exact_time_calculator_ != NULL) {
-        exact_time_calculator_ = sector.exact_time_calculator_->clone(utility_);
+    if (sector.exact_time_calculator_) {
+        exact_time_calculator_.reset(sector.exact_time_calculator_->clone(*utility_));
     }
 
-    if (sector.cont_rand_ != NULL) {
-        cont_rand_ = new ContinuousRandomizer(utility_, *sector.cont_rand_);
+    if (sector.cont_rand_) {
+        cont_rand_.reset(new ContinuousRandomizer(*utility_, *sector.cont_rand_));
+    }
+
+    if (sector.survival_table_) {
+        survival_table_.reset(new SurvivalTable(*sector.survival_table_));
     }
 }
 
@@ -253,7 +397,7 @@ bool Sector::operator==(const Sector& sector) const {
         return false;
     else if (*geometry_ != *sector.geometry_)
         return false;
-    else if (utility_ != sector.utility_)
+    else if (*utility_ != *sector.utility_)
         return false;
     else if (*cont_rand_ != *sector.cont_rand_)
         return false;
@@ -268,20 +412,12 @@ bool Sector::operator!=(const Sector& sector) const {
 
 Sector::~Sector() {
     delete geometry_;
-    delete scattering_;
-
-    delete displacement_calculator_;
-    delete interaction_calculator_;
-    delete decay_calculator_;
-
-    // These are optional, therfore check NULL
-    if (exact_time_calculator_) {
-        delete exact_time_calculator_;
-    }
+}
 
-    if (cont_rand_) {
-        delete cont_rand_;
-    }
+// ------------------------------------------------------------------------- //
+double Sector::Propagate(double distance, SecondarySink& sink) {
+    ScopedSecondarySink scoped_sink(sink);
+    return Propagate(distance);
 }
 
 // ------------------------------------------------------------------------- //
@@ -297,12 +433,6 @@ double Sector::Propagate(double distance) {
     bool is_decayed = false;
     bool particle_interaction = false;
 
-    std::vector<Particle*> products;
-
-    std::pair<double, DynamicData::Type> energy_loss;
-
-    DynamicData* continuous_loss = NULL;
-
     // TODO(mario): check Fri 2017/08/25
     // int secondary_id    =   0;
 
@@ -321,177 +451,311 @@ double Sector::Propagate(double distance) {
         flag = true;
     }
 
+    if (flag && survival_table_) {
+        final_energy = PropagateRange(distance, propagated_distance);
+        flag = false;
+    }
+
     while (flag) {
         energy_till_stochastic_ = CalculateEnergyTillStochastic(initial_energy);
 
-        if (energy_till_stochastic_.first > energy_till_stochastic_.second) {
-            particle_interaction = true;
-            final_energy = energy_till_stochastic_.first;
-        } else {
-            particle_interaction = false;
-            final_energy = energy_till_stochastic_.second;
+        final_energy = ChooseFinalEnergy(energy_till_stochastic_, particle_interaction);
+
+        displacement = CalculateDisplacement(initial_energy,
+                                             final_energy,
+                                             distance - propagated_distance,
+                                             particle_.GetPosition(),
+                                             particle_.GetDirection());
+
+        if (!MakeStep(initial_energy,
+                      final_energy,
+                      displacement,
+                      distance,
+                      propagated_distance,
+                      particle_interaction,
+                      is_decayed)) {
+            break;
         }
 
-        try {
-            displacement = displacement_calculator_->Calculate(
-                initial_energy, final_energy, distance - propagated_distance,
-                particle_.GetPosition(), particle_.GetDirection());
-        } catch (DensityException& e) {
-            displacement = distance - propagated_distance;
+        // Next round: update the initial energy
+        initial_energy = final_energy;
+    }
 
-            double displacement_aequivaltent =
-                utility_.GetMedium().GetDensityDistribution().Calculate(
-                    particle_.GetPosition(), particle_.GetDirection(),
-                    displacement);
+    // if a particle is below a specific energy 'elow' and stopping_decay is
+    // enabled, the muon gets forced to decay, instead of propagating all the
+    // time with dEdx with no significantly produced light
+    if (sector_def_.stopping_decay && propagated_distance != distance &&
+        !is_decayed) {
+        MakeStoppingDecay();
 
-            final_energy = displacement_calculator_->GetUpperLimit(
-                initial_energy, displacement_aequivaltent);
-        }
+        final_energy = particle_.GetMass();
+    }
 
-        // The first interaction or decay happens behind the distance we want to
-        // propagate So we calculate the final energy using only continuous
-        // losses
-        if (displacement > distance - propagated_distance) {
-            displacement = distance - propagated_distance;
+    particle_.SetEnergy(final_energy);
 
-            double displacement_aequivaltent =
-                utility_.GetMedium().GetDensityDistribution().Calculate(
-                    particle_.GetPosition(), particle_.GetDirection(),
-                    displacement);
+    // Particle reached the border, final energy is returned
+    if (propagated_distance == distance) {
+        return final_energy;
+    }
+    // The particle stopped/decayed, the propagated distance is return with a
+    // minus sign
+    else {
+        return -propagated_distance;
+    }
+}
 
-            final_energy = displacement_calculator_->GetUpperLimit(
-                initial_energy, displacement_aequivaltent);
-        }
+// ------------------------------------------------------------------------- //
+double Sector::PropagateRange(double distance, double& propagated_distance) {
+    double max_grammage = survival_table_->GetDefinition().distance_max;
+    double energy = particle_.GetEnergy();
+
+    while (propagated_distance < distance && energy > particle_.GetLow()) {
+        Vector3D position = particle_.GetPosition();
+        Vector3D direction = particle_.GetDirection();
+
+        // Distance at the nominal density, it is negative against the axis of
+        // the density distribution
+        auto grammage = [&](double step) {
+            return std::abs(medium_->GetDensityDistribution().Calculate(position, direction, step));
+        };
+
+        Secondary continuous_loss;
 
         if (sector_def_.do_continuous_energy_loss_output) {
-            continuous_loss =
-                new DynamicData(DynamicData::ContinuousEnergyLoss);
-            continuous_loss->SetPosition(particle_.GetPosition());
-            continuous_loss->SetTime(particle_.GetTime());
-            continuous_loss->SetParentParticleEnergy(particle_.GetEnergy());
-            continuous_loss->SetPropagatedDistance(
-                particle_.GetPropagatedDistance());
+            continuous_loss.type_id = DynamicData::ContinuousEnergyLoss;
+            continuous_loss.particle_def = NULL;
+            continuous_loss.SetPosition(position);
+            continuous_loss.time = particle_.GetTime();
+            continuous_loss.parent_particle_energy = energy;
+            continuous_loss.propagated_distance = particle_.GetPropagatedDistance();
+            continuous_loss.weight = particle_.GetWeight();
+        }
+
+        // The tables reach up to their largest distance, longer distances
+        // are propagated piece by piece. Close to the end of the range the
+        // survival changes steeply between the energy nodes, so a step loses
+        // at most half of the energy on average, until the particle stops.
+        double max_step_grammage = max_grammage;
+        if (energy > 2 * particle_.GetLow()) {
+            max_step_grammage = std::min(max_step_grammage,
+                                         displacement_calculator_->Calculate(energy, 0.5 * energy, 0.));
+        }
+
+        double step = distance - propagated_distance;
+        while (grammage(step) > max_step_grammage) {
+            step *= 0.5;
         }
 
-        // Advance the Particle according to the displacement
-        // Initial energy and final energy are needed if Molier Scattering is
-        // enabled
-        AdvanceParticle(displacement, initial_energy, final_energy);
+        double rnd = RandomGenerator::Get().RandomDouble();
+        double final_energy = survival_table_->SampleEnergy(energy, grammage(step), rnd);
+
+        // The particle does not survive the step. It stops, where its
+        // survival probability falls below the random number.
+        if (final_energy <= 0) {
+            double lower = 0;
+            double upper = step;
 
-        propagated_distance += displacement;
+            while (upper - lower > PARTICLE_POSITION_RESOLUTION) {
+                double middle = 0.5 * (lower + upper);
+
+                if (survival_table_->GetSurvivalProbability(energy, grammage(middle)) > rnd) {
+                    lower = middle;
+                } else {
+                    upper = middle;
+                }
+            }
+
+            step = upper;
+            final_energy = particle_.GetLow();
+        }
+
+        AdvanceParticle(step, energy, final_energy);
+
+        propagated_distance += step;
 
         if (std::abs(distance - propagated_distance) <
             std::abs(distance) * COMPUTER_PRECISION) {
             propagated_distance = distance;  // computer precision control
         }
 
-        if (cont_rand_) {
-            if (final_energy != particle_.GetLow()) {
-                final_energy = cont_rand_->Randomize(
-                    initial_energy, final_energy,
-                    RandomGenerator::Get().RandomDouble());
-            }
-        }
-
         if (sector_def_.do_continuous_energy_loss_output) {
-            continuous_loss->SetEnergy(initial_energy - final_energy);
-            continuous_loss->SetDirection(particle_.GetDirection());
-            continuous_loss->SetPropagatedDistance(
+            continuous_loss.energy = energy - final_energy;
+            continuous_loss.SetDirection(particle_.GetDirection());
+            continuous_loss.propagated_distance =
                 particle_.GetPropagatedDistance() -
-                continuous_loss->GetPropagatedDistance());
-            if (sector_def_.only_loss_inside_detector) {
-                if (sector_def_.location ==
-                    Sector::ParticleLocation::InsideDetector) {
-                    Output::getInstance().FillSecondaryVector(continuous_loss);
-                }
-                else
-                {
-                    delete continuous_loss;
-                }
-            }
-            else
-            {
+                continuous_loss.propagated_distance;
+            if (!sector_def_.only_loss_inside_detector ||
+                sector_def_.location == Sector::ParticleLocation::InsideDetector) {
                 Output::getInstance().FillSecondaryVector(continuous_loss);
             }
         }
 
-        // Lower limit of particle energy is reached or
-        // or complete particle is propagated the whole distance
-        if (final_energy == particle_.GetLow() ||
-            propagated_distance == distance) {
-            break;
+        energy = final_energy;
+        particle_.SetEnergy(energy);
+    }
+
+    return energy;
+}
+
+// ------------------------------------------------------------------------- //
+double Sector::ChooseFinalEnergy(const std::pair<double, double>& energy_till_stochastic,
+                                 bool& particle_interaction) {
+    double final_energy;
+
+    if (energy_till_stochastic.first > energy_till_stochastic.second) {
+        particle_interaction = true;
+        final_energy = energy_till_stochastic.first;
+    } else {
+        particle_interaction = false;
+        final_energy = energy_till_stochastic.second;
+    }
+
+    return final_energy;
+}
+
+// ------------------------------------------------------------------------- //
+double Sector::CalculateDisplacement(double initial_energy,
+                                     double& final_energy,
+                                     double max_distance,
+                                     const Vector3D& position,
+                                     const Vector3D& direction) {
+    double displacement;
+
+    try {
+        displacement = displacement_calculator_->Calculate(initial_energy,
+                                                           final_energy,
+                                                           max_distance,
+                                                           position,
+                                                           direction,
+                                                           medium_->GetDensityDistribution());
+    } catch (DensityException& e) {
+        displacement = max_distance;
+
+        double displacement_aequivaltent =
+            medium_->GetDensityDistribution().Calculate(
+                position, direction, displacement);
+
+        final_energy = displacement_calculator_->GetUpperLimit(
+            initial_energy, displacement_aequivaltent);
+    }
+
+    // The first interaction or decay happens behind the distance we want to
+    // propagate So we calculate the final energy using only continuous
+    // losses
+    if (displacement > max_distance) {
+        displacement = max_distance;
+
+        double displacement_aequivaltent =
+            medium_->GetDensityDistribution().Calculate(
+                position, direction, displacement);
+
+        final_energy = displacement_calculator_->GetUpperLimit(
+            initial_energy, displacement_aequivaltent);
+    }
+
+    return displacement;
+}
+
+// ------------------------------------------------------------------------- //
+bool Sector::MakeStep(double initial_energy,
+                      double& final_energy,
+                      double displacement,
+                      double distance,
+                      double& propagated_distance,
+                      bool particle_interaction,
+                      bool& is_decayed) {
+    std::vector<Particle*> products;
+
+    std::pair<double, DynamicData::Type> energy_loss;
+
+    Secondary continuous_loss;
+
+    if (sector_def_.do_continuous_energy_loss_output) {
+        continuous_loss.type_id = DynamicData::ContinuousEnergyLoss;
+        continuous_loss.particle_def = NULL;
+        continuous_loss.SetPosition(particle_.GetPosition());
+        continuous_loss.time = particle_.GetTime();
+        continuous_loss.parent_particle_energy = particle_.GetEnergy();
+        continuous_loss.propagated_distance =
+            particle_.GetPropagatedDistance();
+        continuous_loss.weight = particle_.GetWeight();
+    }
+
+    // Advance the Particle according to the displacement
+    // Initial energy and final energy are needed if Molier Scattering is
+    // enabled
+    AdvanceParticle(displacement, initial_energy, final_energy);
+
+    propagated_distance += displacement;
+
+    if (std::abs(distance - propagated_distance) <
+        std::abs(distance) * COMPUTER_PRECISION) {
+        propagated_distance = distance;  // computer precision control
+    }
+
+    if (cont_rand_) {
+        if (final_energy != particle_.GetLow()) {
+            final_energy = cont_rand_->Randomize(
+                initial_energy, final_energy,
+                RandomGenerator::Get().RandomDouble());
         }
+    }
 
-        // Set the particle energy to the current energy before making
-        // stochastic losses or decay
-        particle_.SetEnergy(final_energy);
-
-        if (particle_interaction){
-            std::tuple<double, DynamicData::Type, std::pair<std::vector<Particle*>, bool> > aux = MakeStochasticLoss(final_energy);
-
-            energy_loss = std::make_pair(std::get<0>(aux), std::get<1>(aux));
-            products    = std::get<2>(aux).first;
-
-            if (energy_loss.second == DynamicData::None) {
-                // in this case, no cross section is chosen, so there is no
-                // interaction due to the parameterization of the cross section
-                // cutoffs
-                log_debug(
-                    "no interaction due to the parameterization of the cross "
-                    "section cutoffs. final energy: %f\n",
-                    final_energy);
-                initial_energy = final_energy;
-                continue;
+    if (sector_def_.do_continuous_energy_loss_output) {
+        continuous_loss.energy = initial_energy - final_energy;
+        continuous_loss.SetDirection(particle_.GetDirection());
+        continuous_loss.propagated_distance =
+            particle_.GetPropagatedDistance() -
+            continuous_loss.propagated_distance;
+        if (sector_def_.only_loss_inside_detector) {
+            if (sector_def_.location ==
+                Sector::ParticleLocation::InsideDetector) {
+                Output::getInstance().FillSecondaryVector(continuous_loss);
             }
+        }
+        else
+        {
+            Output::getInstance().FillSecondaryVector(continuous_loss);
+        }
+    }
 
-            if(!products.empty()){
-                // add produced particles to SecondaryVector
-                for(unsigned int i=0; i<products.size(); i++){
-                    products[i]->SetPosition(particle_.GetPosition());
-                    products[i]->SetTime(particle_.GetTime());
-                    products[i]->SetParentParticleEnergy(particle_.GetEnergy());
-                }
+    // Lower limit of particle energy is reached or
+    // or complete particle is propagated the whole distance
+    if (final_energy == particle_.GetLow() ||
+        propagated_distance == distance) {
+        return false;
+    }
 
-                if (sector_def_.only_loss_inside_detector)
-                {
-                    if (sector_def_.location == Sector::ParticleLocation::InsideDetector)
-                    {
-                        Output::getInstance().FillSecondaryVector(products);
-                    }
-                }
-                else
-                {
-                    Output::getInstance().FillSecondaryVector(products);
-                }
-            }
+    // Set the particle energy to the current energy before making
+    // stochastic losses or decay
+    particle_.SetEnergy(final_energy);
 
-            if(energy_loss.second != DynamicData::Particle){
-                // DynamicData::Particle means no DynamicData object will be added to SecondaryVector
-                // add energy loss with DynamicData to SecondaryVector
-                if (sector_def_.only_loss_inside_detector)
-                {
-                    if (sector_def_.location == Sector::ParticleLocation::InsideDetector)
-                    {
-                        Output::getInstance().FillSecondaryVector(particle_, energy_loss.second, energy_loss.first);
-                    }
-                } else {
-                    Output::getInstance().FillSecondaryVector(
-                        particle_, energy_loss.second, energy_loss.first);
-                }
-            }
+    if (particle_interaction){
+        std::tuple<double, DynamicData::Type, std::pair<std::vector<Particle*>, bool> > aux = MakeStochasticLoss(final_energy);
+
+        energy_loss = std::make_pair(std::get<0>(aux), std::get<1>(aux));
+        products    = std::get<2>(aux).first;
+
+        if (energy_loss.second == DynamicData::None) {
+            // in this case, no cross section is chosen, so there is no
+            // interaction due to the parameterization of the cross section
+            // cutoffs
+            log_debug(
+                "no interaction due to the parameterization of the cross "
+                "section cutoffs. final energy: %f\n",
+                final_energy);
+            return true;
+        }
 
-            if(std::get<2>(aux).second == true){
-                // fatal loss -> initial particle is destroyed
-                is_decayed = true;
-                final_energy -= energy_loss.first;
-                break;
+        if(!products.empty()){
+            // add produced particles to SecondaryVector
+            for(unsigned int i=0; i<products.size(); i++){
+                products[i]->SetPosition(particle_.GetPosition());
+                products[i]->SetTime(particle_.GetTime());
+                products[i]->SetParentParticleEnergy(particle_.GetEnergy());
+                products[i]->SetWeight(particle_.GetWeight());
             }
 
-            final_energy -= energy_loss.first;
-
-        }else
-        {
-            products = particle_.GetDecayTable().SelectChannel().Decay(particle_);
             if (sector_def_.only_loss_inside_detector)
             {
                 if (sector_def_.location == Sector::ParticleLocation::InsideDetector)
@@ -503,40 +767,39 @@ double Sector::Propagate(double distance) {
             {
                 Output::getInstance().FillSecondaryVector(products);
             }
-
-            is_decayed = true;
-            final_energy = particle_.GetMass();
-
-            // log_debug("Sampled decay of particle: %s",
-            // particle_->GetName().c_str()); secondary_id    =
-            // particle_->GetParticleId()  +   1;
         }
 
-        // break if the lower limit of particle energy is reached
-        if (final_energy <= particle_.GetLow()) {
-            break;
+        if(energy_loss.second != DynamicData::Particle){
+            // DynamicData::Particle means no DynamicData object will be added to SecondaryVector
+            // add energy loss with DynamicData to SecondaryVector
+            if (sector_def_.only_loss_inside_detector)
+            {
+                if (sector_def_.location == Sector::ParticleLocation::InsideDetector)
+                {
+                    Output::getInstance().FillSecondaryVector(particle_, energy_loss.second, energy_loss.first);
+                }
+            } else {
+                Output::getInstance().FillSecondaryVector(
+                    particle_, energy_loss.second, energy_loss.first);
+            }
         }
 
-        // Next round: update the initial energy
-        initial_energy = final_energy;
-    }
-
-    // if a particle is below a specific energy 'elow' and stopping_decay is
-    // enabled, the muon gets forced to decay, instead of propagating all the
-    // time with dEdx with no significantly produced light
-    if (sector_def_.stopping_decay && propagated_distance != distance &&
-        !is_decayed) {
-        // The time is shifted due to the exponential lifetime.
-        double particle_time = particle_.GetTime();
-        particle_time -= particle_.GetLifetime() *
-                         std::log(RandomGenerator::Get().RandomDouble());
-        particle_.SetTime(particle_time);
+        if(std::get<2>(aux).second == true){
+            // fatal loss -> initial particle is destroyed
+            is_decayed = true;
+            final_energy -= energy_loss.first;
+            return false;
+        }
 
-        // TODO: one should also advance the particle according to the sampeled
-        // time and set the new position as the endpoint.
-        particle_.SetEnergy(particle_.GetMass());
+        final_energy -= energy_loss.first;
 
+    }else
+    {
         products = particle_.GetDecayTable().SelectChannel().Decay(particle_);
+        for (auto product : products) {
+            product->SetWeight(particle_.GetWeight());
+        }
+
         if (sector_def_.only_loss_inside_detector)
         {
             if (sector_def_.location == Sector::ParticleLocation::InsideDetector)
@@ -547,30 +810,70 @@ double Sector::Propagate(double distance) {
         else
         {
             Output::getInstance().FillSecondaryVector(products);
-
         }
 
+        is_decayed = true;
         final_energy = particle_.GetMass();
+
+        // log_debug("Sampled decay of particle: %s",
+        // particle_->GetName().c_str()); secondary_id    =
+        // particle_->GetParticleId()  +   1;
     }
 
-    particle_.SetEnergy(final_energy);
+    // break if the lower limit of particle energy is reached
+    if (final_energy <= particle_.GetLow()) {
+        return false;
+    }
 
-    // Particle reached the border, final energy is returned
-    if (propagated_distance == distance) {
-        return final_energy;
+    return true;
+}
+
+// ------------------------------------------------------------------------- //
+void Sector::MakeStoppingDecay() {
+    std::vector<Particle*> products;
+
+    // The time is shifted due to the exponential lifetime.
+    double particle_time = particle_.GetTime();
+    particle_time -= particle_.GetLifetime() *
+                     std::log(RandomGenerator::Get().RandomDouble());
+    particle_.SetTime(particle_time);
+
+    // TODO: one should also advance the particle according to the sampeled
+    // time and set the new position as the endpoint.
+    particle_.SetEnergy(particle_.GetMass());
+
+    products = particle_.GetDecayTable().SelectChannel().Decay(particle_);
+    for (auto product : products) {
+        product->SetWeight(particle_.GetWeight());
     }
-    // The particle stopped/decayed, the propagated distance is return with a
-    // minus sign
-    else {
-        return -propagated_distance;
+
+    if (sector_def_.only_loss_inside_detector)
+    {
+        if (sector_def_.location == Sector::ParticleLocation::InsideDetector)
+        {
+            Output::getInstance().FillSecondaryVector(products);
+        }
+    }
+    else
+    {
+        Output::getInstance().FillSecondaryVector(products);
+
     }
 }
 
+// ------------------------------------------------------------------------- //
 std::pair<double, double> Sector::CalculateEnergyTillStochastic(
     double initial_energy) {
     double rndd = -std::log(RandomGenerator::Get().RandomDouble());
     double rndi = -std::log(RandomGenerator::Get().RandomDouble());
 
+    return CalculateEnergyTillStochastic(
+        initial_energy, rndd, rndi, particle_.GetPosition());
+}
+
+// ------------------------------------------------------------------------- //
+std::pair<double, double> Sector::CalculateEnergyTillStochastic(
+    double initial_energy, double rndd, double rndi, const Vector3D& position) {
     double rndiMin = 0;
     double rnddMin = 0;
 
@@ -582,8 +885,7 @@ std::pair<double, double> Sector::CalculateEnergyTillStochastic(
     } else {
         rnddMin = decay_calculator_->Calculate(
                       initial_energy, particle_.GetParticleDef().low, rndd) /
-                  utility_.GetMedium().GetDensityDistribution().Evaluate(
-                      particle_.GetPosition());
+                  medium_->GetDensityDistribution().Evaluate(position);
     }
 
     rndiMin = interaction_calculator_->Calculate(
@@ -595,8 +897,7 @@ std::pair<double, double> Sector::CalculateEnergyTillStochastic(
     } else {
         final.second = decay_calculator_->GetUpperLimit(
             initial_energy,
-            rndd * utility_.GetMedium().GetDensityDistribution().Evaluate(
-                       particle_.GetPosition()));
+            rndd * medium_->GetDensityDistribution().Evaluate(position));
     }
 
     if (rndi >= rndiMin || rndiMin <= 0) {
@@ -619,7 +920,7 @@ void Sector::AdvanceParticle(double dr, double ei, double ef) {
         // DensityDistribution Approximation: Use the DensityDistribution at the
         // position of initial energy
         time += exact_time_calculator_->Calculate(ei, ef, 0.0) /
-                utility_.GetMedium().GetDensityDistribution().Evaluate(
+                medium_->GetDensityDistribution().Evaluate(
                     particle_.GetPosition());
     } else {
         time += dr / SPEED;
@@ -641,7 +942,7 @@ std::tuple<double, DynamicData::Type, std::pair<std::vector<Particle*>, bool> >
     double total_rate_weighted = 0;
     double rates_sum = 0;
 
-    std::vector<CrossSection*> cross_sections = utility_.GetCrosssections();
+    std::vector<CrossSection*> cross_sections = utility_->GetCrosssections();
 
     // return 0 and unknown, if there is no interaction
     std::pair<double, DynamicData::Type> energy_loss;
@@ -654,7 +955,17 @@ std::tuple<double, DynamicData::Type, std::pair<std::vector<Particle*>, bool> >
 
     rates.resize(cross_sections.size());
 
+    // The weight of the particle is multiplied with the likelihood ratio
+    // of the unbiased and the biased sampling, so weighted results are
+    // unbiased.
+    double weight = 1.;
+
     if (sector_def_.do_stochastic_loss_weighting) {
+        // rnd2 is the fraction of the rate up to the sampled loss, so the
+        // ratio of the densities is the derivative of the transformation.
+        double exponent = std::abs(sector_def_.stochastic_loss_weighting);
+        weight = (1 + exponent) * std::pow(rnd2, exponent);
+
         if (sector_def_.stochastic_loss_weighting > 0) {
             rnd2 =
                 1 - rnd2 * std::pow(
@@ -672,6 +983,25 @@ std::tuple<double, DynamicData::Type, std::pair<std::vector<Particle*>, bool> >
         total_rate += rates[i];
     }
 
+    // The interaction type is chosen with the biased rates. As the total
+    // rate is not changed, the ratio of the choice probabilities is the
+    // likelihood ratio.
+    double total_rate_unbiased = total_rate;
+
+    if (!sector_def_.interaction_bias.empty()) {
+        total_rate = 0;
+
+        for (unsigned int i = 0; i < cross_sections.size(); i++) {
+            auto bias = sector_def_.interaction_bias.find(
+                cross_sections[i]->GetTypeId());
+
+            if (bias != sector_def_.interaction_bias.end()) {
+                rates[i] *= bias->second;
+            }
+            total_rate += rates[i];
+        }
+    }
+
     total_rate_weighted = total_rate * rnd1;
 
     log_debug("Total rate = %f, total rate weighted = %f", total_rate,
@@ -681,6 +1011,16 @@ std::tuple<double, DynamicData::Type, std::pair<std::vector<Particle*>, bool> >
         rates_sum += rates[i];
 
         if (rates_sum >= total_rate_weighted) {
+            auto bias = sector_def_.interaction_bias.find(
+                cross_sections[i]->GetTypeId());
+
+            if (bias != sector_def_.interaction_bias.end()) {
+                weight *= total_rate / (total_rate_unbiased * bias->second);
+            } else if (!sector_def_.interaction_bias.empty()) {
+                weight *= total_rate / total_rate_unbiased;
+            }
+            particle_.SetWeight(particle_.GetWeight() * weight);
+
             energy_loss.first = cross_sections[i]->CalculateStochasticLoss(
                 particle_energy, rnd2, rnd3);
             energy_loss.second = cross_sections[i]->GetTypeId();
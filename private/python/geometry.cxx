@@ -21,7 +21,9 @@ void init_geometry(py::module& m) {
     py::enum_<GeometryFactory::Enum>(m_sub, "Shape")
         .value("Sphere", GeometryFactory::Sphere)
         .value("Box", GeometryFactory::Box)
-        .value("Cylinder", GeometryFactory::Cylinder);
+        .value("Cylinder", GeometryFactory::Cylinder)
+        .value("ExtrudedPolygon", GeometryFactory::ExtrudedPolygon)
+        .value("TriangleMesh", GeometryFactory::TriangleMesh);
 
     py::class_<GeometryFactory::Definition,
                std::shared_ptr<GeometryFactory::Definition>>(
@@ -55,6 +57,16 @@ void init_geometry(py::module& m) {
         .def_readwrite("depth", &GeometryFactory::Definition::depth,
                        R"pbdoc(
                 depth of type :meth:`Box`
+            )pbdoc")
+        .def_readwrite("vertices", &GeometryFactory::Definition::vertices,
+                       R"pbdoc(
+                corners of type :meth:`ExtrudedPolygon` or vertices
+                of type :meth:`TriangleMesh`
+            )pbdoc")
+        .def_readwrite("triangles", &GeometryFactory::Definition::triangles,
+                       R"pbdoc(
+                indices of the vertices of the triangles of type
+                :meth:`TriangleMesh`
             )pbdoc");
 
     py::class_<Geometry, std::shared_ptr<Geometry>>(m_sub, "Geometry")
@@ -191,4 +203,48 @@ void init_geometry(py::module& m) {
                       R"pbdoc(
                 height of the cylinder
             )pbdoc");
+
+    py::class_<ExtrudedPolygon, std::shared_ptr<ExtrudedPolygon>, Geometry>(
+        m_sub, "ExtrudedPolygon",
+        R"pbdoc(
+                A polygon in the x-y plane, which is extruded along
+                the z-axis. The z coordinates of the corners are
+                ignored.
+            )pbdoc")
+        .def(py::init<>())
+        .def(py::init<Vector3D, const std::vector<Vector3D>&, double>(),
+             py::arg("position"), py::arg("vertices"), py::arg("height"))
+        .def(py::init<const ExtrudedPolygon&>())
+        .def_property("vertices", &ExtrudedPolygon::GetVertices,
+                      &ExtrudedPolygon::SetVertices,
+                      R"pbdoc(
+                corners of the polygon relative to the position
+            )pbdoc")
+        .def_property("height", &ExtrudedPolygon::GetHeight,
+                      &ExtrudedPolygon::SetHeight,
+                      R"pbdoc(
+                height of the extruded polygon
+            )pbdoc");
+
+    py::class_<TriangleMesh, std::shared_ptr<TriangleMesh>, Geometry>(
+        m_sub, "TriangleMesh",
+        R"pbdoc(
+                A closed surface of triangles. Every edge must be
+                shared by exactly two triangles.
+            )pbdoc")
+        .def(py::init<>())
+        .def(py::init<Vector3D, const std::vector<Vector3D>&,
+                      const std::vector<TriangleMesh::Triangle>&>(),
+             py::arg("position"), py::arg("vertices"), py::arg("triangles"))
+        .def(py::init<const TriangleMesh&>())
+        .def_property_readonly("vertices", &TriangleMesh::GetVertices,
+                               R"pbdoc(
+                vertices relative to the position
+            )pbdoc")
+        .def_property_readonly("triangles", &TriangleMesh::GetTriangles,
+                               R"pbdoc(
+                indices of the vertices of the triangles
+            )pbdoc")
+        .def("set_mesh", &TriangleMesh::SetMesh, py::arg("vertices"),
+             py::arg("triangles"));
 }
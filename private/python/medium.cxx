@@ -225,6 +225,21 @@ void init_medium(py::module& m) {
         .def(py::init<const Axis&, const Spline&>(), py::arg("density_axis"),
              py::arg("splines"));
 
+    py::class_<Density_layered, Density_distr,
+               std::shared_ptr<Density_layered>>(m_sub, "density_layered")
+        .def(py::init<const RadialAxis&>(), py::arg("density_axis"))
+        .def("add_layer", &Density_layered::AddLayer, py::arg("radius"),
+             py::arg("density_distribution"),
+             R"pbdoc(
+                Adds a layer on top of the others.
+
+                Parameters:
+                    radius (float): outer radius of the layer in cm
+                    density_distribution (density_distribution): density
+                        distribution inside the layer
+            )pbdoc")
+        .def_property_readonly("radii", &Density_layered::GetRadii);
+
     py::class_<Axis, std::shared_ptr<Axis>>(m_sub, "Density_axis")
         .def_property_readonly("fAxis", &Axis::GetAxis)
         .def_property_readonly("refernce_point", &Axis::GetFp0)
@@ -1,3 +1,7 @@
+#include <algorithm>
+
+#include <pybind11/numpy.h>
+
 #include "PROPOSAL/PROPOSAL.h"
 #include "pyBindings.h"
 
@@ -10,6 +14,17 @@
 namespace py = pybind11;
 using namespace PROPOSAL;
 
+// Copy of a column of a SecondaryBuffer. A view on the memory of the buffer
+// would dangle, as soon as the buffer grows or is cleared.
+template <class T>
+py::array_t<T> buffer_column(const SecondaryBuffer& buffer, const T* (SecondaryBuffer::*getter)() const)
+{
+    py::array_t<T> column(static_cast<py::ssize_t>(buffer.GetSize()));
+    std::copy((buffer.*getter)(), (buffer.*getter)() + buffer.GetSize(), column.mutable_data());
+
+    return column;
+}
+
 void init_particle(py::module& m) {
     py::module m_sub = m.def_submodule("particle");
 
@@ -243,6 +258,12 @@ void init_particle(py::module& m) {
                       &DynamicData::SetPropagatedDistance,
                       R"pbdoc(
                 Propagated distance of primary particle.
+            )pbdoc")
+        .def_property("weight", &DynamicData::GetWeight, &DynamicData::SetWeight,
+                      R"pbdoc(
+                Likelihood ratio of a biased propagation, 1 if unbiased.
+                For a secondary it is the weight of the primary particle
+                after the interaction.
             )pbdoc");
 
     py::class_<Particle, std::shared_ptr<Particle>, DynamicData>(m_sub,
@@ -329,4 +350,34 @@ void init_particle(py::module& m) {
                 Energy primary particle lost in detector.
                 Energy primary particle lost in detector...
             )pbdoc");
+
+    py::class_<SecondaryBuffer, std::shared_ptr<SecondaryBuffer>>(m_sub, "SecondaryBuffer",
+                                                                  R"pbdoc(
+                Secondaries stored as columns. The properties return numpy
+                arrays with a copy of the columns, which stay valid when the
+                buffer grows or is cleared.
+
+                >>> buffer = pyPROPOSAL.particle.SecondaryBuffer()
+                >>> prop.propagate_secondaries(buffer)
+                >>> energies = buffer.energy
+            )pbdoc")
+        .def(py::init<>())
+        .def("__len__", &SecondaryBuffer::GetSize)
+        .def("clear", &SecondaryBuffer::Clear)
+        .def("reserve", &SecondaryBuffer::Reserve, py::arg("size"))
+        .def_property_readonly("id", [](const SecondaryBuffer& self) { return buffer_column<int>(self, &SecondaryBuffer::GetTypeId); },
+                               R"pbdoc(
+                Type of the interactions as values of pyPROPOSAL.particle.Data.
+            )pbdoc")
+        .def_property_readonly("x", [](const SecondaryBuffer& self) { return buffer_column<double>(self, &SecondaryBuffer::GetX); })
+        .def_property_readonly("y", [](const SecondaryBuffer& self) { return buffer_column<double>(self, &SecondaryBuffer::GetY); })
+        .def_property_readonly("z", [](const SecondaryBuffer& self) { return buffer_column<double>(self, &SecondaryBuffer::GetZ); })
+        .def_property_readonly("direction_x", [](const SecondaryBuffer& self) { return buffer_column<double>(self, &SecondaryBuffer::GetDirectionX); })
+        .def_property_readonly("direction_y", [](const SecondaryBuffer& self) { return buffer_column<double>(self, &SecondaryBuffer::GetDirectionY); })
+        .def_property_readonly("direction_z", [](const SecondaryBuffer& self) { return buffer_column<double>(self, &SecondaryBuffer::GetDirectionZ); })
+        .def_property_readonly("energy", [](const SecondaryBuffer& self) { return buffer_column<double>(self, &SecondaryBuffer::GetEnergy); })
+        .def_property_readonly("parent_particle_energy", [](const SecondaryBuffer& self) { return buffer_column<double>(self, &SecondaryBuffer::GetParentParticleEnergy); })
+        .def_property_readonly("time", [](const SecondaryBuffer& self) { return buffer_column<double>(self, &SecondaryBuffer::GetTime); })
+        .def_property_readonly("propagated_distance", [](const SecondaryBuffer& self) { return buffer_column<double>(self, &SecondaryBuffer::GetPropagatedDistance); })
+        .def_property_readonly("weight", [](const SecondaryBuffer& self) { return buffer_column<double>(self, &SecondaryBuffer::GetWeight); });
 }
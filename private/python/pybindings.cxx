@@ -186,6 +186,19 @@ PYBIND11_MODULE(pyPROPOSAL, m) {
                 This will stop the program, if the required table is not
                 in the readonly path. The (writable) path_to_tables will be
                 ignored. Default: xxx
+            )pbdoc")
+        .def_readwrite("do_cut_independent_dndx",
+                       &InterpolationDef::do_cut_independent_dndx,
+                       R"pbdoc(
+                The dNdx tables are built once per process and medium and
+                shared between all energy cut settings. Default: False
+            )pbdoc")
+        .def_readwrite("cut_independent_min_loss",
+                       &InterpolationDef::cut_independent_min_loss,
+                       R"pbdoc(
+                Smallest energy loss in MeV covered by the cut independent
+                dNdx tables. Smaller energy cuts fall back to cut dependent
+                tables. Default: 0.1
             )pbdoc");
 
     // ---------------------------------------------------------------------
@@ -367,6 +380,15 @@ PYBIND11_MODULE(pyPROPOSAL, m) {
                     Factor used to scale the probability of producing a 
                     stochastic loss, defaults to 1.0.
                 )pbdoc")
+        .def_readwrite("interaction_bias",
+                       &Sector::Definition::interaction_bias,
+                       R"pbdoc(
+                    Dictionary of pyPROPOSAL.particle.Data types and positive
+                    factors the probability to choose this interaction type
+                    is scaled with. The weight of the particle and its
+                    secondaries corrects for the bias, defaults to an empty
+                    dictionary.
+                )pbdoc")
         .def_readwrite("stopping_decay", &Sector::Definition::stopping_decay,
                        R"pbdoc(
                     
@@ -377,6 +399,17 @@ PYBIND11_MODULE(pyPROPOSAL, m) {
                     Boolean if continous randomization should be done if 
                     interpolation if is used, defaults to true.
                 )pbdoc")
+        .def_readwrite("do_range_propagation",
+                       &Sector::Definition::do_range_propagation,
+                       R"pbdoc(
+                    Boolean if the energy after a distance should be
+                    sampled from survival tables, defaults to false.
+
+                    The tables are built once by full propagation in the
+                    medium, no single stochastic losses are sampled then.
+                    Meant for sectors in front of the detector, where only
+                    the energy at the detector matters.
+                )pbdoc")
         .def_readwrite("do_continuous_energy_loss_output",
                        &Sector::Definition::do_continuous_energy_loss_output,
                        R"pbdoc(
@@ -436,7 +469,7 @@ PYBIND11_MODULE(pyPROPOSAL, m) {
                       const InterpolationDef&>(),
              py::arg("particle"), py::arg("sector_definition"),
              py::arg("interpolation_def"))
-        .def("propagate", &Sector::Propagate, py::arg("distance"),
+        .def("propagate", static_cast<double (Sector::*)(double)>(&Sector::Propagate), py::arg("distance"),
              R"pbdoc(
                 Args: 
                     distance (float): Distance to propagate in cm.
@@ -499,6 +532,24 @@ PYBIND11_MODULE(pyPROPOSAL, m) {
     // Propagator
     // --------------------------------------------------------------------- //
 
+    py::class_<Propagator::Splitting,
+               std::shared_ptr<Propagator::Splitting>>(m, "Splitting",
+        R"pbdoc(
+                Settings of particle splitting and russian roulette. A
+                particle inside the detector with at least split_energy is
+                split into multiplicity copies with the weight divided by
+                the multiplicity. A particle outside of the detector, which
+                is not split and falls below roulette_energy, is terminated
+                with the probability 1 - roulette_survival.
+            )pbdoc")
+        .def(py::init<>())
+        .def_readwrite("multiplicity", &Propagator::Splitting::multiplicity)
+        .def_readwrite("split_energy", &Propagator::Splitting::split_energy)
+        .def_readwrite("roulette_energy",
+                       &Propagator::Splitting::roulette_energy)
+        .def_readwrite("roulette_survival",
+                       &Propagator::Splitting::roulette_survival);
+
     py::class_<Propagator, std::shared_ptr<Propagator>>(m, "Propagator")
         .def(
             py::init<const ParticleDef&, const std::vector<Sector::Definition>&,
@@ -525,7 +576,7 @@ PYBIND11_MODULE(pyPROPOSAL, m) {
             py::arg("detector"))
         .def(py::init<const ParticleDef&, const std::string&>(),
              py::arg("particle_def"), py::arg("config_file"))
-        .def("propagate", &Propagator::Propagate,
+        .def("propagate", static_cast<std::vector<DynamicData*> (Propagator::*)(double)>(&Propagator::Propagate),
              py::arg("max_distance_cm") = 1e20,
              py::return_value_policy::reference,
              R"pbdoc(
@@ -579,6 +630,23 @@ PYBIND11_MODULE(pyPROPOSAL, m) {
                     will be calculated and the produced secondary particles 
                     returned.
                 )pbdoc")
+        .def("propagate_secondaries",
+             [](Propagator& prop, SecondaryBuffer& buffer, double max_distance_cm) {
+                 return prop.PropagateSecondaries(buffer, max_distance_cm);
+             },
+             py::arg("buffer"), py::arg("max_distance_cm") = 1e20,
+             R"pbdoc(
+                    Propagate a particle like propagate, but append the
+                    secondaries to the columns of the given buffer.
+
+                    Args:
+                        buffer (pyPROPOSAL.particle.SecondaryBuffer): buffer the secondaries are appended to
+                        max_distance_cm (float): Maximum distance a particle is
+                            propagated before it is considered lost.
+
+                    Returns:
+                        int: number of appended secondaries
+                )pbdoc")
         .def_property_readonly("particle", &Propagator::GetParticle,
                                R"pbdoc(
                     Get the internal created particle to modify its properties.
@@ -599,6 +667,18 @@ PYBIND11_MODULE(pyPROPOSAL, m) {
 
                     Returns:
                         Geometry: the geometry of the detector.
+                )pbdoc")
+        .def_property("splitting", &Propagator::GetSplitting,
+                      &Propagator::SetSplitting,
+                      R"pbdoc(
+                    Settings of particle splitting and russian roulette.
+                )pbdoc")
+        .def_property_readonly("propagated_weight",
+                               &Propagator::GetPropagatedWeight,
+                               R"pbdoc(
+                    Weight of the particle at the end of the last event.
+                    The weight of the particle itself is restored after
+                    every event.
                 )pbdoc");
 
     // ---------------------------------------------------------------------
@@ -613,6 +693,49 @@ PYBIND11_MODULE(pyPROPOSAL, m) {
              py::arg("distance") = 1e20)
         .def("register_propagator", &PropagatorService::RegisterPropagator,
              py::arg("propagator"));
+
+    // ---------------------------------------------------------------------
+    // // SurvivalTable
+    // ---------------------------------------------------------------------
+    // //
+
+    py::class_<SurvivalTable::Definition,
+               std::shared_ptr<SurvivalTable::Definition>>(
+        m, "SurvivalTableDefinition")
+        .def(py::init<>())
+        .def_readwrite("energy_min", &SurvivalTable::Definition::energy_min)
+        .def_readwrite("energy_max", &SurvivalTable::Definition::energy_max)
+        .def_readwrite("distance_min", &SurvivalTable::Definition::distance_min)
+        .def_readwrite("distance_max", &SurvivalTable::Definition::distance_max)
+        .def_readwrite("energy_nodes", &SurvivalTable::Definition::energy_nodes)
+        .def_readwrite("distance_nodes",
+                       &SurvivalTable::Definition::distance_nodes)
+        .def_readwrite("quantile_nodes",
+                       &SurvivalTable::Definition::quantile_nodes)
+        .def_readwrite("statistic", &SurvivalTable::Definition::statistic)
+        .def_readwrite("seed", &SurvivalTable::Definition::seed);
+
+    py::class_<SurvivalTable, std::shared_ptr<SurvivalTable>>(
+        m, "SurvivalTable",
+        R"pbdoc(
+                Tabulated survival probability and final energy quantiles
+                of a particle after a distance in the medium of a sector.
+                The tables are built once by propagating a batch of
+                particles and are cached like the other interpolation tables.
+            )pbdoc")
+        .def(py::init<const ParticleDef&, const Sector::Definition&,
+                      const InterpolationDef&,
+                      const SurvivalTable::Definition&>(),
+             py::arg("particle_def"), py::arg("sector_definition"),
+             py::arg("interpolation_def"),
+             py::arg("survival_def") = SurvivalTable::Definition())
+        .def("survival_probability", &SurvivalTable::GetSurvivalProbability,
+             py::arg("energy"), py::arg("distance"))
+        .def("energy_quantile", &SurvivalTable::GetEnergyQuantile,
+             py::arg("energy"), py::arg("distance"), py::arg("quantile"))
+        .def("sample_energy", &SurvivalTable::SampleEnergy, py::arg("energy"),
+             py::arg("distance"), py::arg("rnd"))
+        .def_property_readonly("definition", &SurvivalTable::GetDefinition);
 }
 
 // #undef COMPONENT_DEF
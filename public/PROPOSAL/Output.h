@@ -34,6 +34,7 @@
 #include <vector>
 
 #include "PROPOSAL/particle/Particle.h"
+#include "PROPOSAL/particle/Secondary.h"
 
 #if ROOT_SUPPORT
     #include "TFile.h"
@@ -52,7 +53,17 @@ private:
     Output(Output const&);         // Don't Implement.
     void operator=(Output const&); // Don't implement
 
-    static std::vector<DynamicData*> secondarys_;
+    static std::vector<Secondary> records_;       //!< compact records of the secondaries
+    static std::vector<DynamicData*> secondarys_; //!< DynamicData created on request from the records
+    static SecondarySink* sink_;                  //!< receives the records instead of records_ if set
+
+    void Store(const Secondary& secondary)
+    {
+        if (sink_ != NULL)
+            sink_->Fill(secondary);
+        else
+            records_.push_back(secondary);
+    }
 
     static bool store_in_root_trees_;
 
@@ -121,6 +132,8 @@ public:
     /// @brief Fill secondary data
     ///
     /// This method is used to store decay products.
+    /// The output takes the ownership of the particles, they are stored
+    /// as compact records and deleted.
     ///
     /// @param std::vector
     // ----------------------------------------------------------------------------
@@ -129,7 +142,7 @@ public:
     // ----------------------------------------------------------------------------
     /// @brief Fill secondary data
     ///
-    /// New DynamicData is create with information of the given particle, type of
+    /// A new record is created with information of the given particle, type of
     /// DynamicData and the energyloss
     ///
     /// @param particle
@@ -149,10 +162,31 @@ public:
     /// The Energy is the energy lost during the continuous loss (including the continuous randomization).
     /// The ParentParticleEnergy is the particle energy before the continuous loss.
     ///
+    /// The output takes the ownership of the given data.
+    ///
     /// @param ContinuousEnergyLoss
     // ----------------------------------------------------------------------------
     void FillSecondaryVector(DynamicData* continuous_loss);
 
+    // ----------------------------------------------------------------------------
+    /// @brief Fill secondary data
+    ///
+    /// Stores a copy of the given record.
+    ///
+    /// @param secondary
+    // ----------------------------------------------------------------------------
+    void FillSecondaryVector(const Secondary& secondary) { Store(secondary); }
+
+    // ----------------------------------------------------------------------------
+    /// @brief Pass the secondaries to a sink instead of storing them
+    ///
+    /// The output does not take the ownership. NULL restores storing.
+    ///
+    /// @param sink
+    // ----------------------------------------------------------------------------
+    void SetSecondarySink(SecondarySink* sink) { sink_ = sink; }
+    SecondarySink* GetSecondarySink() const { return sink_; }
+
     //----------------------------------------------------------------------------//
 
     void ClearSecondaryVector();
@@ -199,7 +233,41 @@ public:
     void WriteDescriptionFile();
 
     // Getter
-    std::vector<DynamicData*> GetSecondarys() const { return secondarys_; }
+
+    // ----------------------------------------------------------------------------
+    /// @brief Secondaries as DynamicData
+    ///
+    /// The DynamicData are created from the records on the first request
+    /// and are owned by the output until ClearSecondaryVector is called.
+    // ----------------------------------------------------------------------------
+    std::vector<DynamicData*> GetSecondarys() const;
+
+    const std::vector<Secondary>& GetSecondaryRecords() const { return records_; }
+};
+
+// ----------------------------------------------------------------------------
+/// @brief Pass the secondaries to a sink during the lifetime of the guard
+///
+/// The previously set sink is restored by the destructor, also when the
+/// propagation is left by an exception.
+// ----------------------------------------------------------------------------
+class ScopedSecondarySink
+{
+public:
+    explicit ScopedSecondarySink(SecondarySink& sink)
+        : previous_(Output::getInstance().GetSecondarySink())
+    {
+        Output::getInstance().SetSecondarySink(&sink);
+    }
+
+    ~ScopedSecondarySink() { Output::getInstance().SetSecondarySink(previous_); }
+
+private:
+    ScopedSecondarySink(const ScopedSecondarySink&);            // Undefined & not allowed
+    ScopedSecondarySink& operator=(const ScopedSecondarySink&); // Undefined & not allowed
+
+    SecondarySink* previous_;
 };
+
 } // namespace PROPOSAL
 
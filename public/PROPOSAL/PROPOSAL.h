@@ -34,8 +34,11 @@
 
 #include "PROPOSAL/geometry/Box.h"
 #include "PROPOSAL/geometry/Cylinder.h"
+#include "PROPOSAL/geometry/ExtrudedPolygon.h"
 #include "PROPOSAL/geometry/GeometryFactory.h"
+#include "PROPOSAL/geometry/GeometryKernels.h"
 #include "PROPOSAL/geometry/Sphere.h"
+#include "PROPOSAL/geometry/TriangleMesh.h"
 
 #include "PROPOSAL/crossection/factories/AnnihilationFactory.h"
 #include "PROPOSAL/crossection/factories/BremsstrahlungFactory.h"
@@ -94,6 +97,7 @@
 #include "PROPOSAL/medium/density_distr/density_distr.h"
 #include "PROPOSAL/medium/density_distr/density_exponential.h"
 #include "PROPOSAL/medium/density_distr/density_homogeneous.h"
+#include "PROPOSAL/medium/density_distr/density_layered.h"
 #include "PROPOSAL/medium/density_distr/density_polynomial.h"
 #include "PROPOSAL/medium/density_distr/density_splines.h"
 
@@ -109,6 +113,8 @@
 
 #include "PROPOSAL/particle/Particle.h"
 #include "PROPOSAL/particle/ParticleDef.h"
+#include "PROPOSAL/particle/Secondary.h"
+#include "PROPOSAL/particle/SecondaryBuffer.h"
 
 #include "PROPOSAL/propagation_utility/ContinuousRandomizer.h"
 #include "PROPOSAL/propagation_utility/PropagationUtility.h"
@@ -128,6 +134,8 @@
 #include "PROPOSAL/Constants.h"
 #include "PROPOSAL/EnergyCutSettings.h"
 #include "PROPOSAL/Output.h"
+#include "PROPOSAL/PropagationRun.h"
 #include "PROPOSAL/Propagator.h"
 #include "PROPOSAL/PropagatorService.h"
+#include "PROPOSAL/SurvivalTable.h"
 #include "PROPOSAL/methods.h"
@@ -0,0 +1,143 @@
+
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+
+#pragma once
+
+#include <fstream>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "PROPOSAL/particle/Particle.h"
+#include "PROPOSAL/particle/Secondary.h"
+
+namespace PROPOSAL {
+
+class Propagator;
+
+// ----------------------------------------------------------------------------
+/// @brief Event loop of a propagation run, which can be checkpointed
+///
+/// Every checkpoint_interval events the state of the run is written to the
+/// checkpoint file: the state of the random number generator, the number of
+/// finished events, the offsets of the output files opened with OpenOutput
+/// and an identity of the propagator configuration.
+///
+/// If the checkpoint file exists, the run is resumed from it. The outputs
+/// are truncated to the checkpointed offsets and the random number generator
+/// is restored at the start of Run, so the resumed run gives the same output
+/// as a run without interruption.
+///
+/// Only the internal random number generator can be checkpointed.
+// ----------------------------------------------------------------------------
+class PropagationRun
+{
+public:
+    /// Sets the initial state of the primary of an event
+    typedef std::function<void(size_t event, Particle& primary)> PrimaryGenerator;
+
+    /// Receives the propagated primary and the secondaries of an event
+    typedef std::function<void(size_t event, const Particle& primary, const std::vector<Secondary>& secondaries)>
+        EventWriter;
+
+public:
+    PropagationRun(Propagator&, const std::string& checkpoint_file, size_t checkpoint_interval);
+    ~PropagationRun();
+
+    // ----------------------------------------------------------------------------
+    /// @brief Opens an output file of the run
+    ///
+    /// A new run starts with an empty file, a resumed run continues the file
+    /// at the checkpointed offset.
+    ///
+    /// @param path
+    ///
+    /// @return stream, which is owned by the run
+    // ----------------------------------------------------------------------------
+    std::ostream& OpenOutput(const std::string& path);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Propagates the events till n_events are finished
+    ///
+    /// A checkpoint is written every checkpoint_interval events and at the
+    /// end of the run.
+    ///
+    /// @param n_events total number of events of the run
+    /// @param generator
+    /// @param writer
+    ///
+    /// @return number of finished events
+    // ----------------------------------------------------------------------------
+    size_t Run(size_t n_events, const PrimaryGenerator& generator, const EventWriter& writer);
+
+    /// Writes the checkpoint file
+    void Checkpoint();
+
+    // --------------------------------------------------------------------- //
+    // Getter
+    // --------------------------------------------------------------------- //
+
+    bool IsResumed() const { return resumed_; }
+    size_t GetEvent() const { return event_; }
+    const std::string& GetIdentity() const { return identity_; }
+
+    // ----------------------------------------------------------------------------
+    /// @brief Identity of a propagator configuration
+    ///
+    /// Hash of the particle definition, the detector, the splitting and the
+    /// definitions of all sectors, printed with all digits, and of the
+    /// hashes of the parametrizations.
+    // ----------------------------------------------------------------------------
+    static std::string GetIdentity(const Propagator&);
+
+private:
+    PropagationRun(const PropagationRun&);            // Undefined & not allowed
+    PropagationRun& operator=(const PropagationRun&); // Undefined & not allowed
+
+    void ReadCheckpoint();
+
+    Propagator& propagator_;
+
+    std::string checkpoint_file_;
+    size_t checkpoint_interval_;
+    std::string identity_;
+
+    size_t event_;
+    bool resumed_;
+
+    std::string rng_state_;                        //!< state of the checkpoint, restored by Run
+    std::map<std::string, std::streamoff> offsets_; //!< output offsets of the checkpoint
+
+    std::vector<std::string> output_paths_;
+    std::vector<std::ofstream*> outputs_;
+};
+
+} // namespace PROPOSAL
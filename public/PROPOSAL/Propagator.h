@@ -49,12 +49,44 @@
 #include <vector>
 
 #include "PROPOSAL/Output.h"
+#include "PROPOSAL/geometry/Geometry.h"
+#include "PROPOSAL/particle/SecondaryBuffer.h"
 #include "PROPOSAL/sector/Sector.h"
 
 namespace PROPOSAL {
 
 class Propagator
 {
+public:
+    // ----------------------------------------------------------------------------
+    /// @brief Settings of particle splitting and russian roulette
+    ///
+    /// If the particle is inside the detector with at least split_energy, it
+    /// is split into multiplicity copies, which are propagated one after the
+    /// other from this point on. The weight of every copy is divided by the
+    /// multiplicity. A particle outside of the detector, which is not split
+    /// and falls below roulette_energy, is terminated with the probability
+    /// 1 - roulette_survival, otherwise its weight is divided by
+    /// roulette_survival. Terminated particles get the weight 0.
+    ///
+    /// The secondaries of the copies are stored one after the other and
+    /// carry the weight of their copy. The particle after the propagation,
+    /// its entry, exit and closest approach information and the propagated
+    /// primary in the output describe the copy propagated last only.
+    // ----------------------------------------------------------------------------
+    struct Splitting
+    {
+        Splitting();
+
+        bool operator==(const Splitting&) const;
+        bool operator!=(const Splitting&) const;
+
+        int multiplicity;         //!< number of copies, 1 disables splitting
+        double split_energy;      //!< smallest energy of a particle to be split [MeV]
+        double roulette_energy;   //!< energy below which russian roulette is played [MeV], 0 disables it
+        double roulette_survival; //!< survival probability of the russian roulette
+    };
+
 public:
     // Constructors
     Propagator(const std::vector<Sector*>&, const Geometry&);
@@ -77,6 +109,44 @@ public:
     // ----------------------------------------------------------------------------
     std::vector<DynamicData*> Propagate(double MaxDistance_cm = 1e20);
 
+    // ----------------------------------------------------------------------------
+    /// @brief Propagates the particle through the current set of Sectors
+    ///
+    /// Like Propagate, but the secondaries are returned as compact records
+    /// and no DynamicData is created. The records are valid until the next
+    /// propagation.
+    ///
+    /// @param MaxDistance_cm
+    ///
+    /// @return Secondary records
+    // ----------------------------------------------------------------------------
+    const std::vector<Secondary>& PropagateSecondaries(double MaxDistance_cm = 1e20);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Propagates the particle through the current set of Sectors
+    ///
+    /// The secondaries are appended to the given buffer, so the columns of
+    /// several events can be collected in one buffer.
+    ///
+    /// @param buffer
+    /// @param MaxDistance_cm
+    ///
+    /// @return number of appended secondaries
+    // ----------------------------------------------------------------------------
+    size_t PropagateSecondaries(SecondaryBuffer& buffer, double MaxDistance_cm = 1e20);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Propagates the particle through the current set of Sectors
+    ///
+    /// Every secondary is passed to the sink as soon as it is produced and
+    /// nothing is stored internally. A lambda can be used as sink with
+    /// MakeSecondaryCallback.
+    ///
+    /// @param sink
+    /// @param MaxDistance_cm
+    // ----------------------------------------------------------------------------
+    void Propagate(SecondarySink& sink, double MaxDistance_cm = 1e20);
+
     // --------------------------------------------------------------------- //
     // Getter
     // --------------------------------------------------------------------- //
@@ -87,10 +157,62 @@ public:
     Geometry& GetDetector() const { return *detector_; };
     Particle& GetParticle() { return particle_; };
 
+    // ----------------------------------------------------------------------------
+    /// @brief Weight of the particle at the end of the last event
+    ///
+    /// The weight of the particle is the start weight of every event. The
+    /// biasing changes it during the propagation, but it is restored after
+    /// the event, so it must not be reset by the caller. The weight, which
+    /// belongs to the final state of the particle, is returned here.
+    // ----------------------------------------------------------------------------
+    double GetPropagatedWeight() const { return propagated_weight_; }
+
+    const Splitting& GetSplitting() const { return splitting_; }
+    void SetSplitting(const Splitting&);
+
 private:
+    // Flags of the propagation loop, which are restored with the copy of a
+    // split particle
+    struct TrackState
+    {
+        bool starts_in_detector;
+        bool was_in_detector;
+        bool already_reached_closest_approach;
+        bool split;
+        bool roulette;
+    };
+
+    // Interval of a straight trajectory inside of one sector, see
+    // PlanSectorCrossings. The distances are measured from the start of the
+    // trajectory.
+    struct SectorCrossing
+    {
+        Sector* sector;                            //!< NULL, if the sector must be chosen at the position
+        Geometry::ParticleLocation::Enum location; //!< location relative to the detector
+        double entry;
+        double exit;
+        double stop; //!< next border, at which the propagation stops, see CalculateEffectiveDistance
+    };
 
     Propagator& operator=(const Propagator& propagator);
 
+    // ----------------------------------------------------------------------------
+    /// @brief Propagates the particle until it is stopped or leaves the sectors
+    ///
+    /// @param track: flags of the propagation loop, given by the start or the copy
+    /// @param MaxDistance_cm
+    // ----------------------------------------------------------------------------
+    void PropagateTrack(TrackState& track, double MaxDistance_cm);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Save multiplicity - 1 copies of the particle for later propagation
+    ///
+    /// The weight of the particle and of the copies is divided by the multiplicity.
+    ///
+    /// @param track: flags of the propagation loop
+    // ----------------------------------------------------------------------------
+    void Split(TrackState& track);
+
     // ----------------------------------------------------------------------------
     /// @brief Simple wrapper to initialize propagator from config file
     ///
@@ -120,7 +242,8 @@ private:
                                  const std::string& json_key,
                                  double default_ecut,
                                  double default_vcut,
-                                 bool default_contrand);
+                                 bool default_contrand,
+                                 bool default_range_propagation);
 
     // ----------------------------------------------------------------------------
     /// @brief Create geometry from json config file
@@ -131,13 +254,34 @@ private:
     // ----------------------------------------------------------------------------
     Geometry* ParseGeometryConifg(const std::string& json_object_str);
 
+    // ----------------------------------------------------------------------------
+    /// @brief Create a new sector for the propagated particle
+    ///
+    /// If one of the already created sectors has the same physics, the new
+    /// sector shares its utility, calculators and interpolation tables instead
+    /// of building them again.
+    ///
+    /// @param sector_def
+    /// @param interpolation_def
+    ///
+    /// @return new Sector
+    // ----------------------------------------------------------------------------
+    Sector* CreateSector(const Sector::Definition&);
+    Sector* CreateSector(const Sector::Definition&, const InterpolationDef&);
+    const Sector* FindSectorWithSamePhysics(const Sector::Definition&) const;
+
     // ----------------------------------------------------------------------------
     /// @brief Choose the current sector the particle is in.
     ///
     /// @param particle_position
     /// @param particle_direction
+    /// @param detector intersection of the trajectory with the detector
+    /// @param sector intersection of the trajectory with the chosen sector
     // ----------------------------------------------------------------------------
-    void ChooseCurrentSector(const Vector3D& particle_position, const Vector3D& particle_direction);
+    void ChooseCurrentSector(const Vector3D& particle_position,
+                             const Vector3D& particle_direction,
+                             const Geometry::Intersection& detector,
+                             Geometry::Intersection& sector);
 
     // ----------------------------------------------------------------------------
     /// @brief Calculate the distance to propagate
@@ -148,10 +292,61 @@ private:
     ///
     /// @param particle_position
     /// @param particle_direction
+    /// @param detector intersection of the trajectory with the detector
+    /// @param sector intersection of the trajectory with the current sector
     ///
     /// @return distance
     // ----------------------------------------------------------------------------
-    double CalculateEffectiveDistance(const Vector3D& particle_position, const Vector3D& particle_direction);
+    double CalculateEffectiveDistance(const Vector3D& particle_position,
+                                      const Vector3D& particle_direction,
+                                      const Geometry::Intersection& detector,
+                                      const Geometry::Intersection& sector);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Plan the sectors crossed along a straight trajectory
+    ///
+    /// The borders of the detector and of all sectors hit by the trajectory
+    /// are collected with the trees of the sector geometries. Between two
+    /// borders the location and the sector do not change, so they are chosen
+    /// once for every interval. If several sectors of the highest hierarchy
+    /// overlap, the choice depends on the density at the position and the
+    /// interval is left without sector.
+    ///
+    /// @param position
+    /// @param direction
+    // ----------------------------------------------------------------------------
+    void PlanSectorCrossings(const Vector3D& position, const Vector3D& direction);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Find the planned crossing the particle is in
+    ///
+    /// If the particle left the planned trajectory, the crossings are planned
+    /// again from its position, but only if plan is set. A particle, which is
+    /// deflected in every step, is better served by ChooseCurrentSector.
+    /// Therefore tracks with multiple scattering in every step, e.g. Highland,
+    /// never use the plan: they leave the planned line after their first step
+    /// and are not planned again, their sectors are chosen step by step.
+    ///
+    /// @param particle_position
+    /// @param particle_direction
+    /// @param detector intersection of the trajectory with the detector
+    /// @param plan allow to plan the crossings again
+    /// @param distance to propagate, see CalculateEffectiveDistance
+    ///
+    /// @return the crossing or NULL, if the sector must be chosen step by step
+    // ----------------------------------------------------------------------------
+    const SectorCrossing* FindSectorCrossing(const Vector3D& particle_position,
+                                             const Vector3D& particle_direction,
+                                             const Geometry::Intersection& detector,
+                                             bool plan,
+                                             double& distance);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Build the trees of the sector geometries
+    ///
+    /// Needs to be called, if the sectors are changed.
+    // ----------------------------------------------------------------------------
+    void BuildSectorTrees();
 
     // --------------------------------------------------------------------- //
     // Global default values
@@ -186,6 +381,8 @@ private:
     static const double
         global_cont_behind_;        //!< continuous randominzation flag for behind the detector (it's used when not
                                     //! specified explicit for a sector in configuration file)
+    static const bool global_range_propagation_; //!< range propagation flag for all sectors (it's used when not
+                                                 //! specified explicit for a sector in configuration file)
     static const bool do_interpolation_; //!< Enable interpolation
     static const bool uniform_; //!< Enable uniform sampling of phase space points for decays
 
@@ -198,6 +395,27 @@ private:
 
     Particle particle_;
     Geometry* detector_;
+
+    Splitting splitting_;
+    std::vector<Particle*> branches_;       //!< copies of a split particle, reused for all events
+    std::vector<TrackState> branch_states_; //!< flags of the propagation loop of the copies
+    size_t pending_branches_;               //!< number of copies waiting for the propagation
+    double propagated_weight_;              //!< weight of the particle at the end of the last event
+
+    // The sectors of each location of the detector and a tree of their
+    // geometries to find the sectors at a position
+    std::vector<unsigned int> location_sectors_[3];
+    BoundingVolumeHierarchy sector_trees_[3];
+    std::vector<size_t> sectors_found_;
+    std::vector<Geometry::Intersection> crossed_intersections_;
+
+    // The crossings of the current straight trajectory, which starts at
+    // crossings_origin_, and the current one
+    std::vector<SectorCrossing> sector_crossings_;
+    std::vector<std::pair<double, int> > crossing_borders_;
+    Vector3D crossings_origin_;
+    Vector3D crossings_direction_;
+    size_t current_crossing_;
 };
 
 } // namespace PROPOSAL
@@ -0,0 +1,149 @@
+
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+
+#pragma once
+
+#include <vector>
+
+#include "PROPOSAL/particle/ParticleDef.h"
+#include "PROPOSAL/sector/Sector.h"
+
+namespace PROPOSAL {
+
+class Interpolant;
+struct InterpolationDef;
+
+// ----------------------------------------------------------------------------
+/// @brief Tabulated survival probability and final energies of a particle
+///
+/// The tables are built once from the propagation of a batch of particles
+/// through the medium of a sector and cached like the other interpolation
+/// tables. For a particle of a given energy they answer the probability to
+/// survive a distance and the quantiles of its energy after this distance
+/// without propagating the particle.
+///
+/// The distance is the track length in cm in the medium of the sector.
+/// Below the smallest tabulated distance the tables are extrapolated
+/// linearly to no loss at no distance. Energies outside the tables and
+/// distances beyond the largest one are moved to the border of the tables
+/// with a warning.
+///
+/// The particles are propagated with all stochastic losses, also if range
+/// propagation is set in the sector definition: range propagation samples
+/// its energies from these tables.
+///
+/// Building the tables propagates energy_nodes * statistic particles over
+/// distance_max. With the defaults these are 10^4 muons through 10 km of
+/// the medium, which takes about a minute for water. The tables are only
+/// built once, if a path is given in the InterpolationDef.
+// ----------------------------------------------------------------------------
+class SurvivalTable
+{
+public:
+    struct Definition
+    {
+        double energy_min;   //!< smallest initial energy of the tables in MeV
+        double energy_max;   //!< largest initial energy of the tables in MeV
+        double distance_min; //!< smallest distance of the tables in cm
+        double distance_max; //!< largest distance of the tables in cm
+        int energy_nodes;    //!< number of initial energies
+        int distance_nodes;  //!< number of distances
+        int quantile_nodes;  //!< number of tabulated quantiles of the final energy, dense at the large losses
+        int statistic;       //!< number of particles propagated for each initial energy
+        int seed;            //!< seed used while the particles are propagated
+
+        Definition();
+        ~Definition();
+
+        bool operator==(const Definition&) const;
+        bool operator!=(const Definition&) const;
+
+        size_t GetHash() const;
+    };
+
+public:
+    SurvivalTable(const ParticleDef&,
+                  const Sector::Definition&,
+                  const InterpolationDef&,
+                  const Definition& survival_def = Definition());
+    SurvivalTable(const SurvivalTable&);
+    ~SurvivalTable();
+
+    bool operator==(const SurvivalTable&) const;
+    bool operator!=(const SurvivalTable&) const;
+
+    // ----------------------------------------------------------------------------
+    /// @brief Probability that the particle is neither stopped nor decayed
+    ///
+    /// @param energy initial energy in MeV
+    /// @param distance track length in cm
+    ///
+    /// @return survival probability
+    // ----------------------------------------------------------------------------
+    double GetSurvivalProbability(double energy, double distance);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Quantile of the energy of the surviving particles
+    ///
+    /// @param energy initial energy in MeV
+    /// @param distance track length in cm
+    /// @param quantile in [0, 1]
+    ///
+    /// @return final energy in MeV, below which the given fraction of the
+    ///         surviving particles is
+    // ----------------------------------------------------------------------------
+    double GetEnergyQuantile(double energy, double distance, double quantile);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Sample the energy after a distance
+    ///
+    /// @param energy initial energy in MeV
+    /// @param distance track length in cm
+    /// @param rnd random number in [0, 1)
+    ///
+    /// @return final energy in MeV or 0, if the particle did not survive
+    // ----------------------------------------------------------------------------
+    double SampleEnergy(double energy, double distance, double rnd);
+
+    const Definition& GetDefinition() const { return survival_def_; }
+
+private:
+    SurvivalTable& operator=(const SurvivalTable&); // Undefined & not allowed
+
+    double Clamp(double value, double min, double max, const char* name) const;
+
+    Definition survival_def_;
+    double low_;
+
+    Interpolant* survival_;
+    std::vector<Interpolant*> quantiles_;
+};
+
+} // namespace PROPOSAL
@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <memory>
+
 #include "PROPOSAL/crossection/CrossSection.h"
+#include "PROPOSAL/crossection/parametrization/Parametrization.h"
 #include "PROPOSAL/methods.h"
 
 namespace PROPOSAL {
@@ -57,18 +60,46 @@ public:
     virtual double FunctionToBuildDNdxInterpolant2D(double energy, double v, Integral&, int component);
     virtual double CalculateCumulativeCrossSection(double energy, int component, double v);
 
+    // Integral of dNdx from v(t) to vMax, where v(t) does not depend on the cut settings
+    double FunctionToBuildCutIndependentDNdxInterpolant2D(double energy, double t, Integral&, int component);
+
+    // Shared cut independent dNdx tables, empty if cut dependent tables are used
+    const std::vector<std::shared_ptr<Interpolant> >& GetCutIndependentDNdxInterpolants() const
+    {
+        return dndx_interpolant_cut_independent_;
+    }
+
 protected:
     virtual bool compare(const CrossSection&) const;
 
     typedef std::vector<Interpolant*> InterpolantVec;
+    typedef std::vector<std::shared_ptr<Interpolant> > SharedInterpolantVec;
 
     virtual double CalculateStochasticLoss(double energy, double rnd1);
     virtual void InitdNdxInterpolation(const InterpolationDef& def);
 
+    // ----------------------------------------------------------------------------
+    /// @brief Cut independent dNdx tables
+    ///
+    /// Instead of integrating dNdx from vUp on, the integral from a lower
+    /// limit, which just depends on the kinematics and the given minimal energy
+    /// loss, up to vMax is tabulated. These tables are identical for every cut
+    /// setting of a process in a medium and are therefore shared by all
+    /// cross sections using the same physics. The dNdx for a specific cut is
+    /// the difference of the table at vUp and at vMax.
+    // ----------------------------------------------------------------------------
+    bool IsCutIndependentDNdxApplicable(const InterpolationDef&) const;
+    void InitCutIndependentDNdxInterpolation(const InterpolationDef&);
+    double GetCutIndependentLowerLimit(double energy, const Parametrization::IntegralLimits&) const;
+    double CalculateCutIndependentDNdx(double energy, int component, double v);
+
     Interpolant* dedx_interpolant_;
     Interpolant* de2dx_interpolant_;
     InterpolantVec dndx_interpolant_1d_; // Stochastic dNdx()
     InterpolantVec dndx_interpolant_2d_; // Stochastic dNdx()
+
+    double cut_independent_min_loss_;
+    SharedInterpolantVec dndx_interpolant_cut_independent_; // Integral of dNdx up to vMax
 };
 
 } // namespace PROPOSAL
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "PROPOSAL/crossection/parametrization/Parametrization.h"
 
 #define BREMSSTRAHLUNG_DEF(param)                                                                                      \
@@ -50,6 +52,7 @@
         }                                                                                                              \
                                                                                                                        \
         double CalculateParametrization(double energy, double v);                                                      \
+        void CalculateParametrizationBatch(double energy, const std::vector<double>& v, std::vector<double>& result);  \
                                                                                                                        \
         const std::string& GetName() const { return name_; }                                                           \
                                                                                                                        \
@@ -74,13 +77,30 @@ public:
     virtual double DifferentialCrossSection(double energy, double v);
     virtual double CalculateParametrization(double energy, double v) = 0;
 
+    // Array-of-points versions, the energy and component dependent terms
+    // are computed once per call.
+    virtual void DifferentialCrossSectionBatch(double energy, const std::vector<double>& v, std::vector<double>& result);
+    virtual void FunctionToDEdxIntegralBatch(double energy, const std::vector<double>& v, std::vector<double>& result);
+    virtual void CalculateParametrizationBatch(double energy, const std::vector<double>& v, std::vector<double>& result);
+
     virtual IntegralLimits GetIntegralLimits(double energy);
 
     // ----------------------------------------------------------------- //
     // Getter
     // ----------------------------------------------------------------- //
 
-    virtual size_t GetHash() const;
+    virtual size_t GetCutIndependentHash() const;
+
+    // Medium dependent constants of the LPM suppression. They are
+    // calculated once per parametrization, particle and medium and
+    // shared between all instances.
+    struct LpmConstants
+    {
+        double eLpm;                //!< LPM energy
+        double gamma_medium;        //!< 4 pi N_mol sum(Z) r_e, for the dielectric suppression
+        std::vector<double> s1;     //!< s1 of each component
+        std::vector<double> log_s1; //!< log(s1) of each component
+    };
 
 protected:
     virtual bool compare(const Parametrization&) const;
@@ -92,6 +112,11 @@ protected:
 
     double lpm(double energy, double v);
 
+    // multiplies result[i] with lpm(energy, v[i])
+    void lpm(double energy, const std::vector<double>& v, std::vector<double>& result);
+    void InitLpmEffect();
+    double LpmSuppression(double energy, double v, double s1, double log_s1) const;
+
     // ----------------------------------------------------------------- //
     // Protected member
     // ----------------------------------------------------------------- //
@@ -101,6 +126,7 @@ protected:
     bool init_lpm_effect_;
     bool lpm_;
     double eLpm_;
+    std::shared_ptr<const LpmConstants> lpm_constants_;
 };
 
 // ------------------------------------------------------------------------- //
@@ -136,6 +162,7 @@ public:
 
     double CalculateParametrization(double energy, double v);
     double DifferentialCrossSection(double energy, double v);
+    void DifferentialCrossSectionBatch(double energy, const std::vector<double>& v, std::vector<double>& result);
 
     const std::string& GetName() const { return name_; }
 
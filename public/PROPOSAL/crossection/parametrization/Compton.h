@@ -54,7 +54,7 @@ namespace PROPOSAL {
         // Getter
         // ----------------------------------------------------------------- //
 
-        virtual size_t GetHash() const;
+        virtual size_t GetCutIndependentHash() const;
 
     protected:
         virtual bool compare(const Parametrization&) const;
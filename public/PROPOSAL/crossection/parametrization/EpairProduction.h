@@ -61,6 +61,10 @@
         }                                                                                                              \
                                                                                                                        \
         double FunctionToIntegral(double energy, double v, double lpm);                                              \
+        void FunctionToIntegralBatch(double energy,                                                                    \
+                                     double v,                                                                         \
+                                     const std::vector<double>& rho,                                                   \
+                                     std::vector<double>& result);                                                     \
                                                                                                                        \
         const std::string& GetName() const { return name_; }                                                           \
                                                                                                                        \
@@ -114,6 +118,11 @@ protected:
     // ----------------------------------------------------------------------------
     double lpm(double energy, double v, double r2, double b, double x);
 
+    // same as above, if the denominator (the bracket of Phi_e) is already
+    // known to the caller
+    double lpm(double energy, double v, double r2, double b, double x, double denominator);
+    void InitLpmEffect();
+
     bool init_lpm_effect_;
     bool lpm_;
     double eLpm_;
@@ -147,7 +156,15 @@ public:
     // ----------------------------------------------------------------------------
     virtual double FunctionToIntegral(double energy, double v, double rho) = 0;
 
-    virtual size_t GetHash() const;
+    // ----------------------------------------------------------------------------
+    /// @brief FunctionToIntegral for many rho at once
+    ///
+    /// Used by DifferentialCrossSection to evaluate a whole quadrature panel
+    /// of the rho integration in one call. The default loops over FunctionToIntegral.
+    // ----------------------------------------------------------------------------
+    virtual void FunctionToIntegralBatch(double energy, double v, const std::vector<double>& rho, std::vector<double>& result);
+
+    virtual size_t GetCutIndependentHash() const;
 
 private:
     bool compare(const Parametrization&) const;
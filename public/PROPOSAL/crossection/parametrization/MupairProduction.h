@@ -127,7 +127,7 @@ public:
     ///
     // ----------------------------------------------------------------------------
 
-    virtual size_t GetHash() const;
+    virtual size_t GetCutIndependentHash() const;
 
 private:
     bool compare(const Parametrization&) const;
@@ -73,6 +73,15 @@ public:
     virtual double FunctionToDEdxIntegral(double energy, double v);
     double FunctionToDE2dxIntegral(double energy, double v);
 
+    // Array-of-points versions of the functions above: evaluate all relative
+    // energy losses v for one energy. The result vector is resized to v.size().
+    // The defaults just loop over the single point methods.
+    virtual void DifferentialCrossSectionBatch(double energy, const std::vector<double>& v, std::vector<double>& result);
+
+    void FunctionToDNdxIntegralBatch(double energy, const std::vector<double>& v, std::vector<double>& result);
+    virtual void FunctionToDEdxIntegralBatch(double energy, const std::vector<double>& v, std::vector<double>& result);
+    void FunctionToDE2dxIntegralBatch(double energy, const std::vector<double>& v, std::vector<double>& result);
+
     virtual double Calculaterho(double energy, double v, double rnd1, double rnd2){
         (void)energy; (void)v; (void)rnd1; (void)rnd2; return 0;}
 
@@ -90,7 +99,10 @@ public:
     double GetMultiplier() const { return multiplier_; }
     virtual bool IsParticleOutputEnabled() const {return false;} // no particle production per default
 
-    virtual size_t GetHash() const;
+    // Hash of everything that enters the differential cross section,
+    // i.e. the hash without the energy cut settings.
+    virtual size_t GetCutIndependentHash() const;
+    size_t GetHash() const;
 
     // ----------------------------------------------------------------- //
     // Setter
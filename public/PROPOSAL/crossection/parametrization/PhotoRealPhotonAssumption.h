@@ -93,7 +93,7 @@ public:
     // Getter
     // --------------------------------------------------------------------- //
 
-    virtual size_t GetHash() const;
+    virtual size_t GetCutIndependentHash() const;
 
 protected:
     virtual bool compare(const Parametrization&) const;
@@ -39,6 +39,7 @@
 #include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/math/Interpolant.h"
 #include "PROPOSAL/math/InterpolantBuilder.h"
+#include "PROPOSAL/math/UniformGridInterpolant.h"
 
 #include "PROPOSAL/Constants.h"
 #include "PROPOSAL/methods.h"
@@ -65,7 +66,7 @@ namespace PROPOSAL {
 
         virtual IntegralLimits GetIntegralLimits(double energy);
 
-        virtual size_t GetHash() const;
+        virtual size_t GetCutIndependentHash() const;
 
     protected:
         bool compare(const Parametrization&) const;
@@ -76,7 +77,8 @@ namespace PROPOSAL {
 class WeakCooperSarkarMertsch : public WeakInteraction
 {
 public:
-        typedef std::vector<Interpolant*> InterpolantVec;
+        // The tables are the same for all instances and are not owned
+        typedef std::vector<const UniformGridInterpolant2D*> InterpolantVec;
 
         WeakCooperSarkarMertsch(const ParticleDef&, const Medium&, double multiplier);
         WeakCooperSarkarMertsch(const WeakCooperSarkarMertsch&);
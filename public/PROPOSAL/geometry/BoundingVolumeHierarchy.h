@@ -0,0 +1,189 @@
+
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "PROPOSAL/math/Vector3D.h"
+
+namespace PROPOSAL {
+
+// ----------------------------------------------------------------------------
+/// @brief Axis aligned box
+// ----------------------------------------------------------------------------
+struct BoundingBox
+{
+    BoundingBox();
+    BoundingBox(const Vector3D& min, const Vector3D& max);
+
+    bool operator==(const BoundingBox&) const;
+    bool operator!=(const BoundingBox&) const;
+
+    /// Enlarges the box, so it contains the given box
+    void Extend(const BoundingBox&);
+
+    /// Enlarges the box by the given distance in every direction
+    void Pad(double);
+
+    bool Contains(const Vector3D& position) const;
+
+    /// Distance along the direction to the entry point of the box, 0 if
+    /// the position is inside and -1 if the box is not hit
+    double DistanceToEntry(const Vector3D& position, const Vector3D& direction) const;
+
+    double min[3];
+    double max[3];
+};
+
+// ----------------------------------------------------------------------------
+/// @brief Bounding volume hierarchy over a list of boxes
+///
+/// The boxes are sorted into a binary tree, whose nodes are boxes containing
+/// their children. Split is the median of the box centers along the longest
+/// axis. The queries descend only into the nodes that contain the position
+/// or are hit by the ray, so they are logarithmic in the number of boxes.
+// ----------------------------------------------------------------------------
+class BoundingVolumeHierarchy
+{
+public:
+    BoundingVolumeHierarchy();
+    BoundingVolumeHierarchy(const std::vector<BoundingBox>&);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Boxes containing the position
+    ///
+    /// @param position
+    /// @param indices indices of the boxes in increasing order
+    // ----------------------------------------------------------------------------
+    void FindContaining(const Vector3D& position, std::vector<size_t>& indices) const;
+
+    // ----------------------------------------------------------------------------
+    /// @brief Visits the boxes entered by the ray before max_distance
+    ///
+    /// Closer nodes are visited first. The visitor is called with the index
+    /// of the box and may lower max_distance, e.g. to the closest border
+    /// found so far, so the farther boxes are skipped.
+    ///
+    /// @param position
+    /// @param direction
+    /// @param max_distance
+    /// @param visit
+    // ----------------------------------------------------------------------------
+    template <class Visitor>
+    void Traverse(const Vector3D& position, const Vector3D& direction, double& max_distance, Visitor visit) const;
+
+    size_t GetSize() const { return indices_.size(); }
+
+private:
+    struct Node
+    {
+        BoundingBox box;
+        size_t left;  //!< first child, the second child is left + 1
+        size_t first; //!< first index of a leaf
+        size_t count; //!< number of indices of a leaf, 0 for inner nodes
+    };
+
+    void Build(const std::vector<BoundingBox>&, size_t node, size_t first, size_t count);
+
+    std::vector<BoundingBox> boxes_;
+    std::vector<Node> nodes_;
+    std::vector<size_t> indices_;
+};
+
+// ------------------------------------------------------------------------- //
+template <class Visitor>
+void BoundingVolumeHierarchy::Traverse(const Vector3D& position,
+                                       const Vector3D& direction,
+                                       double& max_distance,
+                                       Visitor visit) const
+{
+    if (nodes_.empty())
+        return;
+
+    // The depth of the tree is logarithmic in the number of boxes
+    size_t stack[64];
+    double stack_entry[64];
+    size_t size = 0;
+
+    double entry = nodes_[0].box.DistanceToEntry(position, direction);
+    if (entry < 0 || entry > max_distance)
+        return;
+
+    stack[size]         = 0;
+    stack_entry[size++] = entry;
+
+    while (size > 0)
+    {
+        --size;
+
+        // max_distance might be lowered since the node was pushed
+        if (stack_entry[size] > max_distance)
+            continue;
+
+        const Node& node = nodes_[stack[size]];
+
+        if (node.count > 0)
+        {
+            for (size_t i = node.first; i < node.first + node.count; ++i)
+            {
+                visit(indices_[i]);
+            }
+            continue;
+        }
+
+        size_t left  = node.left;
+        size_t right = node.left + 1;
+
+        double entry_left  = nodes_[left].box.DistanceToEntry(position, direction);
+        double entry_right = nodes_[right].box.DistanceToEntry(position, direction);
+
+        // The closer child is pushed last, so it is visited first
+        if (entry_left > entry_right)
+        {
+            std::swap(left, right);
+            std::swap(entry_left, entry_right);
+        }
+
+        if (entry_right >= 0 && entry_right <= max_distance)
+        {
+            stack[size]         = right;
+            stack_entry[size++] = entry_right;
+        }
+        if (entry_left >= 0 && entry_left <= max_distance)
+        {
+            stack[size]         = left;
+            stack_entry[size++] = entry_left;
+        }
+    }
+}
+
+} // namespace PROPOSAL
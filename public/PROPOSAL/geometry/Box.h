@@ -51,6 +51,7 @@ public:
 
     // Methods
     std::pair<double, double> DistanceToBorder(const Vector3D& position, const Vector3D& direction);
+    BoundingBox GetBoundingBox() const;
 
     // Getter & Setter
     double GetX() const { return x_; }
@@ -0,0 +1,99 @@
+
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+
+#pragma once
+
+#include <vector>
+
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
+#include "PROPOSAL/geometry/Geometry.h"
+
+namespace PROPOSAL {
+
+// ----------------------------------------------------------------------------
+/// @brief Prism of a polygon in the x-y plane extruded along z
+///
+/// The corners of the polygon are given relative to the position of the
+/// geometry, their z coordinates are ignored. The prism extends by half of
+/// the height below and above the position. The edges of the polygon are
+/// sorted into a bounding volume hierarchy, so DistanceToBorder only tests
+/// the edges close to the projection of the trajectory.
+// ----------------------------------------------------------------------------
+class ExtrudedPolygon : public Geometry
+{
+public:
+    ExtrudedPolygon();
+    ExtrudedPolygon(const Vector3D position, const std::vector<Vector3D>& vertices, double height);
+    ExtrudedPolygon(const ExtrudedPolygon&);
+
+    Geometry* clone() const { return new ExtrudedPolygon(*this); };
+    static Geometry* create() { return new ExtrudedPolygon(); }
+    void swap(Geometry&);
+
+    virtual ~ExtrudedPolygon() {}
+
+    // Operators
+    ExtrudedPolygon& operator=(const Geometry&);
+
+    // Methods
+    std::pair<double, double> DistanceToBorder(const Vector3D& position, const Vector3D& direction);
+    BoundingBox GetBoundingBox() const;
+
+    // Getter & Setter
+    const std::vector<Vector3D>& GetVertices() const { return vertices_; }
+    double GetHeight() const { return height_; }
+
+    // ----------------------------------------------------------------------------
+    /// @brief Set the polygon and build the hierarchy of the edges
+    ///
+    /// @param vertices corners relative to the position [cm]
+    // ----------------------------------------------------------------------------
+    void SetVertices(const std::vector<Vector3D>& vertices);
+    void SetHeight(double height) { height_ = height; };
+
+private:
+    bool compare(const Geometry&) const;
+    void print(std::ostream&) const;
+
+    // Distances along the projected trajectory, at which the polygon is
+    // crossed. Inside is set, if the projected position is inside.
+    void CrossPolygon(double x, double y, double direction_x, double direction_y, bool& inside);
+
+    std::vector<Vector3D> vertices_; //!< corners relative to the position, z = 0
+    double height_;                  //!< extent along z
+
+    BoundingVolumeHierarchy tree_;
+
+    // Crossings of the projected trajectory, reused by every call of
+    // DistanceToBorder
+    std::vector<double> crossings_;
+};
+
+} // namespace PROPOSAL
@@ -32,6 +32,7 @@
 #include <iostream>
 #include <map>
 
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
 #include "PROPOSAL/math/Vector3D.h"
 
 namespace PROPOSAL {
@@ -43,6 +44,16 @@ public:
         enum Enum { InfrontGeometry= 0, InsideGeometry, BehindGeometry };
     };
 
+    // Everything known about a particle trajectory from one intersection
+    // with the geometry, see Intersect
+    struct Intersection {
+        Intersection();
+
+        std::pair<double, double> distance; //!< distances to the border, see DistanceToBorder
+        ParticleLocation::Enum location;    //!< see GetLocation
+        double closest_approach;            //!< see DistanceToClosestApproach
+    };
+
 public:
     Geometry(const std::string);
     Geometry(const std::string, const Vector3D position);
@@ -87,11 +98,25 @@ public:
      */
     virtual std::pair<double, double> DistanceToBorder(const Vector3D& position, const Vector3D& direction) = 0;
 
+    /*!
+     * Axis aligned box containing the geometry, which is used to find
+     * the geometries at a position in a BoundingVolumeHierarchy
+     */
+    virtual BoundingBox GetBoundingBox() const = 0;
+
     /*!
      * Calculates the distance to the closest approch to the geometry center
      */
     double DistanceToClosestApproach(const Vector3D& position, const Vector3D& direction);
 
+    /*!
+     * Intersects the particle trajectory once with the geometry and returns
+     * the distances to the border, the location of the particle and the
+     * distance to the closest approach. Gives the same results as
+     * DistanceToBorder, GetLocation and DistanceToClosestApproach.
+     */
+    Intersection Intersect(const Vector3D& position, const Vector3D& direction);
+
     // void swap(Geometry &geometry);
 
     // ----------------------------------------------------------------- //
@@ -29,8 +29,10 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <map>
+#include <vector>
 
 #include "PROPOSAL/geometry/Geometry.h"
 
@@ -43,7 +45,9 @@ public:
     {
         Sphere = 0,
         Box,
-        Cylinder
+        Cylinder,
+        ExtrudedPolygon,
+        TriangleMesh
     };
 
     struct Definition
@@ -56,6 +60,8 @@ public:
             , width(0.0)
             , height(0.0)
             , depth(0.0)
+            , vertices()
+            , triangles()
         {
         }
 
@@ -66,6 +72,8 @@ public:
         double width;
         double height;
         double depth;
+        std::vector<Vector3D> vertices;                      //!< of the polygon or the mesh
+        std::vector<std::array<unsigned int, 3> > triangles; //!< of the mesh
     };
 
     typedef std::function<Geometry*(void)> RegisterFunction;
@@ -0,0 +1,300 @@
+
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/math/Vector3D.h"
+
+namespace PROPOSAL {
+
+class Sphere;
+class Box;
+class Cylinder;
+
+// ----------------------------------------------------------------------------
+/// @brief Intersection kernels of the geometries
+///
+/// The kernels work on plain doubles and use neither the heap nor virtual
+/// calls. The trajectory is described by the interval of the path length
+/// inside the outer surface and the interval inside the hole of a hollow
+/// geometry. Both are calculated with a few selects instead of case
+/// distinctions, so the loops of the batched forms can be vectorized.
+///
+/// The distances follow the convention of Geometry::DistanceToBorder.
+// ----------------------------------------------------------------------------
+namespace GeometryKernels {
+
+// Distances below GEOMETRY_PRECISION mean the position is on the border
+inline double SnapToBorder(double t)
+{
+    return (t > 0 && t < GEOMETRY_PRECISION) ? 0 : t;
+}
+
+// Distances to the border of a geometry, which is entered at enter and left
+// at exit along the trajectory, with a hole from hole_enter to hole_exit.
+// Empty intervals have enter > exit.
+inline void ShellDistance(double enter, double exit, double hole_enter, double hole_exit, double& first, double& second)
+{
+    enter      = SnapToBorder(enter);
+    exit       = SnapToBorder(exit);
+    hole_enter = SnapToBorder(hole_enter);
+    hole_exit  = SnapToBorder(hole_exit);
+
+    // Without a hole the second part is empty
+    double start_1 = enter;
+    double end_1   = std::min(exit, hole_enter);
+    double start_2 = std::max(enter, hole_exit);
+    double end_2   = exit;
+
+    bool use_first_part = start_1 < end_1 && end_1 > 0;
+
+    double start = use_first_part ? start_1 : start_2;
+    double end   = use_first_part ? end_1 : end_2;
+
+    // A position on the border moving outside is not inside
+    bool hit    = start < end && end > 0;
+    bool inside = start <= 0;
+
+    first  = hit ? (inside ? end : start) : -1;
+    second = (hit && !inside) ? end : -1;
+}
+
+// Interval of the trajectory between two parallel planes
+inline void SlabInterval(double plane_neg, double plane_pos, double position, double direction, double& enter, double& exit)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    bool parallel = direction == 0;
+    bool between  = position >= plane_neg && position <= plane_pos;
+
+    double t_neg = (plane_neg - position) / (parallel ? 1 : direction);
+    double t_pos = (plane_pos - position) / (parallel ? 1 : direction);
+
+    enter = parallel ? (between ? -infinity : infinity) : std::min(t_neg, t_pos);
+    exit  = parallel ? (between ? infinity : -infinity) : std::max(t_neg, t_pos);
+}
+
+// Interval of the trajectory inside of a sphere with the squared distance
+// difference_length_squared to the center. projection is the scalar product
+// of the difference to the center with the direction.
+inline void SphereInterval(double difference_length_squared, double projection, double radius, double& enter, double& exit)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    // determinant == 0 (boundary point) is ignored
+    double determinant = projection * projection - (difference_length_squared - radius * radius);
+    double root        = std::sqrt(std::max(determinant, 0.0));
+
+    enter = determinant > 0 ? -projection - root : infinity;
+    exit  = determinant > 0 ? -projection + root : -infinity;
+}
+
+// Interval of the trajectory inside of an infinite cylinder along z
+inline void BarrelInterval(double difference_x,
+                           double difference_y,
+                           double direction_x,
+                           double direction_y,
+                           double radius,
+                           double& enter,
+                           double& exit)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    bool parallel = direction_x == 0 && direction_y == 0;
+
+    double A = difference_x * difference_x + difference_y * difference_y - radius * radius;
+    double B = 2 * (difference_x * direction_x + difference_y * direction_y);
+    double C = direction_x * direction_x + direction_y * direction_y;
+
+    B = parallel ? 0 : B / C;
+    A = parallel ? A : A / C;
+
+    // determinant == 0 (boundary point) is ignored
+    double determinant = 0.25 * B * B - A;
+    double root        = std::sqrt(std::max(determinant, 0.0));
+
+    enter = determinant > 0 ? (parallel ? -infinity : -0.5 * B - root) : infinity;
+    exit  = determinant > 0 ? (parallel ? infinity : -0.5 * B + root) : -infinity;
+}
+
+// ----------------------------------------------------------------------------
+/// @brief Distances to the border of a hollow sphere
+// ----------------------------------------------------------------------------
+inline void SphereDistance(const double center[3],
+                           double radius,
+                           double inner_radius,
+                           const double position[3],
+                           const double direction[3],
+                           double& first,
+                           double& second)
+{
+    double difference_x = position[0] - center[0];
+    double difference_y = position[1] - center[1];
+    double difference_z = position[2] - center[2];
+
+    double difference_length_squared =
+        difference_x * difference_x + difference_y * difference_y + difference_z * difference_z;
+    double projection = difference_x * direction[0] + difference_y * direction[1] + difference_z * direction[2];
+
+    double enter, exit, hole_enter, hole_exit;
+    SphereInterval(difference_length_squared, projection, radius, enter, exit);
+    SphereInterval(difference_length_squared, projection, inner_radius, hole_enter, hole_exit);
+
+    // A trajectory through the center might touch a hole of radius 0
+    hole_enter = inner_radius > 0 ? hole_enter : std::numeric_limits<double>::infinity();
+    hole_exit  = inner_radius > 0 ? hole_exit : std::numeric_limits<double>::infinity();
+
+    ShellDistance(enter, exit, hole_enter, hole_exit, first, second);
+}
+
+// ----------------------------------------------------------------------------
+/// @brief Distances to the border of a box
+///
+/// @param half_width half of the extent in x, y and z
+// ----------------------------------------------------------------------------
+inline void BoxDistance(const double center[3],
+                        const double half_width[3],
+                        const double position[3],
+                        const double direction[3],
+                        double& first,
+                        double& second)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    double enter = -infinity;
+    double exit  = infinity;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        double slab_enter, slab_exit;
+        SlabInterval(center[i] - half_width[i], center[i] + half_width[i], position[i], direction[i], slab_enter, slab_exit);
+
+        enter = std::max(enter, slab_enter);
+        exit  = std::min(exit, slab_exit);
+    }
+
+    ShellDistance(enter, exit, infinity, infinity, first, second);
+}
+
+// ----------------------------------------------------------------------------
+/// @brief Distances to the border of a hollow cylinder along z
+///
+/// The hole goes through the whole cylinder.
+// ----------------------------------------------------------------------------
+inline void CylinderDistance(const double center[3],
+                             double radius,
+                             double inner_radius,
+                             double half_height,
+                             const double position[3],
+                             const double direction[3],
+                             double& first,
+                             double& second)
+{
+    double difference_x = position[0] - center[0];
+    double difference_y = position[1] - center[1];
+
+    double barrel_enter, barrel_exit, slab_enter, slab_exit, hole_enter, hole_exit;
+    BarrelInterval(difference_x, difference_y, direction[0], direction[1], radius, barrel_enter, barrel_exit);
+    SlabInterval(center[2] - half_height, center[2] + half_height, position[2], direction[2], slab_enter, slab_exit);
+    BarrelInterval(difference_x, difference_y, direction[0], direction[1], inner_radius, hole_enter, hole_exit);
+
+    // A trajectory through the axis might touch a hole of radius 0
+    hole_enter = inner_radius > 0 ? hole_enter : std::numeric_limits<double>::infinity();
+    hole_exit  = inner_radius > 0 ? hole_exit : std::numeric_limits<double>::infinity();
+
+    ShellDistance(std::max(barrel_enter, slab_enter),
+                  std::min(barrel_exit, slab_exit),
+                  hole_enter,
+                  hole_exit,
+                  first,
+                  second);
+}
+
+// ----------------------------------------------------------------------------
+/// @brief Parameters of many spheres as structure of arrays
+// ----------------------------------------------------------------------------
+struct SphereArray
+{
+    void Add(const Sphere&);
+    void Clear();
+    size_t GetSize() const { return radius.size(); }
+
+    std::vector<double> x, y, z;
+    std::vector<double> radius;
+    std::vector<double> inner_radius;
+};
+
+// ----------------------------------------------------------------------------
+/// @brief Parameters of many boxes as structure of arrays
+// ----------------------------------------------------------------------------
+struct BoxArray
+{
+    void Add(const Box&);
+    void Clear();
+    size_t GetSize() const { return x.size(); }
+
+    std::vector<double> x, y, z;
+    std::vector<double> half_x, half_y, half_z;
+};
+
+// ----------------------------------------------------------------------------
+/// @brief Parameters of many cylinders as structure of arrays
+// ----------------------------------------------------------------------------
+struct CylinderArray
+{
+    void Add(const Cylinder&);
+    void Clear();
+    size_t GetSize() const { return radius.size(); }
+
+    std::vector<double> x, y, z;
+    std::vector<double> radius;
+    std::vector<double> inner_radius;
+    std::vector<double> half_height;
+};
+
+// ----------------------------------------------------------------------------
+/// @brief Intersects one trajectory with all geometries of an array
+///
+/// @param first, second arrays of GetSize() distances, see
+///        Geometry::DistanceToBorder
+// ----------------------------------------------------------------------------
+void DistanceToBorder(const SphereArray&, const Vector3D& position, const Vector3D& direction, double* first, double* second);
+void DistanceToBorder(const BoxArray&, const Vector3D& position, const Vector3D& direction, double* first, double* second);
+void DistanceToBorder(const CylinderArray&, const Vector3D& position, const Vector3D& direction, double* first, double* second);
+
+} // namespace GeometryKernels
+
+} // namespace PROPOSAL
@@ -0,0 +1,98 @@
+
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
+#include "PROPOSAL/geometry/Geometry.h"
+
+namespace PROPOSAL {
+
+// ----------------------------------------------------------------------------
+/// @brief Closed surface of triangles
+///
+/// The vertices are given relative to the position of the geometry. The
+/// triangles must close the surface, so every edge is shared by exactly two
+/// triangles. Their orientation is made consistent with outward normals.
+/// The triangles are sorted into a bounding volume hierarchy, so
+/// DistanceToBorder only tests the triangles close to the trajectory.
+// ----------------------------------------------------------------------------
+class TriangleMesh : public Geometry
+{
+public:
+    typedef std::array<unsigned int, 3> Triangle;
+
+    TriangleMesh();
+    TriangleMesh(const Vector3D position, const std::vector<Vector3D>& vertices, const std::vector<Triangle>& triangles);
+    TriangleMesh(const TriangleMesh&);
+
+    Geometry* clone() const { return new TriangleMesh(*this); };
+    static Geometry* create() { return new TriangleMesh(); }
+    void swap(Geometry&);
+
+    virtual ~TriangleMesh() {}
+
+    // Operators
+    TriangleMesh& operator=(const Geometry&);
+
+    // Methods
+    std::pair<double, double> DistanceToBorder(const Vector3D& position, const Vector3D& direction);
+    BoundingBox GetBoundingBox() const;
+
+    // Getter & Setter
+    const std::vector<Vector3D>& GetVertices() const { return vertices_; }
+    const std::vector<Triangle>& GetTriangles() const { return triangles_; }
+
+    // ----------------------------------------------------------------------------
+    /// @brief Set the surface and build the hierarchy of the triangles
+    ///
+    /// @param vertices relative to the position [cm]
+    /// @param triangles indices of the vertices
+    // ----------------------------------------------------------------------------
+    void SetMesh(const std::vector<Vector3D>& vertices, const std::vector<Triangle>& triangles);
+
+private:
+    bool compare(const Geometry&) const;
+    void print(std::ostream&) const;
+
+    std::vector<Vector3D> vertices_;  //!< relative to the position
+    std::vector<Triangle> triangles_; //!< counterclockwise seen from outside
+
+    BoundingVolumeHierarchy tree_;
+
+    // Crossings of the trajectory with the surface, reused by every call of
+    // DistanceToBorder. Entering crossings are stored with a positive sign.
+    std::vector<std::pair<double, int> > crossings_;
+};
+
+} // namespace PROPOSAL
@@ -63,6 +63,13 @@ class Integral
 {
 
 public:
+    /**
+     * Integrand evaluating a whole set of sampling points at once.
+     * The first argument holds the points, the second one has to be filled
+     * with the function values (it is resized by the integrand).
+     */
+    typedef std::function<void(const std::vector<double>&, std::vector<double>&)> BatchIntegrand;
+
     /**
      * initializes class with default settings
      */
@@ -147,6 +154,27 @@ public:
 
     //----------------------------------------------------------------------------//
 
+    /*!
+     * like Integrate, but the integrand is called once per refinement step
+     * of the trapezoid rules with all new sampling points of that step, so
+     * parametrizations can evaluate a whole quadrature panel in one call.
+     * Single points (first step, qags fallback) are passed as a vector of size one.
+     *
+     * \param   min             lower integration limit
+     * \param   max             upper integration limit
+     * \param   integrand       integrand evaluated on an array of points
+     * \param   method          integration method
+     * \return  Integration result
+     */
+
+    double IntegrateBatch(double min,
+                          double max,
+                          BatchIntegrand integrand,
+                          int method,
+                          double powerOfSubstitution = 0);
+
+    //----------------------------------------------------------------------------//
+
     // --------------------------------------------------------------------- //
     // Getter
     // --------------------------------------------------------------------- //
@@ -233,6 +261,15 @@ private:
 
     std::function<double(double)> integrand_;
 
+    // only set during IntegrateBatch
+    BatchIntegrand batch_integrand_;
+
+    // buffers for the sampling points of one trapezoid step
+    std::vector<double> panel_x_;
+    std::vector<double> panel_t_;
+    std::vector<double> panel_weight_;
+    std::vector<double> panel_f_;
+
     int romberg4refine_; // set to 2 in constructor
     double powerOfSubstitution_;
     bool randomDo_; // set to false in Constructor
@@ -383,6 +420,15 @@ private:
 
     //----------------------------------------------------------------------------//
 
+    /*!
+     * Evaluates Function for all points stored in panel_x_ and writes the
+     * results to panel_f_. If a batch integrand is set, the substitutions are
+     * applied to all points and the integrand is called once.
+     */
+    void EvaluatePanel();
+
+    //----------------------------------------------------------------------------//
+
     /*!
      * Interpolates the integral value by interpolating/extrapolating the value
      * on the basis of the last "romberg" integral values. Mostly it is used with
@@ -0,0 +1,139 @@
+
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace PROPOSAL {
+
+/**
+ * Cubic interpolation of a function tabulated on an equidistant grid.
+ *
+ * In contrast to Interpolant, no search for the grid point is needed, so
+ * a lookup is only a few multiplications. It is meant for smooth functions
+ * which are evaluated very often with a fixed range, e.g. inner parts of
+ * differential cross sections. The four nodes around x are interpolated
+ * by a Lagrange polynomial; at the borders the stencil is shifted inwards.
+ * Values outside [x_min, x_max] are extrapolated and should be avoided.
+ */
+class UniformGridInterpolant1D
+{
+public:
+    UniformGridInterpolant1D();
+    UniformGridInterpolant1D(std::function<double(double)> function,
+                             double x_min,
+                             double x_max,
+                             unsigned int number_of_points);
+    UniformGridInterpolant1D(const std::vector<double>& y, double x_min, double x_max);
+
+    bool operator==(const UniformGridInterpolant1D&) const;
+    bool operator!=(const UniformGridInterpolant1D&) const;
+
+    double Interpolate(double x) const
+    {
+        double u  = (x - x_min_) * inverse_step_;
+        int first = std::min(std::max(static_cast<int>(u) - 1, 0), static_cast<int>(y_.size()) - 4);
+        double t  = u - first;
+
+        const double* y = &y_[first];
+
+        double t1 = t - 1;
+        double t2 = t - 2;
+        double t3 = t - 3;
+
+        return (-y[0] * t1 * t2 * t3 + y[3] * t * t1 * t2) / 6 + (y[1] * t * t2 * t3 - y[2] * t * t1 * t3) / 2;
+    }
+
+    double GetXMin() const { return x_min_; }
+    double GetXMax() const { return x_max_; }
+    const std::vector<double>& GetY() const { return y_; }
+
+private:
+    void CheckGrid();
+
+    double x_min_;
+    double x_max_;
+    double inverse_step_;
+    std::vector<double> y_;
+};
+
+/**
+ * Polynomial interpolation of a two dimensional table with rows on an
+ * equidistant grid in x1, each row tabulated on its own grid which is
+ * equidistant in log(x2), like the tables in ParamTables.
+ *
+ * The result is the same as the one of Interpolant::InterpolateArray(x1, x2)
+ * with the given romberg order for both axes, but the nodes are found from
+ * the grid spacing instead of a binary search and the denominators of the
+ * Lagrange polynomials of every stencil are computed once in the constructor.
+ */
+class UniformGridInterpolant2D
+{
+public:
+    UniformGridInterpolant2D(const std::vector<double>& x1,
+                             const std::vector<std::vector<double> >& x2,
+                             const std::vector<std::vector<double> >& y,
+                             int romberg);
+
+    bool operator==(const UniformGridInterpolant2D&) const;
+    bool operator!=(const UniformGridInterpolant2D&) const;
+
+    double Interpolate(double x1, double x2) const;
+
+    int GetRomberg() const { return romberg_; }
+
+private:
+    struct Axis
+    {
+        Axis();
+        Axis(const std::vector<double>& nodes, int romberg, bool log_spacing);
+
+        int FindStart(double x) const;
+        void Weights(double x, int start, double* weights) const;
+
+        std::vector<double> nodes_;
+        std::vector<double> inverse_denominators_;
+        double origin_;
+        double inverse_step_;
+        bool log_spacing_;
+        int romberg_;
+    };
+
+    static const int max_romberg_ = 16;
+
+    int romberg_;
+    Axis x1_axis_;
+    std::vector<Axis> x2_axes_;
+    std::vector<std::vector<double> > y_;
+};
+
+} // namespace PROPOSAL
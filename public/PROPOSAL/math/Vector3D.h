@@ -34,18 +34,27 @@
 
 namespace PROPOSAL {
 
+// Cartesian vector. Spherical coordinates are not stored, but calculated
+// on demand, so a vector is just its three coordinates.
 class Vector3D
 {
 public:
+    struct SphericalCoordinates
+    {
+        double radius;
+        double azimuth;
+        double zenith;
+    };
+
     // constructors
     Vector3D();
     Vector3D(const double x, const double y, const double z);
-    Vector3D(const Vector3D& vector_3d);
-    ~Vector3D();
+    Vector3D(const Vector3D& vector_3d) = default;
+    ~Vector3D() = default;
 
     //-------------------------------------//
     // operator functions and swap
-    Vector3D& operator=(const Vector3D& vector_3d);
+    Vector3D& operator=(const Vector3D& vector_3d) = default;
     bool operator==(const Vector3D& vector_3d) const;
     bool operator!=(const Vector3D& vector_3d) const;
     void swap(Vector3D& vector_3d);
@@ -65,11 +74,13 @@ public:
     void normalise();
 
     //-------------------------------------//
-    // conversions to spherical and cylindrical coordinate
-    void CalculateCartesianFromSpherical();
-    void CalculateSphericalCoordinates();
-    // void CalculateCartesianFromCylindrical();
-    // void CalculateCylindricalCoordinates();
+    // conversions to spherical coordinates
+    SphericalCoordinates GetSphericalCoordinates() const;
+
+    // The cartesian and spherical coordinates are always consistent, so
+    // these conversions have nothing left to do. Kept for compatibility.
+    void CalculateCartesianFromSpherical() {}
+    void CalculateSphericalCoordinates() {}
 
     //-------------------------------------//
     // setter
@@ -79,33 +90,25 @@ public:
         y_ = y;
         z_ = z;
     }
-    void SetSphericalCoordinates(const double radius, const double azimuth, const double zenith)
-    {
-        spheric_radius_  = radius;
-        spheric_azimuth_ = azimuth;
-        spheric_zenith_  = zenith;
-    }
-    // void SetCylindricalCoordinates(const double radius, const double azimuth, const double height)
-    // {
-    //     cylindric_radius_  = radius;
-    //     cylindric_azimuth_ = azimuth;
-    //     cylindric_height_  = height;
-    // }
+
+    // Sets the cartesian coordinates of the given spherical coordinates
+    void SetSphericalCoordinates(const double radius, const double azimuth, const double zenith);
 
     //-------------------------------------//
     // getter
     double GetX() const { return x_; }
     double GetY() const { return y_; }
     double GetZ() const { return z_; }
-    double GetRadius() const { return spheric_radius_; }
-    double GetPhi() const { return spheric_azimuth_; }
-    double GetTheta() const { return spheric_zenith_; }
+
+    // Spherical coordinates, each one calculated on demand. Use
+    // GetSphericalCoordinates to get all of them at once.
+    double GetRadius() const { return magnitude(); }
+    double GetPhi() const { return GetSphericalCoordinates().azimuth; }
+    double GetTheta() const { return GetSphericalCoordinates().zenith; }
 
     //----------------------------------------------//
 private:
     double x_, y_, z_;
-    double spheric_radius_, spheric_azimuth_, spheric_zenith_;
-    // double cylindric_radius_, cylindric_azimuth_, cylindric_height_;
 };
 
 } // namespace PROPOSAL
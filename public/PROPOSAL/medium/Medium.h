@@ -84,6 +84,12 @@ class Medium {
     Medium& operator=(const Medium&);
     bool operator==(const Medium& medium) const;
     bool operator!=(const Medium& medium) const;
+
+    // Compares everything but the density distribution. The cross sections
+    // just depend on these, as the density distribution only corrects the
+    // grammage while propagating.
+    bool HasSameComposition(const Medium& medium) const;
+
     friend std::ostream& operator<<(std::ostream& os, Medium const& medium);
 
     // ----------------------------------------------------------------- //
@@ -29,8 +29,15 @@
 #include <exception>
 #include <functional>
 #include <string>
+#include <utility>
+#include <vector>
 #include "PROPOSAL/math/Vector3D.h"
 
+namespace PROPOSAL {
+class Geometry;
+struct BoundingBox;
+}  // namespace PROPOSAL
+
 namespace PROPOSAL {
 class Axis {
    public:
@@ -49,6 +56,9 @@ class Axis {
     virtual double GetEffectiveDistance(const Vector3D& xi,
                                         const Vector3D& direction) const = 0;
 
+    /// Smallest and largest depth of the points inside the box
+    virtual std::pair<double, double> GetDepthRange(const BoundingBox&) const = 0;
+
     Vector3D GetAxis() const { return fAxis_; };
     Vector3D GetFp0() const { return fp0_; };
 
@@ -69,6 +79,7 @@ class RadialAxis : public Axis {
 
     double GetDepth(const Vector3D& xi) const override;
     double GetEffectiveDistance(const Vector3D& xi, const Vector3D& direction) const override;
+    std::pair<double, double> GetDepthRange(const BoundingBox&) const override;
 };
 }  // namespace PROPOSAL
 
@@ -83,6 +94,7 @@ class CartesianAxis : public Axis {
 
     double GetDepth(const Vector3D& xi) const override;
     double GetEffectiveDistance(const Vector3D& xi, const Vector3D& direction) const override;
+    std::pair<double, double> GetDepthRange(const BoundingBox&) const override;
 };
 }  // namespace PROPOSAL
 
@@ -97,6 +109,56 @@ class DensityException : public std::exception {
 };
 }  // namespace PROPOSAL
 
+namespace PROPOSAL {
+// ----------------------------------------------------------------------------
+/// @brief Tabulated antiderivative of a density distribution and its inverse
+///
+/// The antiderivative of the density is sampled at equidistant depths. As its
+/// derivative, the density, is known at the nodes too, the inverse is a cubic
+/// Hermite interpolation between the nodes, so no root finding is needed to
+/// get the depth of a given antiderivative. This requires a positive density
+/// over the tabulated depths.
+///
+/// The number of nodes is doubled, starting at 256, till the error of the
+/// inverse between the nodes is below the precision times the tabulated
+/// depth range. If this needs more than max_nodes, e.g. for the depths of a
+/// huge world geometry, nothing is tabulated and Correct searches the
+/// distance iteratively.
+// ----------------------------------------------------------------------------
+class GrammageTable {
+   public:
+    GrammageTable();
+    GrammageTable(std::function<double(double)> density,
+                  std::function<double(double)> antiderivative,
+                  double depth_min,
+                  double depth_max,
+                  double precision = 1e-8,
+                  unsigned int max_nodes = 65536);
+
+    bool IsTabulated() const { return !grammage_.empty(); }
+    bool Contains(double depth) const;
+    unsigned int GetNumberOfNodes() const { return grammage_.size(); }
+
+    /// Depth at which the antiderivative equals the given grammage, NaN if
+    /// it lies outside the tabulated depths
+    double GetDepth(double grammage) const;
+
+   private:
+    // Samples the antiderivative at equidistant depths, false if it is not
+    // strictly increasing
+    bool Tabulate(const std::function<double(double)>& density,
+                  const std::function<double(double)>& antiderivative,
+                  unsigned int nodes);
+
+    double depth_min_;
+    double depth_max_;
+    double step_;
+
+    std::vector<double> grammage_;
+    std::vector<double> density_;
+};
+}  // namespace PROPOSAL
+
 namespace PROPOSAL {
 class Density_distr {
    public:
@@ -125,9 +187,37 @@ class Density_distr {
                              double distance) const = 0;
     virtual double Evaluate(const Vector3D& xi) const = 0;
 
+    // ----------------------------------------------------------------------------
+    /// @brief Tabulates the integrated density over the depths of the geometry
+    ///
+    /// Afterwards Correct inverts the table for trajectories staying inside
+    /// the tabulated depths instead of searching the distance iteratively.
+    /// Distributions with a closed form inverse ignore it.
+    // ----------------------------------------------------------------------------
+    void BuildGrammageTable(const Geometry&);
+
     const Axis& GetAxis() const { return *axis_; }
+    const GrammageTable& GetGrammageTable() const { return grammage_table_; }
 
    protected:
+    /// Tabulates the antiderivative between the depths, if the distribution
+    /// has no closed form inverse
+    virtual void TabulateGrammage(double depth_min, double depth_max) {
+        (void)depth_min;
+        (void)depth_max;
+    };
+
+    // Distance along the trajectory, at which the antiderivative reaches the
+    // grammage, using the linear approximation depth + l * delta of the
+    // depth. Returns false if the trajectory leaves the tabulated depths
+    // before the border, infinity if the grammage is not reached before it.
+    bool InvertGrammageTable(double depth,
+                             double delta,
+                             double grammage,
+                             double distance_to_border,
+                             double& distance) const;
+
     Axis* axis_;
+    GrammageTable grammage_table_;
 };
 }  // namespace PROPOSAL
@@ -0,0 +1,113 @@
+
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+
+#pragma once
+#include <memory>
+#include <vector>
+#include "PROPOSAL/medium/density_distr/density_distr.h"
+
+namespace PROPOSAL {
+// ----------------------------------------------------------------------------
+/// @brief Stack of spherical layers with their own density distributions
+///
+/// The layers are shells around the reference point of the radial axis.
+/// Each one reaches from the radius of the layer below up to its own radius,
+/// the outermost layer continues to infinity. This describes an Earth or an
+/// atmosphere profile within a single sector.
+///
+/// As all density distributions, the layers give the density relative to
+/// the mass density of the medium, so all layers share the physics tables of
+/// the sector. The grammage of a trajectory is the sum over the layers it
+/// crosses, each calculated with the distribution of the layer.
+///
+/// The radial axis of the stack only decides on the layers. The density
+/// inside of a layer depends on the axis of its own distribution, so a
+/// radial profile, e.g. an exponential atmosphere, needs a RadialAxis
+/// around the same reference point for every layer.
+///
+/// There is no closed form antiderivative over all layers. Integrate is the
+/// grammage from the position on, which vanishes at l = 0, so Calculate is
+/// Integrate(l) - Integrate(0) as for the other distributions, but unlike
+/// them the value depends on the position along the trajectory.
+// ----------------------------------------------------------------------------
+class Density_layered : public Density_distr {
+   public:
+    Density_layered();
+    Density_layered(const RadialAxis&);
+    Density_layered(const Density_layered&);
+
+    bool compare(const Density_distr& dens_distr) const override;
+
+    Density_distr* clone() const override {
+        return new Density_layered(*this);
+    };
+
+    /// Adds a layer on top of the others up to the radius in cm. The
+    /// density of the layer is evaluated along its own axis.
+    void AddLayer(double radius, const Density_distr& density);
+
+    double Correct(const Vector3D& xi,
+                   const Vector3D& direction,
+                   double res,
+                   double distance_to_border) const override;
+    double Integrate(const Vector3D& xi,
+                     const Vector3D& direction,
+                     double l) const override;
+    double Calculate(const Vector3D& xi,
+                     const Vector3D& direction,
+                     double distance) const override;
+    double Evaluate(const Vector3D& xi) const override;
+
+    unsigned int GetNumberOfLayers() const { return layers_.size(); }
+    const std::vector<double>& GetRadii() const { return radii_; }
+
+    /// Index of the layer containing the position
+    unsigned int GetLayer(const Vector3D& xi) const;
+
+   private:
+    // Sorted distances along the trajectory, at which it crosses the borders
+    // between the layers in front of distance, followed by distance itself.
+    // The crossed borders are found by binary search in the radii.
+    std::vector<double> GetSegments(const Vector3D& xi,
+                                    const Vector3D& direction,
+                                    double distance) const;
+
+    // Layer of the segment of the trajectory between start and end
+    const Density_distr& GetSegmentLayer(const Vector3D& xi,
+                                         const Vector3D& direction,
+                                         double start,
+                                         double end) const;
+
+    std::vector<double> radii_;
+
+    // The layers are not changed after they are added, so copies share them
+    std::vector<std::shared_ptr<const Density_distr> > layers_;
+};
+}  // namespace PROPOSAL
@@ -39,6 +39,8 @@ class Density_polynomial : public Density_distr {
                            double l) const;
 
    protected:
+    void TabulateGrammage(double depth_min, double depth_max) override;
+
     Polynom polynom_;
     Polynom Polynom_;
 
@@ -47,9 +47,34 @@ class Density_splines : public Density_distr {
                            double l) const;
 
    protected:
+    void TabulateGrammage(double depth_min, double depth_max) override;
+
+    // Copies the polynomials of the segments, so they can be evaluated
+    // without searching the segment linearly
+    void InitSegments();
+
+    // Segment containing the depth, the outer segments continue beyond the
+    // domain of the spline
+    unsigned int GetSegment(double depth) const;
+
+    // Depth inside the segment, at which the antiderivative reaches the
+    // grammage. The antiderivative is a polynomial of low degree with the
+    // density as derivative, so a bracketed Newton method converges in a few
+    // steps.
+    double InvertSegment(unsigned int segment, double grammage) const;
+
     Spline* spline_;
     Spline* integrated_spline_;
 
+    std::vector<double> subintervalls_;
+    std::vector<std::vector<double>> density_coefficients_;
+    std::vector<std::vector<double>> antiderivative_coefficients_;
+
+    // Antiderivative at the borders of the segments. Only if it increases
+    // strictly, the antiderivative is inverted segment by segment.
+    std::vector<double> antiderivative_nodes_;
+    bool invertible_;
+
     std::function<double(double)> density_distribution;
     std::function<double(double)> antiderived_density_distribution;
 };
@@ -107,6 +107,8 @@ struct InterpolationDef
         , nodes_propagate(1000)
         , do_binary_tables(true)
         , just_use_readonly_path(false)
+        , do_cut_independent_dndx(false)
+        , cut_independent_min_loss(0.1)
     {
     }
 
@@ -119,6 +121,8 @@ struct InterpolationDef
     int nodes_propagate;
     bool do_binary_tables;
     bool just_use_readonly_path;
+    bool do_cut_independent_dndx;    //!< share the dNdx tables of one process between all cut settings
+    double cut_independent_min_loss; //!< smallest energy loss [MeV] covered by the shared dNdx tables
 
     size_t GetHash() const;
 };
@@ -198,6 +202,23 @@ void InitializeInterpolation(const std::string name,
                              const std::vector<Parametrization*>&,
                              const InterpolationDef);
 
+// ----------------------------------------------------------------------------
+/// @brief Helper for interpolation initialization
+///
+/// Same as above, but the caller provides the hash identifying the tables.
+/// This is used for tables which do not depend on every property of the
+/// parametrization, e.g. the cut independent dNdx tables.
+///
+/// @param name: subject of resulting file name
+/// @param InterpolantBuilderContainer:
+///        vector of builder, pointer to Interplant pairs
+/// @param hash_digest: hash of the physics the tables are built for
+// ----------------------------------------------------------------------------
+void InitializeInterpolation(const std::string name,
+                             InterpolantBuilderContainer&,
+                             size_t hash_digest,
+                             const InterpolationDef);
+
 // ----------------------------------------------------------------------------
 /// @brief Simple map structure where keys and values can be used for indexing
 // ----------------------------------------------------------------------------
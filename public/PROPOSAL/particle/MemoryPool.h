@@ -0,0 +1,113 @@
+
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace PROPOSAL {
+
+// ----------------------------------------------------------------------------
+/// @brief Free list pool for small objects created per event
+///
+/// Memory is taken from large chunks and handed out in size classes of
+/// 16 bytes. Released memory is put on the free list of its size class and
+/// reused by the next allocation of that size, so once a few events are
+/// propagated, the objects allocated through the pool (secondaries, decay
+/// products and particles) no longer call malloc and free themselves. Their
+/// members still may: a copy of a particle copies its ParticleDef including
+/// the decay table. The chunks are kept for the whole run. Requests larger
+/// than the largest size class are forwarded to the global operator new.
+///
+/// Every thread has its own pool, so propagators in different threads do
+/// not share the free lists. Each block is tagged with the pool it was
+/// taken from. Memory released by another thread is handed back to that
+/// pool over a locked list, which the owning thread collects once its own
+/// free list of the size class is empty. Therefore a thread propagating
+/// events, whose secondaries are deleted by a consumer thread, reuses its
+/// memory as well. The pool of a finished thread is handed over to the
+/// next new thread.
+// ----------------------------------------------------------------------------
+class MemoryPool
+{
+public:
+    /// Pool of the calling thread
+    static MemoryPool& Get();
+
+    void* Allocate(std::size_t size);
+    void Deallocate(void* ptr, std::size_t size);
+
+    std::size_t GetNumberOfChunks() const { return chunks_.size(); }
+
+private:
+    MemoryPool();
+    ~MemoryPool();
+
+    MemoryPool(const MemoryPool&);            // Undefined & not allowed
+    MemoryPool& operator=(const MemoryPool&); // Undefined & not allowed
+
+    // Pools are never deleted, so objects may still be released during the
+    // destruction of the thread or of the static objects
+    static MemoryPool* Acquire();
+
+    // Memory released by another thread
+    void DeallocateRemote(void* ptr, std::size_t size_class);
+    void CollectRemote();
+
+    struct FreeNode
+    {
+        FreeNode* next;
+    };
+
+    // Precedes every block, padded to keep the alignment of the granularity
+    union BlockHeader
+    {
+        MemoryPool* owner;
+        char padding[16];
+    };
+
+    static const std::size_t granularity_ = 16;
+    static const std::size_t max_size_    = 1024;
+    static const std::size_t chunk_size_  = 64 * 1024;
+
+    std::vector<FreeNode*> free_lists_; //!< one list per size class
+    std::vector<char*> chunks_;
+    char* chunk_position_;
+    char* chunk_end_;
+
+    std::mutex remote_mutex_;
+    std::vector<FreeNode*> remote_free_lists_; //!< released by other threads, guarded by remote_mutex_
+    std::atomic<bool> remote_pending_;         //!< set, if remote_free_lists_ are not empty
+};
+
+} // namespace PROPOSAL
@@ -32,6 +32,7 @@
 #include <string>
 
 #include "PROPOSAL/math/Vector3D.h"
+#include "PROPOSAL/particle/MemoryPool.h"
 #include "PROPOSAL/particle/ParticleDef.h"
 
 namespace PROPOSAL {
@@ -61,6 +62,11 @@ public:
 
     friend std::ostream& operator<<(std::ostream&, DynamicData const&);
 
+    // Secondaries and decay products are created and deleted many times per
+    // event, so they are taken from the MemoryPool. This includes particles.
+    static void* operator new(std::size_t size) { return MemoryPool::Get().Allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { MemoryPool::Get().Deallocate(ptr, size); }
+
     // --------------------------------------------------------------------- //
     // Getter & Setter
     // --------------------------------------------------------------------- //
@@ -73,10 +79,12 @@ public:
     void SetParentParticleEnergy(double parent_particle_energy) { parent_particle_energy_ = parent_particle_energy; }
     void SetTime(double time) { time_ = time; }
     void SetPropagatedDistance(double prop_dist) { propagated_distance_ = prop_dist; }
+    void SetWeight(double weight) { weight_ = weight; }
 
     // Getter
     Type GetTypeId() const { return type_id_; }
     static std::string GetNameFromType(Type);
+    static Type GetTypeFromName(const std::string&);
 
     Vector3D GetPosition() const { return position_; }
     Vector3D GetDirection() const { return direction_; }
@@ -85,6 +93,7 @@ public:
     double GetParentParticleEnergy() const { return parent_particle_energy_; }
     double GetTime() const { return time_; }
     double GetPropagatedDistance() const { return propagated_distance_; }
+    double GetWeight() const { return weight_; }
 
 protected:
     virtual void print(std::ostream&) const {}
@@ -98,6 +107,7 @@ protected:
     double parent_particle_energy_; //!< energy of the parent particle
     double time_;                   //!< age [sec]
     double propagated_distance_;    //!< propagation distance [cm]
+    double weight_;                 //!< likelihood ratio of a biased propagation, 1 if unbiased
 };
 
 // ----------------------------------------------------------------------------
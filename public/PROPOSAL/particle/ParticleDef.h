@@ -127,6 +127,16 @@ struct ParticleDef
 
     const ParticleDef* GetWeakPartner() const;
 
+    // ----------------------------------------------------------------------------
+    /// @brief Shared instance of an equal definition
+    ///
+    /// Returns a definition equal to the given one, which is created on the
+    /// first request and kept until the end of the program. It can be
+    /// referenced by secondary records instead of copying the definition for
+    /// every secondary. The lookup is thread safe.
+    // ----------------------------------------------------------------------------
+    static const ParticleDef& GetShared(const ParticleDef&);
+
     bool operator==(const ParticleDef&) const;
     bool operator!=(const ParticleDef&) const;
 
@@ -0,0 +1,132 @@
+
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+
+#pragma once
+
+#include "PROPOSAL/math/Vector3D.h"
+#include "PROPOSAL/particle/Particle.h"
+
+namespace PROPOSAL {
+
+// ----------------------------------------------------------------------------
+/// @brief Compact record of a secondary
+///
+/// Plain data which is stored by value in the secondary output, so no heap
+/// allocation is needed per secondary. Produced particles and decay products
+/// refer to a shared ParticleDef (see ParticleDef::GetShared) instead of
+/// copying it. For energy losses the definition is NULL.
+// ----------------------------------------------------------------------------
+struct Secondary
+{
+    DynamicData::Type type_id;
+    const ParticleDef* particle_def; //!< shared definition of a particle, NULL for energy losses
+
+    double position[3];            //!< position coordinates [cm]
+    double direction[3];           //!< direction vector
+    double energy;                 //!< energy [MeV]
+    double parent_particle_energy; //!< energy of the parent particle
+    double time;                   //!< age [sec]
+    double propagated_distance;    //!< propagation distance [cm]
+    double weight;                 //!< weight of the parent particle after the loss or decay
+
+    void SetPosition(const Vector3D& vec)
+    {
+        position[0] = vec.GetX();
+        position[1] = vec.GetY();
+        position[2] = vec.GetZ();
+    }
+    void SetDirection(const Vector3D& vec)
+    {
+        direction[0] = vec.GetX();
+        direction[1] = vec.GetY();
+        direction[2] = vec.GetZ();
+    }
+
+    Vector3D GetPosition() const;
+    Vector3D GetDirection() const;
+
+    // ----------------------------------------------------------------------------
+    /// @brief Create a record from a DynamicData or a Particle
+    ///
+    /// The definition of a particle is replaced by the shared one.
+    // ----------------------------------------------------------------------------
+    static Secondary Create(const DynamicData&);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Create a new DynamicData (or a Particle for particles) from this record
+    ///
+    /// The caller takes ownership.
+    // ----------------------------------------------------------------------------
+    DynamicData* CreateDynamicData() const;
+};
+
+// ----------------------------------------------------------------------------
+/// @brief Receiver of secondaries
+///
+/// If a sink is given to the propagation, every loss and every produced or
+/// decay particle is passed to Fill as soon as it happens and nothing is
+/// stored by the Output. The record is only valid during the call.
+// ----------------------------------------------------------------------------
+class SecondarySink
+{
+public:
+    virtual ~SecondarySink() {}
+
+    virtual void Fill(const Secondary&) = 0;
+};
+
+// ----------------------------------------------------------------------------
+/// @brief Sink calling a function or lambda for every secondary
+///
+/// The function is a template parameter, so it is inlined into Fill.
+/// Use MakeSecondaryCallback to create it.
+// ----------------------------------------------------------------------------
+template <class Function>
+class SecondaryCallback : public SecondarySink
+{
+public:
+    SecondaryCallback(Function function)
+        : function_(function)
+    {
+    }
+
+    void Fill(const Secondary& secondary) { function_(secondary); }
+
+private:
+    Function function_;
+};
+
+template <class Function>
+SecondaryCallback<Function> MakeSecondaryCallback(Function function)
+{
+    return SecondaryCallback<Function>(function);
+}
+
+} // namespace PROPOSAL
@@ -0,0 +1,114 @@
+
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+
+#pragma once
+
+#include <vector>
+
+#include "PROPOSAL/particle/Secondary.h"
+
+namespace PROPOSAL {
+
+// ----------------------------------------------------------------------------
+/// @brief Secondaries stored as columns
+///
+/// Every quantity of the secondaries is stored in its own contiguous array,
+/// which grows amortized. The raw column pointers can be handed to code which
+/// streams through a single quantity, e.g. wrapped as numpy arrays without
+/// copying. The pointers are invalidated when the buffer grows or is cleared.
+/// As a SecondarySink the buffer can be filled directly by the propagation.
+// ----------------------------------------------------------------------------
+class SecondaryBuffer : public SecondarySink
+{
+public:
+    SecondaryBuffer();
+
+    bool operator==(const SecondaryBuffer&) const;
+    bool operator!=(const SecondaryBuffer&) const;
+
+    // --------------------------------------------------------------------- //
+    // Methods
+    // --------------------------------------------------------------------- //
+
+    void Push(const Secondary&);
+    void Fill(const Secondary& secondary) { Push(secondary); }
+    void Append(const std::vector<Secondary>&);
+
+    void Reserve(size_t size);
+    void Clear();
+
+    // ----------------------------------------------------------------------------
+    /// @brief Record of the i-th secondary
+    // ----------------------------------------------------------------------------
+    Secondary Get(size_t index) const;
+
+    // --------------------------------------------------------------------- //
+    // Getter
+    // --------------------------------------------------------------------- //
+
+    size_t GetSize() const { return type_id_.size(); }
+
+    const int* GetTypeId() const { return type_id_.data(); } //!< values of DynamicData::Type
+    const ParticleDef* const* GetParticleDef() const { return particle_def_.data(); }
+
+    const double* GetX() const { return x_.data(); }
+    const double* GetY() const { return y_.data(); }
+    const double* GetZ() const { return z_.data(); }
+
+    const double* GetDirectionX() const { return direction_x_.data(); }
+    const double* GetDirectionY() const { return direction_y_.data(); }
+    const double* GetDirectionZ() const { return direction_z_.data(); }
+
+    const double* GetEnergy() const { return energy_.data(); }
+    const double* GetParentParticleEnergy() const { return parent_particle_energy_.data(); }
+    const double* GetTime() const { return time_.data(); }
+    const double* GetPropagatedDistance() const { return propagated_distance_.data(); }
+    const double* GetWeight() const { return weight_.data(); }
+
+private:
+    std::vector<int> type_id_;
+    std::vector<const ParticleDef*> particle_def_;
+
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> z_;
+
+    std::vector<double> direction_x_;
+    std::vector<double> direction_y_;
+    std::vector<double> direction_z_;
+
+    std::vector<double> energy_;
+    std::vector<double> parent_particle_energy_;
+    std::vector<double> time_;
+    std::vector<double> propagated_distance_;
+    std::vector<double> weight_;
+};
+
+} // namespace PROPOSAL
@@ -48,6 +48,7 @@
 namespace PROPOSAL {
 
 class CrossSection;
+class Density_distr;
 class Medium;
 
 struct InterpolationDef;
@@ -127,7 +128,9 @@ class UtilityDecorator {
     // Methods
     virtual double FunctionToIntegral(double energy);
     virtual double Calculate(double ei, double ef, double rnd) = 0;
-    virtual double Calculate(double, double, double, Vector3D, Vector3D);
+    // Calculate along the trajectory, the density correction is applied with
+    // the given density distribution
+    virtual double Calculate(double, double, double, Vector3D, Vector3D, const Density_distr&);
     virtual double GetUpperLimit(double ei, double rnd) = 0;
 
     const Utility& GetUtility() const { return utility_; }
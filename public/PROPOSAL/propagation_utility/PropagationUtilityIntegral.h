@@ -101,7 +101,8 @@ class UtilityIntegralDisplacement : public UtilityIntegral {
                      double ef,
                      double rnd,
                      Vector3D xi,
-                     Vector3D direction);
+                     Vector3D direction,
+                     const Density_distr& density);
 
    private:
     UtilityDecorator& operator=(
@@ -141,7 +141,12 @@ public:
 
     // Methods
     double Calculate(double ei, double ef, double rnd);
-    double Calculate(double ei, double ef, double rnd, Vector3D xi, Vector3D direction);
+    double Calculate(double ei,
+                     double ef,
+                     double rnd,
+                     Vector3D xi,
+                     Vector3D direction,
+                     const Density_distr& density);
     double GetUpperLimit(double ei, double rnd);
 
 private:
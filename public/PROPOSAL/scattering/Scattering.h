@@ -29,8 +29,12 @@
 
 #pragma once
 
+#include <memory>
+
 namespace PROPOSAL {
 
+class Density_distr;
+class Medium;
 class Particle;
 class Utility;
 
@@ -49,6 +53,11 @@ public:
 
     void Scatter(double dr, double ei, double ef);
 
+    // The density at the particle position is taken from the given
+    // distribution instead of the medium, e.g. if the scattering is shared
+    // between sectors with different density corrections
+    void SetDensityDistribution(const Density_distr&);
+
     const Particle& GetParticle() const { return particle_; }
 
 protected:
@@ -64,7 +73,11 @@ protected:
 
     virtual RandomAngles CalculateRandomAngle(double dr, double ei, double ef) = 0;
 
+    // Density distribution of the medium, if none is set
+    const Density_distr& GetDensityDistribution(const Medium&) const;
+
     Particle& particle_;
+    std::shared_ptr<const Density_distr> density_distr_;
 };
 
 } // namespace PROPOSAL
@@ -30,8 +30,11 @@
 
 // #include <string>
 // #include <vector>
+#include <map>
+#include <memory>
 
 #include "PROPOSAL/particle/Particle.h"
+#include "PROPOSAL/particle/Secondary.h"
 #include "PROPOSAL/scattering/ScatteringFactory.h"
 
 #include "PROPOSAL/propagation_utility/PropagationUtility.h"
@@ -39,6 +42,7 @@
 namespace PROPOSAL {
 
 class ContinuousRandomizer;
+class SurvivalTable;
 // class CrossSection;
 // class Medium;
 // class EnergyCutSettings;
@@ -64,17 +68,35 @@ class Sector {
         Definition& operator=(const Definition&);
         void swap(Definition&);
 
+        // Compares everything needed to build the physics of a sector,
+        // i.e. everything but the geometry, the location and the options
+        // just used while propagating. The physics is tabulated for the
+        // medium without density correction, so the density distributions
+        // of the media may differ.
+        bool HasSamePhysics(const Definition&) const;
+
         void SetMedium(const Medium&);
         const Medium& GetMedium() const { return *medium_; }
 
         void SetGeometry(const Geometry&);
         const Geometry& GetGeometry() const { return *geometry_; }
 
+        // The cuts the physics is built with. With range propagation all
+        // losses are continuous, otherwise these are the cut_settings. The
+        // survival tables of range propagation sample all losses above 1%
+        // of the energy, independent of the cut_settings.
+        EnergyCutSettings GetPropagationCutSettings() const;
+
         bool do_stochastic_loss_weighting;  //!< Do weigthing of stochastic
                                             //!< losses. Set to false in
                                             //!< constructor.
         double stochastic_loss_weighting;  //!< weigth of stochastic losses. Set
                                            //!< to 0 in constructor
+        std::map<DynamicData::Type, double>
+            interaction_bias;  //!< factors the probability to choose an
+                               //!< interaction type is scaled with. The
+                               //!< total interaction rate is unchanged.
+                               //!< Empty in constructor.
         bool stopping_decay;  //!< Let particle decay if elow is reached but no
                               //!< decay was sampled
 
@@ -82,6 +104,12 @@ class Sector {
         bool do_continuous_energy_loss_output;
         bool do_exact_time_calculation;
         bool only_loss_inside_detector;
+        bool do_range_propagation;  //!< Sample the energy after a distance
+                                    //!< from a SurvivalTable built with
+                                    //!< full propagation, without sampling
+                                    //!< single losses. Meant for sectors in
+                                    //!< front of the detector. Set to false
+                                    //!< in constructor.
 
         ScatteringFactory::Enum scattering_model;
 
@@ -101,6 +129,11 @@ class Sector {
     Sector(Particle&, const Definition&);
     Sector(Particle&, const Definition&, const InterpolationDef&);
     Sector(Particle&, const Sector&);
+
+    // Sector with its own definition and geometry, which shares the utility,
+    // the calculators, the continuous randomizer and the scattering with the
+    // given sector. The sector definitions must have the same physics.
+    Sector(Particle&, const Definition&, const Sector& physics);
     // Sector(Particle&, const Geometry&, const Utility&, const Scattering&,
     // bool do_interpolation, const Definition& def = Definition());
     Sector(const Sector&);
@@ -130,6 +163,17 @@ class Sector {
 
     double Propagate(double distance);
 
+    /**
+     * Like Propagate, but every secondary is passed to the sink
+     * as soon as it is produced instead of being stored in the Output.
+     *
+     *  \param  distance   maximum track length
+     *  \param  sink   receiver of the secondaries
+     *  \return energy at distance OR -(track length)
+     */
+
+    double Propagate(double distance, SecondarySink& sink);
+
     /**
      * Calculates the contiuous loss till the first stochastic loss happend
      * and subtract it from initial energy
@@ -176,17 +220,63 @@ class Sector {
 
     ParticleLocation::Enum GetLocation() const { return sector_def_.location; }
 
-    Scattering* GetScattering() const { return scattering_; }
+    Scattering* GetScattering() const { return scattering_.get(); }
     Particle& GetParticle() const { return particle_; }
     Geometry* GetGeometry() const { return geometry_; }
-    const Utility& GetUtility() const { return utility_; }
-    const Medium* GetMedium() const { return &utility_.GetMedium(); }
+    const Utility& GetUtility() const { return *utility_; }
+    const Medium* GetMedium() const { return medium_.get(); }
+
+    // True, if both sectors use the same physics objects
+    bool SharesPhysics(const Sector& sector) const { return utility_ == sector.utility_; }
     const Definition& GetSectorDef() const { return sector_def_; }
     Definition& GetSectorDef() { return sector_def_; }
 
    protected:
     Sector& operator=(const Sector&);  // Undefined & not allowed
 
+    // --------------------------------------------------------------------- //
+    // Steps of the propagation
+    // --------------------------------------------------------------------- //
+
+    // CalculateEnergyTillStochastic with given (already logarithmic) random
+    // numbers for the decay and the interaction at the given position
+    std::pair<double, double> CalculateEnergyTillStochastic(
+        double initial_energy, double rndd, double rndi, const Vector3D& position);
+
+    // Decides between interaction and decay. Returns the final energy of the
+    // step.
+    double ChooseFinalEnergy(const std::pair<double, double>& energy_till_stochastic,
+                             bool& particle_interaction);
+
+    // Displacement of a step from the initial to the final energy, at most
+    // max_distance. If the step is limited, the final energy is lowered to
+    // the energy after the continuous losses till max_distance.
+    double CalculateDisplacement(double initial_energy,
+                                 double& final_energy,
+                                 double max_distance,
+                                 const Vector3D& position,
+                                 const Vector3D& direction);
+
+    // Advances particle_ by the displacement, randomizes the continuous loss
+    // and makes the stochastic loss or the decay at the end of the step.
+    // Returns false, if the propagation of the particle ends with this step.
+    bool MakeStep(double initial_energy,
+                  double& final_energy,
+                  double displacement,
+                  double distance,
+                  double& propagated_distance,
+                  bool particle_interaction,
+                  bool& is_decayed);
+
+    // Range propagation: the energy after the distance is sampled from the
+    // survival tables, in steps with at most half of the energy lost on
+    // average. A particle, which does not survive, stops where its survival
+    // probability falls below the random number. Returns the final energy.
+    double PropagateRange(double distance, double& propagated_distance);
+
+    // Forced decay of a stopped particle, see stopping_decay
+    void MakeStoppingDecay();
+
     // --------------------------------------------------------------------- //
     // Protected members
     // --------------------------------------------------------------------- //
@@ -196,13 +286,21 @@ class Sector {
     Particle& particle_;
     Geometry* geometry_;
 
-    Utility utility_;
-    UtilityDecorator* displacement_calculator_;
-    UtilityDecorator* interaction_calculator_;
-    UtilityDecorator* decay_calculator_;
-    UtilityDecorator* exact_time_calculator_;
+    // Medium of the sector. Its density distribution scales the grammage of
+    // the physics, which is the same for all densities.
+    std::shared_ptr<const Medium> medium_;
+
+    // The physics of a sector might be shared with other sectors
+    std::shared_ptr<Utility> utility_;
+    std::shared_ptr<UtilityDecorator> displacement_calculator_;
+    std::shared_ptr<UtilityDecorator> interaction_calculator_;
+    std::shared_ptr<UtilityDecorator> decay_calculator_;
+    std::shared_ptr<UtilityDecorator> exact_time_calculator_;
+
+    std::shared_ptr<ContinuousRandomizer> cont_rand_;
+    std::shared_ptr<Scattering> scattering_;
 
-    ContinuousRandomizer* cont_rand_;
-    Scattering* scattering_;
+    // Only used in range propagation
+    std::shared_ptr<SurvivalTable> survival_table_;
 };
 }  // namespace PROPOSAL
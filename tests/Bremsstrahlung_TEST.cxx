@@ -5,6 +5,8 @@
 #include "gtest/gtest.h"
 
 #include <fstream>
+#include <memory>
+#include <thread>
 #include "PROPOSAL/Constants.h"
 #include "PROPOSAL/crossection/BremsIntegral.h"
 #include "PROPOSAL/crossection/BremsInterpolant.h"
@@ -594,6 +596,228 @@ TEST(Bremsstrahlung, Test_of_e_Interpolant)
     }
 }
 
+TEST(Bremsstrahlung, Test_of_dNdx_CutIndependent_Interpolant)
+{
+    ParticleDef particle_def = MuMinusDef::Get();
+    Water medium;
+    double multiplier = 1.;
+    bool lpm          = false;
+
+    InterpolationDef InterpolDef;
+    InterpolationDef InterpolDef_cut_independent;
+    InterpolDef_cut_independent.do_cut_independent_dndx = true;
+
+    std::vector<EnergyCutSettings> cuts;
+    cuts.push_back(EnergyCutSettings(500, 0.05));
+    cuts.push_back(EnergyCutSettings(-1, 0.05));
+    cuts.push_back(EnergyCutSettings(10, -1));
+
+    // Keeps the shared tables alive during the loop
+    BremsKelnerKokoulinPetrukhin param_reference(particle_def, medium, EnergyCutSettings(), multiplier, lpm);
+    BremsInterpolant brems_reference(param_reference, InterpolDef_cut_independent);
+
+    ASSERT_FALSE(brems_reference.GetCutIndependentDNdxInterpolants().empty());
+
+    for (auto ecuts: cuts)
+    {
+        BremsKelnerKokoulinPetrukhin param(particle_def, medium, ecuts, multiplier, lpm);
+
+        BremsInterpolant brems(param, InterpolDef);
+        BremsInterpolant brems_cut_independent(param, InterpolDef_cut_independent);
+
+        EXPECT_TRUE(brems.GetCutIndependentDNdxInterpolants().empty());
+        EXPECT_EQ(brems_cut_independent.GetCutIndependentDNdxInterpolants(),
+                  brems_reference.GetCutIndependentDNdxInterpolants());
+
+        for (double energy = 1e3; energy < 1e12; energy *= 10)
+        {
+            double dNdx = brems.CalculatedNdx(energy);
+            EXPECT_NEAR(brems_cut_independent.CalculatedNdx(energy), dNdx, 1e-3 * dNdx);
+
+            double vUp = ecuts.GetCut(energy);
+
+            for (double rnd = 0.05; rnd < 1; rnd += 0.1)
+            {
+                double loss = brems.CalculateStochasticLoss(energy, rnd, rnd);
+                double loss_cut_independent = brems_cut_independent.CalculateStochasticLoss(energy, rnd, rnd);
+
+                EXPECT_GE(loss_cut_independent, energy * vUp);
+                EXPECT_LE(loss_cut_independent, energy);
+                EXPECT_NEAR(loss_cut_independent, loss, 1e-2 * loss);
+            }
+        }
+    }
+
+    // Without a finite cut the tables would be truncated at the minimal energy loss
+    BremsKelnerKokoulinPetrukhin param_no_cut(particle_def, medium, EnergyCutSettings(-1, -1), multiplier, lpm);
+    BremsInterpolant brems_no_cut(param_no_cut, InterpolDef_cut_independent);
+
+    EXPECT_TRUE(brems_no_cut.GetCutIndependentDNdxInterpolants().empty());
+}
+
+TEST(Bremsstrahlung, Test_of_dNdx_CutIndependent_Threads)
+{
+    ParticleDef particle_def = MuMinusDef::Get();
+    Ice medium;
+    double multiplier = 1.;
+
+    InterpolationDef InterpolDef_cut_independent;
+    InterpolDef_cut_independent.do_cut_independent_dndx = true;
+
+    std::vector<std::unique_ptr<BremsKelnerKokoulinPetrukhin> > params(4);
+    std::vector<std::unique_ptr<BremsInterpolant> > brems(params.size());
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < brems.size(); ++i)
+    {
+        threads.emplace_back([&, i]() {
+            params[i].reset(new BremsKelnerKokoulinPetrukhin(
+                particle_def, medium, EnergyCutSettings(500, 0.01 * (i + 1)), multiplier, false));
+            brems[i].reset(new BremsInterpolant(*params[i], InterpolDef_cut_independent));
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // All cross sections alive share the same tables
+    ASSERT_FALSE(brems[0]->GetCutIndependentDNdxInterpolants().empty());
+
+    for (size_t i = 1; i < brems.size(); ++i)
+    {
+        EXPECT_EQ(brems[i]->GetCutIndependentDNdxInterpolants(), brems[0]->GetCutIndependentDNdxInterpolants());
+    }
+}
+
+TEST(Bremsstrahlung, Test_of_DifferentialCrossSectionBatch)
+{
+    ParticleDef particle_def = MuMinusDef::Get();
+    EnergyCutSettings ecuts(500, 0.05);
+    double multiplier = 1.;
+
+    std::vector<Medium*> media;
+    media.push_back(new Water());
+    media.push_back(new StandardRock());
+    media.push_back(new Hydrogen());
+    media.push_back(new Uranium());
+
+    std::vector<double> v;
+    for (double x = 1e-6; x < 1; x *= 1.5)
+    {
+        v.push_back(x);
+    }
+
+    for (auto medium: media)
+    {
+        for (int lpm = 0; lpm < 2; ++lpm)
+        {
+            std::vector<Bremsstrahlung*> params;
+            params.push_back(new BremsPetrukhinShestakov(particle_def, *medium, ecuts, multiplier, lpm));
+            params.push_back(new BremsKelnerKokoulinPetrukhin(particle_def, *medium, ecuts, multiplier, lpm));
+            params.push_back(new BremsCompleteScreening(particle_def, *medium, ecuts, multiplier, lpm));
+            params.push_back(new BremsAndreevBezrukovBugaev(particle_def, *medium, ecuts, multiplier, lpm));
+            params.push_back(new BremsSandrockSoedingreksoRhode(particle_def, *medium, ecuts, multiplier, lpm));
+            params.push_back(new BremsElectronScreening(EMinusDef::Get(), *medium, ecuts, multiplier, lpm));
+
+            for (auto param: params)
+            {
+                for (size_t component = 0; component < medium->GetNumComponents(); ++component)
+                {
+                    param->SetCurrentComponent(component);
+
+                    for (double energy = 1e3; energy < 1e12; energy *= 100)
+                    {
+                        std::vector<double> result;
+                        param->DifferentialCrossSectionBatch(energy, v, result);
+
+                        ASSERT_EQ(result.size(), v.size());
+
+                        for (size_t i = 0; i < v.size(); ++i)
+                        {
+                            double expected = param->DifferentialCrossSection(energy, v[i]);
+                            if (std::isnan(expected))
+                            {
+                                EXPECT_TRUE(std::isnan(result[i]));
+                            } else
+                            {
+                                EXPECT_DOUBLE_EQ(result[i], expected);
+                            }
+                        }
+                    }
+                }
+                delete param;
+            }
+        }
+        delete medium;
+    }
+}
+
+TEST(Bremsstrahlung, Test_of_shared_LPM)
+{
+    ParticleDef particle_def = MuMinusDef::Get();
+    StandardRock medium;
+    double multiplier = 1.;
+
+    BremsKelnerKokoulinPetrukhin param(particle_def, medium, EnergyCutSettings(500, 0.05), multiplier, true);
+
+    // different cuts, the lpm constants are taken from the first one
+    BremsKelnerKokoulinPetrukhin param_shared(particle_def, medium, EnergyCutSettings(-1, 0.01), multiplier, true);
+
+    for (double energy = 1e4; energy < 1e14; energy *= 10)
+    {
+        for (double v = 1e-5; v < 1; v *= 3)
+        {
+            double dNdx = param.DifferentialCrossSection(energy, v);
+
+            EXPECT_GT(dNdx, 0);
+            EXPECT_DOUBLE_EQ(param_shared.DifferentialCrossSection(energy, v), dNdx);
+        }
+    }
+
+    // strong suppression at high energies and small v
+    BremsKelnerKokoulinPetrukhin param_no_lpm(particle_def, medium, EnergyCutSettings(500, 0.05), multiplier, false);
+
+    EXPECT_LT(param.DifferentialCrossSection(1e14, 1e-5), 0.5 * param_no_lpm.DifferentialCrossSection(1e14, 1e-5));
+    EXPECT_NEAR(param.DifferentialCrossSection(1e4, 0.1), param_no_lpm.DifferentialCrossSection(1e4, 0.1),
+                1e-3 * param_no_lpm.DifferentialCrossSection(1e4, 0.1));
+}
+
+TEST(Bremsstrahlung, Test_of_shared_LPM_Threads)
+{
+    ParticleDef particle_def = MuMinusDef::Get();
+    Ice medium;
+    double multiplier = 1.;
+
+    std::vector<double> dNdx(8, 0);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < dNdx.size(); ++i)
+    {
+        threads.emplace_back([&, i]() {
+            for (int j = 0; j < 10; ++j)
+            {
+                BremsKelnerKokoulinPetrukhin param(
+                    particle_def, medium, EnergyCutSettings(500, 0.01 * (j + 1)), multiplier, true);
+                dNdx[i] = param.DifferentialCrossSection(1e12, 1e-4);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    BremsKelnerKokoulinPetrukhin param(particle_def, medium, EnergyCutSettings(500, 0.05), multiplier, true);
+
+    for (double value : dNdx)
+    {
+        EXPECT_DOUBLE_EQ(value, param.DifferentialCrossSection(1e12, 1e-4));
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
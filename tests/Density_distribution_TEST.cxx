@@ -1,11 +1,19 @@
 
+#include <cmath>
+
 #include "gtest/gtest.h"
 
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/geometry/Box.h"
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
+#include "PROPOSAL/geometry/Sphere.h"
+#include "PROPOSAL/math/RandomGenerator.h"
 #include "PROPOSAL/medium/Components.h"
 #include "PROPOSAL/medium/Medium.h"
 #include "PROPOSAL/medium/MediumFactory.h"
 #include "PROPOSAL/medium/density_distr/density_exponential.h"
 #include "PROPOSAL/medium/density_distr/density_homogeneous.h"
+#include "PROPOSAL/medium/density_distr/density_layered.h"
 #include "PROPOSAL/medium/density_distr/density_polynomial.h"
 #include "PROPOSAL/medium/density_distr/density_splines.h"
 
@@ -109,6 +117,306 @@ TEST(Assignment, Copyconstructor)
     EXPECT_TRUE(A == C);
 }
 
+TEST(GrammageTable, DepthRange)
+{
+    BoundingBox box(Vector3D(-100, -200, -300), Vector3D(100, 200, 300));
+
+    CartesianAxis cartesian(Vector3D(0, 0, -1), Vector3D(0, 0, 100));
+    std::pair<double, double> range = cartesian.GetDepthRange(box);
+    EXPECT_DOUBLE_EQ(range.first, -200);
+    EXPECT_DOUBLE_EQ(range.second, 400);
+
+    RadialAxis radial(Vector3D(0, 0, 1), Vector3D(0, 0, 400));
+    range = radial.GetDepthRange(box);
+    EXPECT_DOUBLE_EQ(range.first, 100);
+    EXPECT_DOUBLE_EQ(range.second, std::sqrt(100. * 100 + 200. * 200 + 700. * 700));
+
+    // The origin of the radial axis inside the box
+    radial = RadialAxis(Vector3D(0, 0, 1), Vector3D(0, 0, 0));
+    EXPECT_DOUBLE_EQ(radial.GetDepthRange(box).first, 0);
+}
+
+TEST(GrammageTable, Inverse)
+{
+    // density 1 + 0.01 * depth
+    std::vector<double> coefficients = {1, 0.01};
+    Polynom polynom(coefficients);
+    Polynom antiderivative = polynom.GetAntiderivative(0);
+
+    GrammageTable table(polynom.GetFunction(), antiderivative.GetFunction(), -50, 1000);
+    ASSERT_TRUE(table.IsTabulated());
+
+    std::function<double(double)> grammage = antiderivative.GetFunction();
+
+    for (int i = 0; i < 1000; ++i) {
+        double depth = -50 + 1050 * RandomGenerator::Get().RandomDouble();
+        EXPECT_NEAR(table.GetDepth(grammage(depth)), depth, 1e-4);
+    }
+
+    EXPECT_TRUE(std::isnan(table.GetDepth(grammage(-51))));
+    EXPECT_TRUE(std::isnan(table.GetDepth(grammage(1001))));
+
+    // The inverse needs a positive density
+    GrammageTable negative(polynom.GetFunction(), antiderivative.GetFunction(), -200, 1000);
+    EXPECT_FALSE(negative.IsTabulated());
+}
+
+TEST(GrammageTable, Precision)
+{
+    // density 1 + 0.01 * depth
+    std::vector<double> coefficients = {1, 0.01};
+    Polynom polynom(coefficients);
+    Polynom antiderivative = polynom.GetAntiderivative(0);
+    std::function<double(double)> grammage = antiderivative.GetFunction();
+
+    GrammageTable table(polynom.GetFunction(), grammage, 0, 1e5);
+    GrammageTable precise(polynom.GetFunction(), grammage, 0, 1e5, 1e-10);
+    ASSERT_TRUE(table.IsTabulated());
+    ASSERT_TRUE(precise.IsTabulated());
+    EXPECT_GT(precise.GetNumberOfNodes(), table.GetNumberOfNodes());
+
+    for (int i = 0; i < 1000; ++i) {
+        double depth = 1e5 * RandomGenerator::Get().RandomDouble();
+        EXPECT_NEAR(table.GetDepth(grammage(depth)), depth, 1e-8 * 1e5);
+        EXPECT_NEAR(precise.GetDepth(grammage(depth)), depth, 1e-10 * 1e5);
+    }
+
+    // The depths of a world geometry can not be tabulated precisely, the
+    // distance is searched iteratively then
+    CartesianAxis axis(Vector3D(0, 0, 1), Vector3D(0, 0, 0));
+    Density_polynomial world(axis, polynom);
+    world.BuildGrammageTable(Sphere(Vector3D(0, 0, 0), 1e20, 0));
+    EXPECT_FALSE(world.GetGrammageTable().IsTabulated());
+
+    Density_polynomial iterative(axis, polynom);
+    Vector3D position(0, 0, 100);
+    Vector3D direction(0, 0, 1);
+    EXPECT_DOUBLE_EQ(world.Correct(position, direction, 1e3, 1e4), iterative.Correct(position, direction, 1e3, 1e4));
+}
+
+TEST(GrammageTable, Correct)
+{
+    std::vector<double> coefficients = {1, 0.001, 1e-6};
+    Polynom polynom(coefficients);
+    CartesianAxis axis(Vector3D(0, 0, 1), Vector3D(0, 0, 0));
+    Box box(Vector3D(0, 0, 0), 20, 20, 20);
+
+    Density_polynomial iterative(axis, polynom);
+    Density_polynomial tabulated(axis, polynom);
+    tabulated.BuildGrammageTable(box);
+
+    EXPECT_FALSE(iterative.GetGrammageTable().IsTabulated());
+    EXPECT_TRUE(tabulated.GetGrammageTable().IsTabulated());
+
+    // The tables do not change the distribution
+    EXPECT_TRUE(iterative == tabulated);
+
+    Vector3D direction;
+    Vector3D position;
+
+    for (int i = 0; i < 1000; ++i) {
+        position.SetCartesianCoordinates(0, 0, -900 + 1800 * RandomGenerator::Get().RandomDouble());
+        direction.SetSphericalCoordinates(1, 0, 0.5 * RandomGenerator::Get().RandomDouble());
+
+        double distance_to_border = box.DistanceToBorder(position, direction).first;
+        double grammage_to_border = tabulated.Calculate(position, direction, distance_to_border);
+        double res = grammage_to_border * RandomGenerator::Get().RandomDouble();
+
+        double distance = tabulated.Correct(position, direction, res, distance_to_border);
+        EXPECT_NEAR(distance, iterative.Correct(position, direction, res, distance_to_border),
+                    1e-6 * distance_to_border);
+        EXPECT_NEAR(tabulated.Calculate(position, direction, distance), res, 1e-6 * res);
+
+        // Grammage behind the border
+        EXPECT_GT(tabulated.Correct(position, direction, 2 * grammage_to_border, distance_to_border),
+                  distance_to_border);
+    }
+}
+
+TEST(Density_splines, Correct)
+{
+    std::vector<double> x = {-1500, -600, -200, 100, 500, 1500};
+    std::vector<double> y = {0.8, 1.2, 1.0, 1.5, 1.3, 0.9};
+
+    CartesianAxis axis(Vector3D(0, 0, 1), Vector3D(0, 0, 0));
+    Box box(Vector3D(0, 0, 0), 20, 20, 20);
+
+    Linear_Spline linear(x, y);
+    Cubic_Spline cubic(x, y);
+
+    std::vector<Spline*> splines = {&linear, &cubic};
+
+    Vector3D direction;
+    Vector3D position;
+
+    for (Spline* spline : splines) {
+        Density_splines density(axis, *spline);
+
+        for (double depth : {-1500., -700., -200., 0., 333., 1500.})
+            EXPECT_NEAR(density.Evaluate(Vector3D(0, 0, depth)), spline->evaluate(depth), 1e-12);
+
+        for (int i = 0; i < 1000; ++i) {
+            position.SetCartesianCoordinates(0, 0, -900 + 1800 * RandomGenerator::Get().RandomDouble());
+            direction.SetSphericalCoordinates(1, 0, 0.5 * RandomGenerator::Get().RandomDouble());
+
+            double distance_to_border = box.DistanceToBorder(position, direction).first;
+            double grammage_to_border = density.Calculate(position, direction, distance_to_border);
+            double res = grammage_to_border * RandomGenerator::Get().RandomDouble();
+
+            double distance = density.Correct(position, direction, res, distance_to_border);
+            EXPECT_GE(distance, 0);
+            EXPECT_LE(distance, distance_to_border * (1 + 1e-9));
+            EXPECT_NEAR(density.Calculate(position, direction, distance), res, 1e-6 * res);
+
+            // Grammage behind the border
+            EXPECT_GT(density.Correct(position, direction, 2 * grammage_to_border + 1, distance_to_border),
+                      distance_to_border);
+        }
+
+        // Against the axis the depth decreases, Calculate gets negative
+        for (int i = 0; i < 1000; ++i) {
+            position.SetCartesianCoordinates(0, 0, -900 + 1800 * RandomGenerator::Get().RandomDouble());
+            direction.SetSphericalCoordinates(1, 0, PI - 0.5 * RandomGenerator::Get().RandomDouble());
+
+            double distance_to_border = box.DistanceToBorder(position, direction).first;
+            double grammage_to_border = density.Calculate(position, direction, distance_to_border);
+            ASSERT_LT(grammage_to_border, 0);
+
+            double res = grammage_to_border * RandomGenerator::Get().RandomDouble();
+
+            double distance = density.Correct(position, direction, res, distance_to_border);
+            EXPECT_GE(distance, 0);
+            EXPECT_LE(distance, distance_to_border * (1 + 1e-9));
+            EXPECT_NEAR(density.Calculate(position, direction, distance), res, -1e-6 * res);
+
+            // Grammage behind the border or behind the position
+            EXPECT_GT(density.Correct(position, direction, 2 * grammage_to_border - 1, distance_to_border),
+                      distance_to_border);
+            EXPECT_GT(density.Correct(position, direction, -res, distance_to_border), distance_to_border);
+        }
+    }
+}
+
+TEST(Density_layered, Evaluate)
+{
+    Density_layered layered;
+    layered.AddLayer(100, Density_homogeneous(3));
+    layered.AddLayer(200, Density_homogeneous(2));
+    layered.AddLayer(300, Density_homogeneous(1));
+
+    EXPECT_EQ(layered.GetNumberOfLayers(), 3u);
+    EXPECT_EQ(layered.Evaluate(Vector3D(0, 0, 0)), 3);
+    EXPECT_EQ(layered.Evaluate(Vector3D(0, 150, 0)), 2);
+    EXPECT_EQ(layered.Evaluate(Vector3D(0, 0, -250)), 1);
+
+    // The outermost layer continues
+    EXPECT_EQ(layered.Evaluate(Vector3D(1000, 0, 0)), 1);
+
+    Density_layered copy(layered);
+    EXPECT_TRUE(copy == layered);
+
+    copy.AddLayer(400, Density_homogeneous(0.5));
+    EXPECT_TRUE(copy != layered);
+}
+
+TEST(Density_layered, Grammage)
+{
+    Density_layered layered;
+    layered.AddLayer(100, Density_homogeneous(3));
+    layered.AddLayer(200, Density_homogeneous(2));
+    layered.AddLayer(300, Density_homogeneous(1));
+
+    // Straight through the center, starting on the outermost border
+    Vector3D position(-300, 0, 0);
+    Vector3D direction(1, 0, 0);
+
+    double grammage = 2 * (100 * 1 + 100 * 2) + 200 * 3;
+    EXPECT_NEAR(layered.Calculate(position, direction, 600), grammage, 1e-9 * grammage);
+
+    // The outermost layer continues
+    EXPECT_NEAR(layered.Calculate(position, direction, 700), grammage + 100, 1e-9 * grammage);
+
+    // Ending in the core
+    EXPECT_NEAR(layered.Calculate(position, direction, 250), 100 + 200 + 50 * 3, 1e-9 * grammage);
+    EXPECT_NEAR(layered.Correct(position, direction, 100 + 200 + 50 * 3, 600), 250, 1e-9 * 250);
+
+    // Not reached in front of the border
+    EXPECT_GT(layered.Correct(position, direction, grammage + 1, 600), 600);
+
+    // Correct inverts Calculate along random chords
+    Sphere sphere(Vector3D(0, 0, 0), 3, 0);
+
+    for (int i = 0; i < 1000; ++i) {
+        position.SetSphericalCoordinates(300 * RandomGenerator::Get().RandomDouble(),
+                                         2 * PI * RandomGenerator::Get().RandomDouble(),
+                                         PI * RandomGenerator::Get().RandomDouble());
+        direction.SetSphericalCoordinates(1,
+                                          2 * PI * RandomGenerator::Get().RandomDouble(),
+                                          PI * RandomGenerator::Get().RandomDouble());
+
+        double distance_to_border = sphere.DistanceToBorder(position, direction).first;
+        double distance = distance_to_border * RandomGenerator::Get().RandomDouble();
+        double res = layered.Calculate(position, direction, distance);
+
+        EXPECT_NEAR(layered.Correct(position, direction, res, distance_to_border), distance,
+                    1e-9 * distance_to_border);
+    }
+}
+
+TEST(Density_layered, ManyLayers)
+{
+    // Shells of 1 cm with alternating densities
+    Density_layered layered;
+    std::vector<double> densities;
+
+    for (int i = 1; i <= 200; ++i) {
+        densities.push_back(1 + (i % 7));
+        layered.AddLayer(i, Density_homogeneous(densities.back()));
+    }
+
+    Vector3D position;
+    Vector3D direction;
+
+    for (int i = 0; i < 1000; ++i) {
+        position.SetSphericalCoordinates(250 * RandomGenerator::Get().RandomDouble(),
+                                         2 * PI * RandomGenerator::Get().RandomDouble(),
+                                         PI * RandomGenerator::Get().RandomDouble());
+        direction.SetSphericalCoordinates(1,
+                                          2 * PI * RandomGenerator::Get().RandomDouble(),
+                                          PI * RandomGenerator::Get().RandomDouble());
+
+        double distance = 500 * RandomGenerator::Get().RandomDouble();
+
+        // Crossings with all borders
+        double projection = position * direction;
+        double closest = position * position - projection * projection;
+        std::vector<double> crossings(1, 0);
+
+        for (int k = 0; k + 1 < 200; ++k) {
+            double radius = k + 1;
+            if (radius * radius <= closest)
+                continue;
+
+            double root = std::sqrt(radius * radius - closest);
+            for (double crossing : {-projection - root, -projection + root}) {
+                if (crossing > 0 && crossing < distance)
+                    crossings.push_back(crossing);
+            }
+        }
+        std::sort(crossings.begin(), crossings.end());
+        crossings.push_back(distance);
+
+        double grammage = 0;
+        for (unsigned int k = 0; k + 1 < crossings.size(); ++k) {
+            Vector3D center = position + 0.5 * (crossings[k] + crossings[k + 1]) * direction;
+            unsigned int layer = std::min(static_cast<unsigned int>(center.magnitude()), 199u);
+            grammage += densities[layer] * (crossings[k + 1] - crossings[k]);
+        }
+
+        EXPECT_NEAR(layered.Calculate(position, direction, distance), grammage, 1e-9 * grammage);
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -589,6 +589,63 @@ TEST(Epairproduction, Test_of_e_interpol)
     }
 }
 
+TEST(Epairproduction, Test_of_FunctionToIntegralBatch)
+{
+    ParticleDef particle_def = MuMinusDef::Get();
+    EnergyCutSettings ecuts(500, 0.05);
+    double multiplier = 1.;
+
+    std::vector<Medium*> media;
+    media.push_back(new Water());
+    media.push_back(new Hydrogen());
+    media.push_back(new Uranium());
+
+    std::vector<double> rho;
+    for (double r = 1e-6; r < 1; r *= 1.5)
+    {
+        rho.push_back(r);
+    }
+
+    for (auto medium: media)
+    {
+        for (int lpm = 0; lpm < 2; ++lpm)
+        {
+            std::vector<EpairProductionRhoIntegral*> params;
+            params.push_back(new EpairKelnerKokoulinPetrukhin(particle_def, *medium, ecuts, multiplier, lpm));
+            params.push_back(new EpairSandrockSoedingreksoRhode(particle_def, *medium, ecuts, multiplier, lpm));
+
+            for (auto param: params)
+            {
+                for (size_t component = 0; component < medium->GetNumComponents(); ++component)
+                {
+                    param->SetCurrentComponent(component);
+
+                    for (double energy = 1e3; energy < 1e12; energy *= 100)
+                    {
+                        Parametrization::IntegralLimits limits = param->GetIntegralLimits(energy);
+
+                        for (double v = limits.vMin * 1.1; v < limits.vMax; v *= 3)
+                        {
+                            std::vector<double> result;
+                            param->FunctionToIntegralBatch(energy, v, rho, result);
+
+                            ASSERT_EQ(result.size(), rho.size());
+
+                            for (size_t i = 0; i < rho.size(); ++i)
+                            {
+                                double expected = param->FunctionToIntegral(energy, v, rho[i]);
+                                EXPECT_NEAR(result[i], expected, 1e-10 * std::abs(expected));
+                            }
+                        }
+                    }
+                }
+                delete param;
+            }
+        }
+        delete medium;
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
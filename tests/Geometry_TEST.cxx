@@ -6,10 +6,15 @@
 #include "gtest/gtest.h"
 
 #include "PROPOSAL/Constants.h"
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
 #include "PROPOSAL/geometry/Box.h"
 #include "PROPOSAL/geometry/Cylinder.h"
+#include "PROPOSAL/geometry/ExtrudedPolygon.h"
 #include "PROPOSAL/geometry/Geometry.h"
+#include "PROPOSAL/geometry/GeometryFactory.h"
+#include "PROPOSAL/geometry/GeometryKernels.h"
 #include "PROPOSAL/geometry/Sphere.h"
+#include "PROPOSAL/geometry/TriangleMesh.h"
 #include "PROPOSAL/math/RandomGenerator.h"
 
 using namespace PROPOSAL;
@@ -270,7 +275,7 @@ TEST(IsInside, Box)
         particle_direction.CalculateCartesianFromSpherical();
 
         // phi = 0 is in positive x direction
-        if (particle_direction.GetPhi() < 0.5 * PI || particle_direction.GetPhi() > 1.5 * PI)
+        if (rnd_phi * 2 * PI < 0.5 * PI || rnd_phi * 2 * PI > 1.5 * PI)
             EXPECT_FALSE(A.IsInside(particle_position, particle_direction));
         else
             EXPECT_TRUE(A.IsInside(particle_position, particle_direction));
@@ -286,7 +291,7 @@ TEST(IsInside, Box)
         particle_direction.CalculateCartesianFromSpherical();
 
         // phi = 0 is in positive x direction
-        if (particle_direction.GetPhi() < 0.5 * PI || particle_direction.GetPhi() > 1.5 * PI)
+        if (rnd_phi * 2 * PI < 0.5 * PI || rnd_phi * 2 * PI > 1.5 * PI)
             EXPECT_TRUE(A.IsInside(particle_position, particle_direction));
         else
             EXPECT_FALSE(A.IsInside(particle_position, particle_direction));
@@ -302,7 +307,7 @@ TEST(IsInside, Box)
         particle_direction.CalculateCartesianFromSpherical();
 
         // phi = 0 is in positive x direction
-        if (particle_direction.GetPhi() < PI)
+        if (rnd_phi * 2 * PI < PI)
             EXPECT_FALSE(A.IsInside(particle_position, particle_direction));
         else
             EXPECT_TRUE(A.IsInside(particle_position, particle_direction));
@@ -318,7 +323,7 @@ TEST(IsInside, Box)
         particle_direction.CalculateCartesianFromSpherical();
 
         // phi = 0 is in positive x direction
-        if (particle_direction.GetPhi() < PI)
+        if (rnd_phi * 2 * PI < PI)
             EXPECT_TRUE(A.IsInside(particle_position, particle_direction));
         else
             EXPECT_FALSE(A.IsInside(particle_position, particle_direction));
@@ -334,8 +339,8 @@ TEST(IsInside, Box)
         particle_direction.SetSphericalCoordinates(1, rnd_phi * 2 * PI, rnd_theta * PI);
         particle_direction.CalculateCartesianFromSpherical();
 
-        if (particle_direction.GetTheta() < 0.5 * PI || particle_direction.GetPhi() < PI ||
-            particle_direction.GetPhi() > 1.5 * PI)
+        if (particle_direction.GetTheta() < 0.5 * PI || rnd_phi * 2 * PI < PI ||
+            rnd_phi * 2 * PI > 1.5 * PI)
             EXPECT_FALSE(A.IsInside(particle_position, particle_direction));
         else
             EXPECT_TRUE(A.IsInside(particle_position, particle_direction));
@@ -1072,7 +1077,7 @@ TEST(DistanceTo, Box)
 
         distance = A.DistanceToBorder(particle_position, particle_direction);
 
-        phi = particle_direction.GetPhi() * 180. / PI;
+        phi = rnd_phi * 360.;
         if (phi < 45)
         {
             dist = 0.5 * width / std::cos(phi / 180 * PI);
@@ -1265,6 +1270,427 @@ TEST(DistanceTo, Box)
     }
 }
 
+TEST(Intersect, Geometries)
+{
+    Sphere sphere(Vector3D(1, 2, 3), 4, 2);
+    Box box(Vector3D(-1, 0, 1), 2, 4, 6);
+    Cylinder cylinder(Vector3D(0, 0, -5), 3, 1, 8);
+
+    Geometry* geometries[3] = { &sphere, &box, &cylinder };
+
+    RandomGenerator::Get().SetSeed(1234);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        Vector3D position(2000 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                          2000 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                          2000 * (RandomGenerator::Get().RandomDouble() - 0.5));
+        Vector3D direction(RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5);
+        direction.normalise();
+
+        for (auto geometry : geometries)
+        {
+            Geometry::Intersection intersection = geometry->Intersect(position, direction);
+
+            EXPECT_EQ(intersection.distance, geometry->DistanceToBorder(position, direction));
+            EXPECT_EQ(intersection.location, geometry->GetLocation(position, direction));
+            EXPECT_EQ(intersection.closest_approach, geometry->DistanceToClosestApproach(position, direction));
+            EXPECT_EQ(intersection.location == Geometry::ParticleLocation::InsideGeometry,
+                      geometry->IsInside(position, direction));
+            EXPECT_EQ(intersection.location == Geometry::ParticleLocation::InfrontGeometry,
+                      geometry->IsInfront(position, direction));
+        }
+    }
+}
+
+TEST(GeometryKernels, Batched)
+{
+    RandomGenerator::Get().SetSeed(1234);
+
+    std::vector<Sphere> spheres;
+    std::vector<Box> boxes;
+    std::vector<Cylinder> cylinders;
+
+    GeometryKernels::SphereArray sphere_array;
+    GeometryKernels::BoxArray box_array;
+    GeometryKernels::CylinderArray cylinder_array;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        Vector3D position(RandomGenerator::Get().RandomDouble() - 0.5,
+                          RandomGenerator::Get().RandomDouble() - 0.5,
+                          RandomGenerator::Get().RandomDouble() - 0.5);
+        double radius       = 1 + RandomGenerator::Get().RandomDouble();
+        double inner_radius = (i % 2) * radius * RandomGenerator::Get().RandomDouble();
+        double height       = 1 + RandomGenerator::Get().RandomDouble();
+
+        spheres.push_back(Sphere(position, radius, inner_radius));
+        boxes.push_back(Box(position, radius, inner_radius + 1, height));
+        cylinders.push_back(Cylinder(position, radius, inner_radius, height));
+
+        sphere_array.Add(spheres.back());
+        box_array.Add(boxes.back());
+        cylinder_array.Add(cylinders.back());
+    }
+
+    EXPECT_EQ(sphere_array.GetSize(), spheres.size());
+    EXPECT_EQ(box_array.GetSize(), boxes.size());
+    EXPECT_EQ(cylinder_array.GetSize(), cylinders.size());
+
+    std::vector<double> first(spheres.size());
+    std::vector<double> second(spheres.size());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        Vector3D position(600 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                          600 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                          600 * (RandomGenerator::Get().RandomDouble() - 0.5));
+        Vector3D direction(RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5);
+        direction.normalise();
+
+        GeometryKernels::DistanceToBorder(sphere_array, position, direction, first.data(), second.data());
+        for (size_t k = 0; k < spheres.size(); ++k)
+        {
+            EXPECT_EQ(std::make_pair(first[k], second[k]), spheres[k].DistanceToBorder(position, direction));
+        }
+
+        GeometryKernels::DistanceToBorder(box_array, position, direction, first.data(), second.data());
+        for (size_t k = 0; k < boxes.size(); ++k)
+        {
+            EXPECT_EQ(std::make_pair(first[k], second[k]), boxes[k].DistanceToBorder(position, direction));
+        }
+
+        GeometryKernels::DistanceToBorder(cylinder_array, position, direction, first.data(), second.data());
+        for (size_t k = 0; k < cylinders.size(); ++k)
+        {
+            EXPECT_EQ(std::make_pair(first[k], second[k]), cylinders[k].DistanceToBorder(position, direction));
+
+            // The entry is before the exit, also for hollow cylinders
+            if (second[k] > 0)
+                EXPECT_LT(first[k], second[k]);
+        }
+    }
+}
+
+TEST(BoundingBox, Geometries)
+{
+    Sphere sphere(Vector3D(1, 2, 3), 4, 2);
+    Box box(Vector3D(-1, 0, 1), 2, 4, 6);
+    Cylinder cylinder(Vector3D(0, 0, -5), 3, 0, 8);
+
+    EXPECT_TRUE(sphere.GetBoundingBox() == BoundingBox(Vector3D(-300, -200, -100), Vector3D(500, 600, 700)));
+    EXPECT_TRUE(box.GetBoundingBox() == BoundingBox(Vector3D(-200, -200, -200), Vector3D(0, 200, 400)));
+    EXPECT_TRUE(cylinder.GetBoundingBox() == BoundingBox(Vector3D(-300, -300, -900), Vector3D(300, 300, -100)));
+
+    Geometry* geometries[3] = { &sphere, &box, &cylinder };
+
+    RandomGenerator::Get().SetSeed(1234);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        Vector3D position(2000 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                          2000 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                          2000 * (RandomGenerator::Get().RandomDouble() - 0.5));
+        Vector3D direction(RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5);
+        direction.normalise();
+
+        for (auto geometry : geometries)
+        {
+            BoundingBox bounding_box = geometry->GetBoundingBox();
+            double distance          = geometry->DistanceToBorder(position, direction).first;
+
+            if (geometry->IsInside(position, direction))
+            {
+                EXPECT_TRUE(bounding_box.Contains(position));
+            }
+            if (distance > 0)
+            {
+                // The border is inside the box
+                double entry = bounding_box.DistanceToEntry(position, direction);
+                EXPECT_GE(entry, 0);
+                EXPECT_LE(entry, distance * (1 + 1e-12));
+            }
+        }
+    }
+}
+
+TEST(BoundingVolumeHierarchy, Queries)
+{
+    RandomGenerator::Get().SetSeed(1234);
+
+    // Small spheres in a cube and shells around the center
+    std::vector<Sphere> spheres;
+    for (int i = 0; i < 500; ++i)
+    {
+        spheres.push_back(Sphere(Vector3D(100 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                                          100 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                                          100 * (RandomGenerator::Get().RandomDouble() - 0.5)),
+                                 5 * RandomGenerator::Get().RandomDouble(),
+                                 0));
+    }
+    for (int i = 1; i <= 10; ++i)
+    {
+        spheres.push_back(Sphere(Vector3D(), 10 * i, 10 * (i - 1)));
+    }
+
+    std::vector<BoundingBox> boxes;
+    for (auto& sphere : spheres)
+    {
+        boxes.push_back(sphere.GetBoundingBox());
+    }
+
+    BoundingVolumeHierarchy tree(boxes);
+    EXPECT_EQ(tree.GetSize(), boxes.size());
+
+    std::vector<size_t> found;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        Vector3D position(12000 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                          12000 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                          12000 * (RandomGenerator::Get().RandomDouble() - 0.5));
+        Vector3D direction(RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5);
+        direction.normalise();
+
+        // Same boxes as checking all of them
+        std::vector<size_t> expected;
+        for (size_t k = 0; k < boxes.size(); ++k)
+        {
+            if (boxes[k].Contains(position))
+                expected.push_back(k);
+        }
+
+        tree.FindContaining(position, found);
+        EXPECT_EQ(found, expected);
+
+        // Same closest border as checking all of them
+        double closest_expected = 1e20;
+        for (auto& sphere : spheres)
+        {
+            double distance = sphere.DistanceToBorder(position, direction).first;
+            if (distance > 0)
+                closest_expected = std::min(closest_expected, distance);
+        }
+
+        double closest = 1e20;
+        int visited    = 0;
+        tree.Traverse(position, direction, closest, [&](size_t k) {
+            ++visited;
+            double distance = spheres[k].DistanceToBorder(position, direction).first;
+            if (distance > 0)
+                closest = std::min(closest, distance);
+        });
+
+        EXPECT_EQ(closest, closest_expected);
+        EXPECT_LT(visited, static_cast<int>(spheres.size()));
+    }
+}
+
+// Surface of an axis aligned box of the given size around the center [m]
+void AddCube(const Vector3D& center,
+             double size,
+             std::vector<Vector3D>& vertices,
+             std::vector<TriangleMesh::Triangle>& triangles)
+{
+    unsigned int first = vertices.size();
+
+    for (int i = 0; i < 8; ++i)
+    {
+        vertices.push_back(center + 0.5 * size * Vector3D(i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1));
+    }
+
+    // Two triangles for every face, counterclockwise seen from outside
+    unsigned int faces[6][4] = { { 0, 2, 3, 1 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 },
+                                 { 2, 6, 7, 3 }, { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+
+    for (auto face : faces)
+    {
+        triangles.push_back({ { first + face[0], first + face[1], first + face[2] } });
+        triangles.push_back({ { first + face[0], first + face[2], first + face[3] } });
+    }
+}
+
+TEST(DistanceTo, TriangleMesh)
+{
+    std::vector<Vector3D> vertices;
+    std::vector<TriangleMesh::Triangle> triangles;
+    AddCube(Vector3D(0, 0, 0), 4, vertices, triangles);
+
+    TriangleMesh mesh(Vector3D(1, 2, 3), vertices, triangles);
+    Box box(Vector3D(1, 2, 3), 4, 4, 4);
+
+    // The orientation is corrected
+    std::vector<TriangleMesh::Triangle> flipped = triangles;
+    for (auto& triangle : flipped)
+    {
+        std::swap(triangle[0], triangle[1]);
+    }
+    TriangleMesh mesh_flipped(Vector3D(1, 2, 3), vertices, flipped);
+
+    // Two cubes in one mesh
+    std::vector<Vector3D> vertices_two;
+    std::vector<TriangleMesh::Triangle> triangles_two;
+    AddCube(Vector3D(0, 0, 0), 2, vertices_two, triangles_two);
+    AddCube(Vector3D(0, 0, 5), 2, vertices_two, triangles_two);
+
+    TriangleMesh mesh_two(Vector3D(0, 0, 0), vertices_two, triangles_two);
+    Box box_one(Vector3D(0, 0, 0), 2, 2, 2);
+    Box box_two(Vector3D(0, 0, 5), 2, 2, 2);
+
+    EXPECT_TRUE(mesh.GetBoundingBox() == box.GetBoundingBox());
+
+    RandomGenerator::Get().SetSeed(1234);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        Vector3D position(1000 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                          1000 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                          1000 * (RandomGenerator::Get().RandomDouble() - 0.5));
+        Vector3D direction(RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5);
+        direction.normalise();
+
+        std::pair<double, double> expected = box.DistanceToBorder(position, direction);
+        std::pair<double, double> distance = mesh.DistanceToBorder(position, direction);
+
+        EXPECT_NEAR(distance.first, expected.first, 1e-9);
+        EXPECT_NEAR(distance.second, expected.second, 1e-9);
+        EXPECT_EQ(mesh_flipped.DistanceToBorder(position, direction), distance);
+
+        // The first cube along the trajectory, which is not left behind
+        position = position + Vector3D(0, 0, 250);
+
+        std::pair<double, double> one = box_one.DistanceToBorder(position, direction);
+        std::pair<double, double> two = box_two.DistanceToBorder(position, direction);
+
+        if (one.first < 0 || (two.first > 0 && two.first < one.first))
+            expected = two;
+        else
+            expected = one;
+
+        distance = mesh_two.DistanceToBorder(position, direction);
+
+        EXPECT_NEAR(distance.first, expected.first, 1e-9);
+        EXPECT_NEAR(distance.second, expected.second, 1e-9);
+    }
+
+    // Through an edge and along the axis
+    EXPECT_NEAR(mesh.DistanceToBorder(Vector3D(-200, 0, 300), Vector3D(1, 0, 0)).first, 100, 1e-9);
+    EXPECT_NEAR(mesh.DistanceToBorder(Vector3D(-200, 0, 300), Vector3D(1, 0, 0)).second, 500, 1e-9);
+    EXPECT_NEAR(mesh.DistanceToBorder(Vector3D(100, 200, 300), Vector3D(0, 0, -1)).first, 200, 1e-9);
+    EXPECT_LT(mesh.DistanceToBorder(Vector3D(100, 200, 300), Vector3D(0, 0, -1)).second, 0);
+
+    // On the border moving outside
+    EXPECT_TRUE(mesh.IsBehind(Vector3D(300, 200, 300), Vector3D(1, 0, 0)));
+    EXPECT_TRUE(mesh.IsInside(Vector3D(300, 200, 300), Vector3D(-1, 0, 0)));
+}
+
+TEST(DistanceTo, ExtrudedPolygon)
+{
+    std::vector<Vector3D> square = { Vector3D(-1, -2, 0), Vector3D(1, -2, 0), Vector3D(1, 2, 0), Vector3D(-1, 2, 0) };
+    ExtrudedPolygon polygon(Vector3D(1, 2, 3), square, 6);
+    Box box(Vector3D(1, 2, 3), 2, 4, 6);
+
+    // L shape of two boxes
+    std::vector<Vector3D> corners = { Vector3D(0, 0, 0), Vector3D(4, 0, 0), Vector3D(4, 1, 0),
+                                      Vector3D(1, 1, 0), Vector3D(1, 4, 0), Vector3D(0, 4, 0) };
+    ExtrudedPolygon shape(Vector3D(0, 0, 0), corners, 2);
+    Box bottom(Vector3D(2, 0.5, 0), 4, 1, 2);
+    Box left(Vector3D(0.5, 2.5, 0), 1, 3, 2);
+
+    EXPECT_TRUE(polygon.GetBoundingBox() == box.GetBoundingBox());
+
+    RandomGenerator::Get().SetSeed(1234);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        Vector3D position(1000 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                          1000 * (RandomGenerator::Get().RandomDouble() - 0.5),
+                          1000 * (RandomGenerator::Get().RandomDouble() - 0.5));
+        Vector3D direction(RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5);
+        direction.normalise();
+
+        std::pair<double, double> expected = box.DistanceToBorder(position, direction);
+        std::pair<double, double> distance = polygon.DistanceToBorder(position, direction);
+
+        EXPECT_NEAR(distance.first, expected.first, 1e-9);
+        EXPECT_NEAR(distance.second, expected.second, 1e-9);
+
+        // Inside of the L, if inside of one of the boxes
+        position = 0.5 * position + Vector3D(200, 200, 0);
+
+        bool inside = bottom.IsInside(position, direction) || left.IsInside(position, direction);
+        EXPECT_EQ(shape.IsInside(position, direction), inside);
+
+        // Along z
+        direction = Vector3D(0, 0, RandomGenerator::Get().RandomDouble() > 0.5 ? 1 : -1);
+
+        inside = bottom.IsInside(position, direction) || left.IsInside(position, direction);
+        EXPECT_EQ(shape.IsInside(position, direction), inside);
+    }
+
+    // Leaves the L and enters it again
+    std::pair<double, double> distance = shape.DistanceToBorder(Vector3D(350, 50, 0), Vector3D(-1, 1, 0) * (1 / std::sqrt(2.)));
+    EXPECT_NEAR(distance.first, 50 * std::sqrt(2.), 1e-9);
+    EXPECT_LT(distance.second, 0);
+
+    distance = shape.DistanceToBorder(Vector3D(300, 300, 0), Vector3D(-1, -1, 0) * (1 / std::sqrt(2.)));
+    EXPECT_NEAR(distance.first, 200 * std::sqrt(2.), 1e-9);
+    EXPECT_NEAR(distance.second, 300 * std::sqrt(2.), 1e-9);
+
+    // Through a corner
+    distance = shape.DistanceToBorder(Vector3D(200, 200, 0), Vector3D(-1, -1, 0) * (1 / std::sqrt(2.)));
+    EXPECT_NEAR(distance.first, 100 * std::sqrt(2.), 1e-9);
+    EXPECT_NEAR(distance.second, 200 * std::sqrt(2.), 1e-9);
+}
+
+TEST(GeometryFactory, Polygons)
+{
+    GeometryFactory::Definition definition;
+    definition.shape    = GeometryFactory::ExtrudedPolygon;
+    definition.position = Vector3D(100, 200, 300);
+    definition.height   = 600;
+    definition.vertices = { Vector3D(-100, -200, 0), Vector3D(100, -200, 0), Vector3D(100, 200, 0), Vector3D(-100, 200, 0) };
+
+    Geometry* polygon = GeometryFactory::Get().CreateGeometry(definition);
+    EXPECT_TRUE(*polygon == ExtrudedPolygon(Vector3D(1, 2, 3),
+                                            { Vector3D(-1, -2, 0), Vector3D(1, -2, 0), Vector3D(1, 2, 0), Vector3D(-1, 2, 0) },
+                                            6));
+
+    std::vector<Vector3D> vertices;
+    std::vector<TriangleMesh::Triangle> triangles;
+    AddCube(Vector3D(0, 0, 0), 4, vertices, triangles);
+
+    definition.shape = GeometryFactory::TriangleMesh;
+    for (auto vertex : vertices)
+    {
+        definition.vertices.push_back(100 * vertex);
+    }
+    definition.vertices.erase(definition.vertices.begin(), definition.vertices.begin() + 4);
+    definition.triangles = triangles;
+
+    Geometry* mesh = GeometryFactory::Get().CreateGeometry(definition);
+    EXPECT_TRUE(*mesh == TriangleMesh(Vector3D(1, 2, 3), vertices, triangles));
+
+    TriangleMesh copy(*dynamic_cast<TriangleMesh*>(mesh));
+    EXPECT_TRUE(copy == *mesh);
+    EXPECT_TRUE(copy != *polygon);
+
+    delete polygon;
+    delete mesh;
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
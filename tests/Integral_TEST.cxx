@@ -209,6 +209,37 @@ TEST(IntegralValue, IntegrateWithLogSubstitution)
     }
 }
 
+TEST(IntegralValue, IntegrateBatch)
+{
+    double xmin = 2, xmax = 4;
+    int calls   = 0;
+
+    Integral::BatchIntegrand batch = [&calls](const std::vector<double>& x, std::vector<double>& result) {
+        ++calls;
+        result.resize(x.size());
+        for (size_t i = 0; i < x.size(); ++i)
+        {
+            result[i] = Testexp(x[i]);
+        }
+    };
+
+    for (int method = 1; method <= 5; ++method)
+    {
+        Integral Int(5, 20, 1e-6);
+        Integral Int_batch(5, 20, 1e-6);
+
+        double power = (method == 3 || method == 5) ? 2. : 0.;
+
+        calls = 0;
+        double CalcIntegral = Int.Integrate(xmin, xmax, Testexp, method, power);
+        double CalcIntegral_batch = Int_batch.IntegrateBatch(xmin, xmax, batch, method, power);
+
+        EXPECT_DOUBLE_EQ(CalcIntegral_batch, CalcIntegral);
+        EXPECT_GT(calls, 0);
+        EXPECT_LT(calls, 20);
+    }
+}
+
 TEST(QUADPACK, RombergIntegrationFailure)
 {
     double precision = 1e-4;
@@ -2,6 +2,9 @@
 #include <cmath>
 #include "gtest/gtest.h"
 #include "PROPOSAL/math/Interpolant.h"
+#include "PROPOSAL/math/UniformGridInterpolant.h"
+#include "PROPOSAL/crossection/parametrization/ParamTables.h"
+#include "PROPOSAL/math/RandomGenerator.h"
 
 using namespace PROPOSAL;
 
@@ -805,6 +808,72 @@ TEST(_2D_Interpol, All_On)
     delete Pol2;
 }
 
+TEST(UniformGrid_Interpol, Cubic_Polynomial_Is_Exact)
+{
+    auto cubic = [](double x) { return 2 - 3 * x + 0.5 * x * x - 0.25 * x * x * x; };
+
+    UniformGridInterpolant1D interpolant(cubic, -2, 3, 11);
+
+    for (double x = -2; x <= 3; x += 0.0137)
+    {
+        EXPECT_NEAR(interpolant.Interpolate(x), cubic(x), 1e-12);
+    }
+    EXPECT_NEAR(interpolant.Interpolate(3), cubic(3), 1e-12);
+}
+
+TEST(UniformGrid_Interpol, Precision_of_EXPX)
+{
+    auto function = [](double x) { return std::exp(-6 * x) * (1 + x); };
+
+    UniformGridInterpolant1D interpolant(function, 0, 1.5, 1024);
+
+    for (double x = 0; x < 1.5; x += 1.e-4)
+    {
+        EXPECT_NEAR(interpolant.Interpolate(x), function(x), 1e-9 * function(x));
+    }
+}
+
+TEST(UniformGrid_Interpol, Comparison)
+{
+    auto function = [](double x) { return x * x; };
+
+    UniformGridInterpolant1D A(function, 0, 1, 10);
+    UniformGridInterpolant1D B(function, 0, 1, 10);
+    UniformGridInterpolant1D C(function, 0, 2, 10);
+
+    EXPECT_TRUE(A == B);
+    EXPECT_TRUE(A != C);
+    EXPECT_TRUE(A == UniformGridInterpolant1D(A.GetY(), 0, 1));
+}
+
+TEST(UniformGrid_Interpol, Same_As_InterpolateArray)
+{
+    Interpolant interpolant(energies, y_nu_p, sigma_nu_p, 5, false, false, 5, false, false);
+    UniformGridInterpolant2D uniform(energies, y_nu_p, sigma_nu_p, 5);
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        double x1 = 3.9 + 11.2 * RandomGenerator::Get().RandomDouble();
+        // down to a bit below the smallest tabulated y, like the lower integration limit
+        double x2 = std::pow(10, (2.5 - x1) * RandomGenerator::Get().RandomDouble());
+
+        double result = interpolant.InterpolateArray(x1, x2);
+        EXPECT_NEAR(uniform.Interpolate(x1, x2), result, 1e-10 * std::abs(result));
+    }
+
+    // on the nodes
+    for (unsigned int i = 0; i < energies.size(); i += 7)
+    {
+        for (unsigned int j = 0; j < y_nu_p[i].size(); j += 3)
+        {
+            EXPECT_NEAR(uniform.Interpolate(energies[i], y_nu_p[i][j]), sigma_nu_p[i][j], 1e-12 * sigma_nu_p[i][j]);
+        }
+    }
+
+    EXPECT_TRUE(uniform == UniformGridInterpolant2D(energies, y_nu_p, sigma_nu_p, 5));
+    EXPECT_TRUE(uniform != UniformGridInterpolant2D(energies, y_nu_n, sigma_nu_n, 5));
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -54,6 +54,10 @@ TEST(Comparison, Comparison_not_equal)
     Medium* G = MediumFactory::Get().CreateMedium("WaTeR");
     EXPECT_TRUE(*E != *G);
 
+    // Media differing in the density correction only
+    EXPECT_TRUE(E->HasSameComposition(*F));
+    EXPECT_FALSE(C->HasSameComposition(*D));
+
     Components::Hydrogen a;
     Components::Oxygen b;
     EXPECT_TRUE(a != b);
@@ -1,6 +1,9 @@
 
+#include <thread>
+
 #include "gtest/gtest.h"
 
+#include "PROPOSAL/Constants.h"
 #include "PROPOSAL/particle/ParticleDef.h"
 
 using namespace PROPOSAL;
@@ -65,6 +68,53 @@ TEST(Assignment, Copyconstructor2)
     EXPECT_TRUE(A == B);
 }
 
+TEST(SharedDefinition, GetShared)
+{
+    ParticleDef A(MuMinusDef::Get());
+    ParticleDef B(MuMinusDef::Get());
+
+    const ParticleDef& shared = ParticleDef::GetShared(A);
+
+    EXPECT_TRUE(shared == A);
+    EXPECT_NE(&shared, &A);
+    EXPECT_EQ(&shared, &ParticleDef::GetShared(B));
+    EXPECT_EQ(&shared, &ParticleDef::GetShared(shared));
+    EXPECT_NE(&shared, &ParticleDef::GetShared(TauMinusDef::Get()));
+
+    // Same name, but different properties
+    ParticleDef heavy = ParticleDef::Builder().SetParticleDef(MuMinusDef::Get()).SetMass(2 * MMU).build();
+    EXPECT_NE(&shared, &ParticleDef::GetShared(heavy));
+    EXPECT_EQ(ParticleDef::GetShared(heavy).mass, 2 * MMU);
+}
+
+TEST(SharedDefinition, Threads)
+{
+    std::vector<const ParticleDef*> shared(8, NULL);
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < shared.size(); ++i)
+    {
+        threads.emplace_back([&shared, i]() {
+            for (int j = 0; j < 1000; ++j)
+            {
+                ParticleDef def(i % 2 ? static_cast<const ParticleDef&>(TauPlusDef::Get()) : TauMinusDef::Get());
+                shared[i] = &ParticleDef::GetShared(def);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < shared.size(); ++i)
+    {
+        EXPECT_EQ(shared[i], shared[i % 2]);
+    }
+    EXPECT_NE(shared[0], shared[1]);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
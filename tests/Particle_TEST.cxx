@@ -1,9 +1,15 @@
 
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
+#include <thread>
 
 #include "PROPOSAL/Constants.h"
+#include "PROPOSAL/Output.h"
 #include "PROPOSAL/particle/Particle.h"
+#include "PROPOSAL/particle/Secondary.h"
+#include "PROPOSAL/particle/SecondaryBuffer.h"
 #include "PROPOSAL/math/Vector3D.h"
 
 using namespace PROPOSAL;
@@ -114,6 +120,338 @@ TEST(Deflection, Deflection)
     }
 }
 
+TEST(Secondary, Record_of_Particle)
+{
+    Particle A(EMinusDef::Get());
+    A.SetPosition(Vector3D(1., 2., 3.));
+    A.SetDirection(Vector3D(0., 0., 1.));
+    A.SetEnergy(1e3);
+    A.SetParentParticleEnergy(1e5);
+    A.SetTime(1e-9);
+    A.SetPropagatedDistance(100.);
+
+    Secondary record = Secondary::Create(A);
+
+    EXPECT_EQ(record.type_id, DynamicData::Particle);
+    EXPECT_EQ(record.particle_def, &ParticleDef::GetShared(EMinusDef::Get()));
+    EXPECT_EQ(record.energy, 1e3);
+    EXPECT_EQ(record.parent_particle_energy, 1e5);
+    EXPECT_EQ(record.time, 1e-9);
+    EXPECT_EQ(record.propagated_distance, 100.);
+
+    // records of equal particles share the definition
+    Particle B(A);
+    EXPECT_EQ(Secondary::Create(B).particle_def, record.particle_def);
+
+    DynamicData* data = record.CreateDynamicData();
+    Particle* C       = dynamic_cast<Particle*>(data);
+
+    ASSERT_TRUE(C != NULL);
+    EXPECT_TRUE(C->GetParticleDef() == EMinusDef::Get());
+    EXPECT_EQ(C->GetEnergy(), A.GetEnergy());
+    EXPECT_EQ(C->GetMomentum(), A.GetMomentum());
+    EXPECT_EQ(C->GetPosition().GetZ(), 3.);
+    EXPECT_EQ(C->GetDirection().GetZ(), 1.);
+
+    delete data;
+}
+
+TEST(Secondary, Record_of_Loss)
+{
+    DynamicData A(DynamicData::Brems);
+    A.SetPosition(Vector3D(1., 2., 3.));
+    A.SetEnergy(1e3);
+
+    Secondary record = Secondary::Create(A);
+
+    EXPECT_EQ(record.type_id, DynamicData::Brems);
+    EXPECT_TRUE(record.particle_def == NULL);
+
+    DynamicData* data = record.CreateDynamicData();
+
+    EXPECT_TRUE(dynamic_cast<Particle*>(data) == NULL);
+    EXPECT_EQ(data->GetTypeId(), DynamicData::Brems);
+    EXPECT_EQ(data->GetEnergy(), 1e3);
+    EXPECT_EQ(data->GetPosition().GetY(), 2.);
+
+    delete data;
+}
+
+TEST(MemoryPool, Reuse)
+{
+    Particle* A    = new Particle(MuMinusDef::Get());
+    DynamicData* B = new DynamicData(DynamicData::Brems);
+    void* address_A = A;
+    void* address_B = B;
+    delete A;
+    delete B;
+
+    DynamicData* C = new Particle(EMinusDef::Get());
+    DynamicData* D = new DynamicData(DynamicData::Epair);
+    EXPECT_EQ(address_A, C);
+    EXPECT_EQ(address_B, D);
+
+    // deleted through the base class, the memory has to go back to the particles
+    delete C;
+    delete D;
+    Particle* E = new Particle(EMinusDef::Get());
+    EXPECT_EQ(address_A, E);
+    delete E;
+
+    std::vector<DynamicData*> event;
+    for (int i = 0; i < 1000; ++i)
+    {
+        event.push_back(new DynamicData(DynamicData::Epair));
+        event.push_back(new Particle(EMinusDef::Get()));
+    }
+    for (auto data : event)
+    {
+        delete data;
+    }
+    event.clear();
+
+    size_t chunks = MemoryPool::Get().GetNumberOfChunks();
+
+    for (int j = 0; j < 10; ++j)
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            event.push_back(new Particle(EMinusDef::Get()));
+            event.push_back(new DynamicData(DynamicData::Epair));
+        }
+        for (auto data : event)
+        {
+            delete data;
+        }
+        event.clear();
+    }
+
+    EXPECT_EQ(chunks, MemoryPool::Get().GetNumberOfChunks());
+}
+
+TEST(MemoryPool, Threads)
+{
+    // Every thread allocates from its own pool
+    std::vector<MemoryPool*> pools(4, NULL);
+    std::vector<char> valid(pools.size(), false);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < pools.size(); ++t)
+    {
+        threads.emplace_back([&pools, &valid, t]() {
+            pools[t]   = &MemoryPool::Get();
+            valid[t]   = true;
+            double sum = 0;
+
+            for (int j = 0; j < 100; ++j)
+            {
+                std::vector<Particle*> event;
+                for (int i = 0; i < 1000; ++i)
+                {
+                    event.push_back(new Particle(EMinusDef::Get()));
+                    event.back()->SetEnergy(i + 1);
+                }
+                for (auto particle : event)
+                {
+                    sum += particle->GetEnergy();
+                    delete particle;
+                }
+            }
+
+            valid[t] = sum == 100 * 500500.;
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t t = 0; t < pools.size(); ++t)
+    {
+        EXPECT_TRUE(valid[t]);
+        EXPECT_NE(pools[t], &MemoryPool::Get());
+
+        for (size_t u = 0; u < t; ++u)
+        {
+            EXPECT_NE(pools[t], pools[u]);
+        }
+    }
+
+    // The pool of a finished thread is reused
+    MemoryPool* pool = NULL;
+    std::thread([&pool]() { pool = &MemoryPool::Get(); }).join();
+
+    EXPECT_NE(std::find(pools.begin(), pools.end(), pool), pools.end());
+}
+
+TEST(MemoryPool, RemoteRelease)
+{
+    // Events produced in a worker and deleted by the consumer
+    std::vector<Particle*> event;
+    std::vector<MemoryPool*> pools;
+    std::vector<size_t> chunks;
+
+    for (int j = 0; j < 20; ++j)
+    {
+        std::thread([&]() {
+            pools.push_back(&MemoryPool::Get());
+            for (int i = 0; i < 1000; ++i)
+            {
+                event.push_back(new Particle(EMinusDef::Get()));
+            }
+            chunks.push_back(MemoryPool::Get().GetNumberOfChunks());
+        }).join();
+
+        for (auto particle : event)
+        {
+            delete particle;
+        }
+        event.clear();
+    }
+
+    // The finished worker hands its pool to the next one, which gets the
+    // memory released by the consumer back
+    for (size_t j = 1; j < pools.size(); ++j)
+    {
+        ASSERT_EQ(pools[j], pools[0]);
+        EXPECT_EQ(chunks[j], chunks[0]);
+    }
+}
+
+TEST(SecondaryBuffer, Columns)
+{
+    std::vector<Secondary> secondaries;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        DynamicData data(i % 2 == 0 ? DynamicData::Brems : DynamicData::Epair);
+        data.SetPosition(Vector3D(i, 2. * i, 3. * i));
+        data.SetDirection(Vector3D(0., 0., -1.));
+        data.SetEnergy(10. * i);
+        data.SetParentParticleEnergy(1e6);
+        data.SetTime(1e-9 * i);
+        data.SetPropagatedDistance(i);
+
+        secondaries.push_back(Secondary::Create(data));
+    }
+
+    Particle electron(EMinusDef::Get());
+    secondaries.push_back(Secondary::Create(electron));
+
+    SecondaryBuffer buffer;
+    buffer.Append(secondaries);
+
+    ASSERT_EQ(buffer.GetSize(), secondaries.size());
+
+    const int* type      = buffer.GetTypeId();
+    const double* z      = buffer.GetZ();
+    const double* energy = buffer.GetEnergy();
+    const double* time   = buffer.GetTime();
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(type[i], i % 2 == 0 ? DynamicData::Brems : DynamicData::Epair);
+        EXPECT_EQ(z[i], 3. * i);
+        EXPECT_EQ(energy[i], 10. * i);
+        EXPECT_EQ(time[i], 1e-9 * i);
+        EXPECT_EQ(buffer.GetDirectionZ()[i], -1.);
+        EXPECT_TRUE(buffer.GetParticleDef()[i] == NULL);
+    }
+
+    EXPECT_EQ(type[100], DynamicData::Particle);
+    EXPECT_EQ(buffer.GetParticleDef()[100], secondaries[100].particle_def);
+
+    Secondary record = buffer.Get(42);
+    EXPECT_EQ(record.type_id, secondaries[42].type_id);
+    EXPECT_EQ(record.position[1], secondaries[42].position[1]);
+    EXPECT_EQ(record.propagated_distance, secondaries[42].propagated_distance);
+
+    SecondaryBuffer pushed;
+    for (auto& secondary : secondaries)
+    {
+        pushed.Push(secondary);
+    }
+    EXPECT_TRUE(pushed == buffer);
+
+    buffer.Append(secondaries);
+    EXPECT_EQ(buffer.GetSize(), 2 * secondaries.size());
+    EXPECT_TRUE(pushed != buffer);
+
+    buffer.Clear();
+    EXPECT_EQ(buffer.GetSize(), 0u);
+}
+
+TEST(SecondarySink, Callback)
+{
+    Output& output = Output::getInstance();
+    output.ClearSecondaryVector();
+
+    int count     = 0;
+    double energy = 0.;
+    auto callback = MakeSecondaryCallback([&](const Secondary& secondary) {
+        ++count;
+        energy += secondary.energy;
+    });
+
+    output.SetSecondarySink(&callback);
+    EXPECT_EQ(output.GetSecondarySink(), &callback);
+
+    for (int i = 1; i <= 10; ++i)
+    {
+        DynamicData data(DynamicData::Brems);
+        data.SetEnergy(i);
+        output.FillSecondaryVector(Secondary::Create(data));
+    }
+
+    Particle electron(EMinusDef::Get());
+    electron.SetEnergy(100.);
+    output.FillSecondaryVector(Secondary::Create(electron));
+
+    EXPECT_EQ(count, 11);
+    EXPECT_EQ(energy, 155.);
+    EXPECT_TRUE(output.GetSecondaryRecords().empty());
+
+    SecondaryBuffer buffer;
+    output.SetSecondarySink(&buffer);
+    output.FillSecondaryVector(Secondary::Create(electron));
+    EXPECT_EQ(buffer.GetSize(), 1u);
+
+    output.SetSecondarySink(NULL);
+    output.FillSecondaryVector(Secondary::Create(electron));
+    EXPECT_EQ(output.GetSecondaryRecords().size(), 1u);
+    EXPECT_EQ(count, 11);
+
+    output.ClearSecondaryVector();
+}
+
+TEST(SecondarySink, Scoped)
+{
+    Output& output = Output::getInstance();
+
+    SecondaryBuffer buffer;
+    auto throwing = MakeSecondaryCallback([](const Secondary&) { throw std::runtime_error("sink"); });
+
+    {
+        ScopedSecondarySink scoped_buffer(buffer);
+        EXPECT_EQ(output.GetSecondarySink(), &buffer);
+
+        try
+        {
+            ScopedSecondarySink scoped_throwing(throwing);
+            output.FillSecondaryVector(Secondary::Create(DynamicData(DynamicData::Brems)));
+            FAIL();
+        } catch (const std::runtime_error&)
+        {
+        }
+
+        // Restored after the exception
+        EXPECT_EQ(output.GetSecondarySink(), &buffer);
+    }
+
+    EXPECT_TRUE(output.GetSecondarySink() == NULL);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
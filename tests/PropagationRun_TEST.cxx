@@ -0,0 +1,166 @@
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+
+#include "PROPOSAL/PROPOSAL.h"
+
+using namespace PROPOSAL;
+
+namespace {
+
+std::vector<Sector::Definition> GetSectorDefinitions(double ecut)
+{
+    Sector::Definition sector_def;
+    sector_def.SetMedium(Water(1.0));
+    sector_def.SetGeometry(Sphere(Vector3D(), 1e20, 0));
+    sector_def.cut_settings              = EnergyCutSettings(ecut, 0.05);
+    sector_def.do_exact_time_calculation = false;
+
+    return std::vector<Sector::Definition>(1, sector_def);
+}
+
+void Generate(size_t event, Particle& mu)
+{
+    mu.SetEnergy(1e5 * (1 + event));
+    mu.SetPosition(Vector3D(0, 0, 0));
+    mu.SetDirection(Vector3D(0, 0, -1));
+    mu.SetPropagatedDistance(0);
+    mu.SetTime(0);
+}
+
+std::string ReadFile(const std::string& path)
+{
+    std::ifstream file(path.c_str());
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+} // namespace
+
+TEST(PropagationRun, Identity)
+{
+    InterpolationDef interpolation_def;
+    Sphere detector(Vector3D(), 1e18, 0);
+
+    Propagator prop_a(MuMinusDef::Get(), GetSectorDefinitions(500), detector, interpolation_def);
+    Propagator prop_b(MuMinusDef::Get(), GetSectorDefinitions(500), detector, interpolation_def);
+    Propagator prop_c(MuMinusDef::Get(), GetSectorDefinitions(400), detector, interpolation_def);
+    Propagator prop_d(TauMinusDef::Get(), GetSectorDefinitions(500), detector, interpolation_def);
+    Propagator prop_e(MuMinusDef::Get(), GetSectorDefinitions(500.0001), detector, interpolation_def);
+
+    EXPECT_EQ(PropagationRun::GetIdentity(prop_a), PropagationRun::GetIdentity(prop_b));
+    EXPECT_NE(PropagationRun::GetIdentity(prop_a), PropagationRun::GetIdentity(prop_c));
+    EXPECT_NE(PropagationRun::GetIdentity(prop_a), PropagationRun::GetIdentity(prop_d));
+
+    // Changes beyond the default precision of the streams
+    EXPECT_NE(PropagationRun::GetIdentity(prop_a), PropagationRun::GetIdentity(prop_e));
+
+    Propagator::Splitting splitting;
+    splitting.multiplicity = 2;
+    prop_b.SetSplitting(splitting);
+    EXPECT_NE(PropagationRun::GetIdentity(prop_a), PropagationRun::GetIdentity(prop_b));
+}
+
+TEST(PropagationRun, Resume)
+{
+    InterpolationDef interpolation_def;
+    Sphere detector(Vector3D(), 1e18, 0);
+    Propagator prop(MuMinusDef::Get(), GetSectorDefinitions(500), detector, interpolation_def);
+
+    // The weights of the split events must not carry over to the next event
+    Propagator::Splitting splitting;
+    splitting.multiplicity = 2;
+    prop.SetSplitting(splitting);
+
+    std::string reference_file  = "PropagationRun_reference.txt";
+    std::string resumed_file    = "PropagationRun_resumed.txt";
+    std::string reference_ckpt  = "PropagationRun_reference.ckpt";
+    std::string resumed_ckpt    = "PropagationRun_resumed.ckpt";
+    std::remove(reference_ckpt.c_str());
+    std::remove(resumed_ckpt.c_str());
+
+    size_t n_events     = 8;
+    size_t interval     = 3;
+    size_t interruption = 5;
+
+    std::ostream* output = NULL;
+    auto writer = [&](size_t event, const Particle& mu, const std::vector<Secondary>& secondaries) {
+        *output << std::setprecision(17) << event << ' ' << mu.GetEnergy() << ' ' << mu.GetPropagatedDistance();
+        for (auto secondary : secondaries)
+        {
+            *output << ' ' << secondary.energy << ' ' << secondary.weight;
+        }
+        *output << '\n';
+    };
+
+    // Run without interruption
+    RandomGenerator::Get().SetSeed(1234);
+    {
+        PropagationRun run(prop, reference_ckpt, interval);
+        EXPECT_FALSE(run.IsResumed());
+
+        output = &run.OpenOutput(reference_file);
+        EXPECT_EQ(run.Run(n_events, Generate, writer), n_events);
+    }
+
+    // Interrupted run, the events after the last checkpoint are written
+    // to the output, but not to the checkpoint
+    RandomGenerator::Get().SetSeed(1234);
+    try
+    {
+        PropagationRun run(prop, resumed_ckpt, interval);
+        output = &run.OpenOutput(resumed_file);
+
+        run.Run(n_events, Generate, [&](size_t event, const Particle& mu, const std::vector<Secondary>& secondaries) {
+            if (event == interruption)
+            {
+                throw std::runtime_error("preempted");
+            }
+            writer(event, mu, secondaries);
+        });
+        FAIL() << "The run should have been interrupted";
+    } catch (std::runtime_error&)
+    {
+    }
+
+    // The random number generator is restored from the checkpoint
+    RandomGenerator::Get().SetSeed(42);
+    {
+        PropagationRun run(prop, resumed_ckpt, interval);
+        ASSERT_TRUE(run.IsResumed());
+        EXPECT_EQ(run.GetEvent(), interval);
+
+        output = &run.OpenOutput(resumed_file);
+        EXPECT_EQ(run.Run(n_events, Generate, writer), n_events);
+    }
+
+    std::string reference = ReadFile(reference_file);
+    EXPECT_FALSE(reference.empty());
+    EXPECT_EQ(reference, ReadFile(resumed_file));
+
+    // A finished run is not propagated again
+    {
+        PropagationRun run(prop, resumed_ckpt, interval);
+        ASSERT_TRUE(run.IsResumed());
+        EXPECT_EQ(run.GetEvent(), n_events);
+
+        output = &run.OpenOutput(resumed_file);
+        EXPECT_EQ(run.Run(n_events, Generate, writer), n_events);
+    }
+    EXPECT_EQ(reference, ReadFile(resumed_file));
+
+    std::remove(reference_file.c_str());
+    std::remove(resumed_file.c_str());
+    std::remove(reference_ckpt.c_str());
+    std::remove(resumed_ckpt.c_str());
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -115,6 +115,50 @@ TEST(Assignment, Copyconstructor2)
     EXPECT_TRUE(prop_a == prop_b);
 }
 
+TEST(Assignment, SharedPhysics)
+{
+    Sector::Definition sector_def;
+    sector_def.location = Sector::ParticleLocation::InsideDetector;
+    sector_def.SetMedium(Water());
+    sector_def.SetGeometry(Sphere(Vector3D(), 100, 0));
+    sector_def.scattering_model            = ScatteringFactory::Moliere;
+    sector_def.cut_settings                = EnergyCutSettings(500, 0.05);
+    sector_def.do_continuous_randomization = true;
+
+    Sector::Definition sector_def_2 = sector_def;
+    sector_def_2.location           = Sector::ParticleLocation::BehindDetector;
+    sector_def_2.SetGeometry(Sphere(Vector3D(), 1000, 100));
+
+    Sector::Definition sector_def_3 = sector_def;
+    sector_def_3.SetMedium(Ice());
+
+    // Differs in the density correction only
+    Sector::Definition sector_def_4 = sector_def_2;
+    sector_def_4.SetMedium(Water(0.9));
+    sector_def_4.SetGeometry(Sphere(Vector3D(), 2000, 1000));
+
+    std::vector<Sector::Definition> sec_defs;
+    sec_defs.push_back(sector_def);
+    sec_defs.push_back(sector_def_3);
+    sec_defs.push_back(sector_def_2);
+    sec_defs.push_back(sector_def_4);
+
+    Propagator prop_a(MuMinusDef::Get(), sec_defs, Sphere());
+    std::vector<Sector*> sectors = prop_a.GetSectors();
+
+    EXPECT_TRUE(sectors[2]->SharesPhysics(*sectors[0]));
+    EXPECT_FALSE(sectors[1]->SharesPhysics(*sectors[0]));
+    EXPECT_TRUE(sectors[3]->SharesPhysics(*sectors[0]));
+    EXPECT_TRUE(*sectors[3]->GetMedium() == Water(0.9));
+
+    Propagator prop_b(prop_a);
+    std::vector<Sector*> sectors_b = prop_b.GetSectors();
+
+    EXPECT_TRUE(prop_a == prop_b);
+    EXPECT_TRUE(sectors_b[2]->SharesPhysics(*sectors_b[0]));
+    EXPECT_FALSE(sectors_b[0]->SharesPhysics(*sectors[0]));
+}
+
 TEST(Propagation, Test_nan)
 {
     int statistic = 10;
@@ -279,6 +323,328 @@ TEST(Propagation, particle_type)
     in.close();
 }
 
+TEST(Propagation, SecondarySink)
+{
+    int statistic = 10;
+    double energy = 1e8;
+
+    Propagator prop_mu(MuMinusDef::Get(), "resources/config_ice.json");
+    Particle& mu = prop_mu.GetParticle();
+
+    std::vector<double> energies_stored;
+    RandomGenerator::Get().SetSeed(1234);
+
+    for (int i = 0; i < statistic; ++i)
+    {
+        mu.SetEnergy(energy);
+        mu.SetPropagatedDistance(0);
+        mu.SetPosition(Vector3D(0, 0, 0));
+        mu.SetDirection(Vector3D(0, 0, -1));
+
+        const std::vector<Secondary>& secondaries = prop_mu.PropagateSecondaries();
+
+        for (unsigned int j = 0; j < secondaries.size(); ++j)
+        {
+            energies_stored.push_back(secondaries[j].energy);
+        }
+    }
+
+    std::vector<double> energies_sink;
+    auto callback = MakeSecondaryCallback([&](const Secondary& secondary) { energies_sink.push_back(secondary.energy); });
+
+    RandomGenerator::Get().SetSeed(1234);
+
+    for (int i = 0; i < statistic; ++i)
+    {
+        mu.SetEnergy(energy);
+        mu.SetPropagatedDistance(0);
+        mu.SetPosition(Vector3D(0, 0, 0));
+        mu.SetDirection(Vector3D(0, 0, -1));
+
+        prop_mu.Propagate(callback);
+
+        EXPECT_TRUE(Output::getInstance().GetSecondaryRecords().empty());
+    }
+
+    EXPECT_TRUE(Output::getInstance().GetSecondarySink() == NULL);
+    ASSERT_EQ(energies_sink.size(), energies_stored.size());
+
+    for (unsigned int i = 0; i < energies_sink.size(); ++i)
+    {
+        EXPECT_EQ(energies_sink[i], energies_stored[i]);
+    }
+}
+
+TEST(Propagation, EventWeight)
+{
+    // The weight of a biased event does not carry over to the next one
+    Sphere world(Vector3D(0, 0, 0), 1e20, 0);
+    InterpolationDef interpolation_def;
+
+    Sector::Definition sector_def;
+    sector_def.location = Sector::ParticleLocation::InsideDetector;
+    sector_def.SetMedium(Water());
+    sector_def.SetGeometry(world);
+    sector_def.cut_settings                = EnergyCutSettings(500, 0.05);
+    sector_def.do_exact_time_calculation   = false;
+    sector_def.do_continuous_randomization = false;
+    sector_def.stopping_decay              = false;
+    sector_def.interaction_bias[DynamicData::NuclInt] = 10;
+
+    Propagator prop(MuMinusDef::Get(), std::vector<Sector::Definition>(1, sector_def), world, interpolation_def);
+    Particle& mu = prop.GetParticle();
+
+    double last_weight = 1;
+    auto sink          = MakeSecondaryCallback([&](const Secondary& secondary) { last_weight = secondary.weight; });
+
+    RandomGenerator::Get().SetSeed(1234);
+
+    int biased = 0;
+
+    for (int i = 0; i < 50; ++i)
+    {
+        mu.SetEnergy(1e6);
+        mu.SetPropagatedDistance(0);
+        mu.SetPosition(Vector3D(0, 0, 0));
+        mu.SetDirection(Vector3D(0, 0, -1));
+
+        last_weight = 1;
+        prop.Propagate(sink, 1e4);
+
+        EXPECT_DOUBLE_EQ(mu.GetWeight(), 1.);
+        EXPECT_DOUBLE_EQ(prop.GetPropagatedWeight(), last_weight);
+
+        if (prop.GetPropagatedWeight() != 1)
+            ++biased;
+    }
+
+    EXPECT_GT(biased, 0);
+
+    // The weight set by the caller is the start weight of every event
+    mu.SetWeight(2);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        mu.SetEnergy(1e6);
+        mu.SetPropagatedDistance(0);
+        mu.SetPosition(Vector3D(0, 0, 0));
+        mu.SetDirection(Vector3D(0, 0, -1));
+
+        last_weight = 2;
+        prop.Propagate(sink, 1e4);
+
+        EXPECT_DOUBLE_EQ(mu.GetWeight(), 2.);
+        EXPECT_DOUBLE_EQ(prop.GetPropagatedWeight(), last_weight);
+    }
+}
+
+TEST(Propagation, Splitting)
+{
+    Ice ice;
+    Sphere world(Vector3D(0, 0, 0), 1e20, 0);
+    Sphere detector(Vector3D(0, 0, -1e3), 5e2, 0);
+    InterpolationDef interpolation_def;
+
+    Sector::Definition sector_def;
+    sector_def.SetMedium(ice);
+    sector_def.do_exact_time_calculation = false;
+    sector_def.stopping_decay            = false;
+
+    std::vector<Sector::Definition> sector_defs(3, sector_def);
+    sector_defs[0].location = Sector::ParticleLocation::InfrontDetector;
+    sector_defs[0].SetGeometry(world);
+    sector_defs[0].cut_settings = EnergyCutSettings(-1, 0.05);
+    sector_defs[1].location     = Sector::ParticleLocation::InsideDetector;
+    sector_defs[1].SetGeometry(detector);
+    sector_defs[1].cut_settings = EnergyCutSettings(500, -1);
+    sector_defs[1].do_continuous_randomization = false;
+    sector_defs[2].location     = Sector::ParticleLocation::BehindDetector;
+    sector_defs[2].SetGeometry(world);
+    sector_defs[2].cut_settings = EnergyCutSettings(-1, 0.05);
+
+    Propagator prop(MuMinusDef::Get(), sector_defs, detector, interpolation_def);
+    Particle& mu = prop.GetParticle();
+
+    Propagator::Splitting splitting;
+    splitting.multiplicity = 5;
+
+    int statistic = 200;
+    double energy = 1e6;
+
+    // Weighted number of losses inside the detector per event
+    double losses[2] = {0, 0};
+    double weight    = 1;
+
+    auto sink = MakeSecondaryCallback([&](const Secondary& secondary) {
+        if (detector.IsInside(secondary.GetPosition(), secondary.GetDirection()))
+        {
+            EXPECT_DOUBLE_EQ(secondary.weight, weight / prop.GetSplitting().multiplicity);
+            losses[prop.GetSplitting().multiplicity > 1] += secondary.weight;
+        } else if (secondary.GetPosition().GetZ() > -5e4)
+        {
+            // Losses in front of the detector are not split
+            EXPECT_DOUBLE_EQ(secondary.weight, weight);
+        }
+    });
+
+    RandomGenerator::Get().SetSeed(1234);
+
+    for (int k = 0; k < 2; ++k)
+    {
+        if (k == 1)
+            prop.SetSplitting(splitting);
+
+        for (int i = 0; i < statistic; ++i)
+        {
+            mu.SetEnergy(energy);
+            mu.SetPropagatedDistance(0);
+            mu.SetPosition(Vector3D(0, 0, 0));
+            mu.SetDirection(Vector3D(0, 0, -1));
+            mu.SetWeight(weight);
+
+            prop.Propagate(sink);
+        }
+    }
+
+    ASSERT_GT(losses[0], 0);
+    EXPECT_NEAR(losses[1] / losses[0], 1., 0.1);
+
+    // Russian roulette in front of the detector
+    splitting.multiplicity    = 1;
+    splitting.roulette_energy = 2 * energy;
+    splitting.roulette_survival = 0.5;
+    prop.SetSplitting(splitting);
+
+    int terminated = 0;
+    auto discard   = MakeSecondaryCallback([](const Secondary&) {});
+
+    for (int i = 0; i < statistic; ++i)
+    {
+        mu.SetEnergy(energy);
+        mu.SetPropagatedDistance(0);
+        mu.SetPosition(Vector3D(0, 0, 0));
+        mu.SetDirection(Vector3D(0, 0, -1));
+        mu.SetWeight(weight);
+
+        prop.Propagate(discard);
+
+        if (prop.GetPropagatedWeight() == 0)
+        {
+            ++terminated;
+            EXPECT_GT(mu.GetPosition().GetZ(), -5e4);
+        } else
+        {
+            EXPECT_DOUBLE_EQ(prop.GetPropagatedWeight(), weight / splitting.roulette_survival);
+        }
+    }
+
+    EXPECT_NEAR(static_cast<double>(terminated) / statistic, 0.5, 0.15);
+
+    // Roulette in front of and splitting inside of the detector for events
+    // in a row, the weight is not set again
+    splitting.multiplicity = 5;
+    prop.SetSplitting(splitting);
+
+    int split_losses = 0;
+    auto check_split = MakeSecondaryCallback([&](const Secondary& secondary) {
+        if (detector.IsInside(secondary.GetPosition(), secondary.GetDirection()))
+        {
+            EXPECT_DOUBLE_EQ(secondary.weight, weight / splitting.roulette_survival / splitting.multiplicity);
+            ++split_losses;
+        }
+    });
+
+    for (int i = 0; i < statistic; ++i)
+    {
+        mu.SetEnergy(energy);
+        mu.SetPropagatedDistance(0);
+        mu.SetPosition(Vector3D(0, 0, 0));
+        mu.SetDirection(Vector3D(0, 0, -1));
+
+        prop.Propagate(check_split);
+
+        EXPECT_DOUBLE_EQ(mu.GetWeight(), weight);
+    }
+
+    EXPECT_GT(split_losses, 0);
+}
+
+TEST(Propagation, SectorCrossings)
+{
+    // Slabs with a higher energy cut than the surrounding ice, so the
+    // sector of a loss can be told from its energy
+    Sphere world(Vector3D(0, 0, 0), 1e20, 0);
+    InterpolationDef interpolation_def;
+
+    Sector::Definition sector_def;
+    sector_def.location = Sector::ParticleLocation::InsideDetector;
+    sector_def.SetMedium(Ice());
+    sector_def.SetGeometry(world);
+    sector_def.scattering_model            = ScatteringFactory::NoScattering;
+    sector_def.cut_settings                = EnergyCutSettings(500, -1);
+    sector_def.do_continuous_randomization = false;
+    sector_def.stopping_decay              = false;
+
+    double slab_cut = 1e4;
+
+    std::vector<Sector::Definition> sector_defs(1, sector_def);
+    std::vector<Box> slabs;
+
+    for (int i = 0; i < 20; ++i)
+    {
+        slabs.push_back(Box(Vector3D(0, 0, -20 - 40 * i), 100, 100, 20));
+        slabs.back().SetHierarchy(1);
+
+        sector_defs.push_back(sector_def);
+        sector_defs.back().SetMedium(StandardRock());
+        sector_defs.back().SetGeometry(slabs.back());
+        sector_defs.back().cut_settings = EnergyCutSettings(slab_cut, -1);
+    }
+
+    Propagator prop(MuMinusDef::Get(), sector_defs, world, interpolation_def);
+    Particle& mu = prop.GetParticle();
+
+    Vector3D direction(0.01, 0.02, -1);
+    direction.normalise();
+
+    int losses_in_slabs = 0;
+
+    auto sink = MakeSecondaryCallback([&](const Secondary& secondary) {
+        if (secondary.particle_def != NULL)
+            return;
+
+        // The particle is not deflected
+        Vector3D position = secondary.GetPosition();
+        Vector3D deviation = position - (position * direction) * direction;
+        EXPECT_LT(deviation.magnitude(), 1e-6 * position.magnitude());
+
+        for (auto& slab : slabs)
+        {
+            if (slab.IsInside(position, direction))
+            {
+                EXPECT_GE(secondary.energy, slab_cut);
+                ++losses_in_slabs;
+            }
+        }
+    });
+
+    RandomGenerator::Get().SetSeed(1234);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        mu.SetEnergy(1e8);
+        mu.SetPropagatedDistance(0);
+        mu.SetPosition(Vector3D(0, 0, 0));
+        mu.SetDirection(direction);
+
+        prop.Propagate(sink, 1e5);
+
+        EXPECT_NEAR(mu.GetPosition().magnitude(), 1e5, 1e-3);
+    }
+
+    EXPECT_GT(losses_in_slabs, 0);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -145,6 +145,56 @@ TEST(Assignment, Copyconstructor2)
     EXPECT_TRUE(sector_1 == sector_2);
 }
 
+TEST(Assignment, SharedPhysics)
+{
+    Particle mu = Particle(MuMinusDef::Get());
+    Water water(1.0);
+    Sphere geometry(Vector3D(), 1000, 0);
+    Box geometry_2(Vector3D(), 100, 100, 100);
+    EnergyCutSettings ecuts(500, 0.05);
+
+    Sector::Definition sector_def;
+    sector_def.location = Sector::ParticleLocation::InsideDetector;
+    sector_def.SetMedium(water);
+    sector_def.SetGeometry(geometry);
+    sector_def.scattering_model = ScatteringFactory::Moliere;
+    sector_def.cut_settings     = ecuts;
+
+    Sector::Definition sector_def_2 = sector_def;
+    sector_def_2.location           = Sector::ParticleLocation::InfrontDetector;
+    sector_def_2.SetGeometry(geometry_2);
+    EXPECT_TRUE(sector_def.HasSamePhysics(sector_def_2));
+
+    Sector::Definition sector_def_3 = sector_def;
+    sector_def_3.cut_settings       = EnergyCutSettings(400, 0.05);
+    EXPECT_FALSE(sector_def.HasSamePhysics(sector_def_3));
+
+    Sector sector_1(mu, sector_def);
+    Sector sector_2(mu, sector_def_2, sector_1);
+    EXPECT_TRUE(sector_2.SharesPhysics(sector_1));
+    EXPECT_EQ(&sector_1.GetUtility(), &sector_2.GetUtility());
+    EXPECT_EQ(sector_1.GetScattering(), sector_2.GetScattering());
+    EXPECT_TRUE(*sector_2.GetGeometry() == geometry_2);
+    EXPECT_EQ(sector_2.GetLocation(), Sector::ParticleLocation::InfrontDetector);
+
+    Sector sector_3(sector_2);
+    EXPECT_FALSE(sector_3.SharesPhysics(sector_2));
+    EXPECT_TRUE(sector_3 == sector_2);
+
+    // The physics does not depend on the density correction
+    Sector::Definition sector_def_4 = sector_def;
+    sector_def_4.SetMedium(Water(1.3));
+    EXPECT_TRUE(sector_def.HasSamePhysics(sector_def_4));
+
+    Sector sector_4(mu, sector_def_4, sector_1);
+    EXPECT_TRUE(sector_4.SharesPhysics(sector_1));
+    EXPECT_NE(sector_1.GetScattering(), sector_4.GetScattering());
+
+    Vector3D position(0, 0, 0);
+    EXPECT_DOUBLE_EQ(sector_1.GetMedium()->GetDensityDistribution().Evaluate(position), 1.0);
+    EXPECT_DOUBLE_EQ(sector_4.GetMedium()->GetDensityDistribution().Evaluate(position), 1.3);
+}
+
 TEST(Sector, Propagate)
 {
     std::ifstream in;
@@ -220,6 +270,249 @@ TEST(Sector, Propagate)
     }
 }
 
+TEST(Sector, RangePropagation)
+{
+    Particle mu(MuMinusDef::Get());
+    Water water(1.0);
+    Sphere geometry(Vector3D(), 1e6, 0);
+    InterpolationDef interpolation_def;
+
+    Sector::Definition sector_def;
+    sector_def.location = Sector::ParticleLocation::InfrontDetector;
+    sector_def.SetMedium(water);
+    sector_def.SetGeometry(geometry);
+    sector_def.cut_settings              = EnergyCutSettings(500, 0.05);
+    sector_def.do_exact_time_calculation = false;
+    sector_def.do_range_propagation      = true;
+
+    // The cuts do not matter, all losses are continuous
+    Sector::Definition sector_def_2 = sector_def;
+    sector_def_2.cut_settings       = EnergyCutSettings(400, 0.01);
+    EXPECT_TRUE(sector_def.HasSamePhysics(sector_def_2));
+    EXPECT_TRUE(sector_def.GetPropagationCutSettings() == EnergyCutSettings(-1, 1));
+
+    Sector::Definition sector_def_3   = sector_def;
+    sector_def_3.do_range_propagation = false;
+    EXPECT_FALSE(sector_def.HasSamePhysics(sector_def_3));
+
+    // Mean energy loss without randomization
+    Sector::Definition sector_def_mean          = sector_def_3;
+    sector_def_mean.do_continuous_randomization = false;
+    sector_def_mean.cut_settings                = EnergyCutSettings(-1, 1);
+
+    Sector sector(mu, sector_def, interpolation_def);
+    Sector sector_mean(mu, sector_def_mean, interpolation_def);
+
+    double energy   = 1e8;
+    double distance = 3e5;
+
+    mu.SetEnergy(energy);
+    mu.SetPosition(Vector3D(0, 0, 0));
+    mu.SetDirection(Vector3D(0, 0, -1));
+    double energy_mean = sector_mean.Propagate(distance);
+    ASSERT_GT(energy_mean, 0.);
+    ASSERT_LT(energy_mean, energy);
+
+    RandomGenerator::Get().SetSeed(1234);
+    Output::getInstance().ClearSecondaryVector();
+
+    int statistic    = 1000;
+    int stopped      = 0;
+    double sum       = 0;
+    double sum_sq    = 0;
+    double min_final = energy;
+    double max_final = 0;
+
+    for (int i = 0; i < statistic; ++i)
+    {
+        mu.SetEnergy(energy);
+        mu.SetPropagatedDistance(0);
+        mu.SetPosition(Vector3D(0, 0, 0));
+        mu.SetDirection(Vector3D(0, 0, -1));
+
+        double energy_final = sector.Propagate(distance);
+
+        // Some muons might stop or decay
+        if (energy_final < 0)
+        {
+            EXPECT_LT(-energy_final, distance);
+            ++stopped;
+            continue;
+        }
+
+        EXPECT_LE(energy_final, energy);
+        EXPECT_DOUBLE_EQ(mu.GetPropagatedDistance(), distance);
+
+        sum += energy_final;
+        sum_sq += energy_final * energy_final;
+        min_final = std::min(min_final, energy_final);
+        max_final = std::max(max_final, energy_final);
+    }
+
+    // No single losses are sampled, just decays of stopped muons
+    EXPECT_LE(Output::getInstance().GetSecondaryRecords().size(), 3u * stopped);
+    EXPECT_LT(stopped, statistic / 100);
+
+    EXPECT_LT(min_final, max_final);
+    EXPECT_NEAR(sum / (statistic - stopped), energy_mean, 0.2 * (energy - energy_mean));
+
+    // Full propagation with stochastic losses as reference. The energies are
+    // sampled from tables built by full propagation, so the mean energy
+    // agrees within the statistical uncertainty of both samples.
+    Sector sector_full(mu, sector_def_3, interpolation_def);
+
+    double sum_full    = 0;
+    double sum_sq_full = 0;
+    int survived_full  = 0;
+
+    for (int i = 0; i < statistic; ++i)
+    {
+        mu.SetEnergy(energy);
+        mu.SetPropagatedDistance(0);
+        mu.SetPosition(Vector3D(0, 0, 0));
+        mu.SetDirection(Vector3D(0, 0, -1));
+
+        double energy_final = sector_full.Propagate(distance);
+        Output::getInstance().ClearSecondaryVector();
+
+        if (energy_final > 0)
+        {
+            sum_full += energy_final;
+            sum_sq_full += energy_final * energy_final;
+            ++survived_full;
+        }
+    }
+
+    int survived       = statistic - stopped;
+    double mean_range  = sum / survived;
+    double mean_full   = sum_full / survived_full;
+    double error_range = std::sqrt((sum_sq / survived - mean_range * mean_range) / survived);
+    double error_full  = std::sqrt((sum_sq_full / survived_full - mean_full * mean_full) / survived_full);
+
+    EXPECT_NEAR(mean_range, mean_full, 4 * std::sqrt(error_range * error_range + error_full * error_full));
+
+    // Muons of 1 TeV mostly stop within 3 km of water. The fraction of the
+    // stopped muons and their mean range agree with full propagation.
+    energy = 1e6;
+
+    int stopped_range     = 0;
+    int stopped_full      = 0;
+    double sum_range      = 0;
+    double sum_sq_range   = 0;
+    double sum_range_full = 0;
+    double sum_sq_full_2  = 0;
+
+    for (int i = 0; i < statistic; ++i)
+    {
+        mu.SetEnergy(energy);
+        mu.SetPropagatedDistance(0);
+        mu.SetPosition(Vector3D(0, 0, 0));
+        mu.SetDirection(Vector3D(0, 0, -1));
+
+        double result = sector.Propagate(distance);
+
+        if (result < 0)
+        {
+            EXPECT_DOUBLE_EQ(mu.GetPropagatedDistance(), -result);
+            ++stopped_range;
+            sum_range += -result;
+            sum_sq_range += result * result;
+        }
+
+        mu.SetEnergy(energy);
+        mu.SetPropagatedDistance(0);
+        mu.SetPosition(Vector3D(0, 0, 0));
+        mu.SetDirection(Vector3D(0, 0, -1));
+
+        result = sector_full.Propagate(distance);
+        Output::getInstance().ClearSecondaryVector();
+
+        if (result < 0)
+        {
+            ++stopped_full;
+            sum_range_full += -result;
+            sum_sq_full_2 += result * result;
+        }
+    }
+
+    ASSERT_GT(stopped_full, statistic / 2);
+
+    double fraction = 0.5 * (stopped_range + stopped_full) / statistic;
+    EXPECT_NEAR(stopped_range, stopped_full, 4 * std::sqrt(2 * statistic * fraction * (1 - fraction)));
+
+    mean_range  = sum_range / stopped_range;
+    mean_full   = sum_range_full / stopped_full;
+    error_range = std::sqrt((sum_sq_range / stopped_range - mean_range * mean_range) / stopped_range);
+    error_full  = std::sqrt((sum_sq_full_2 / stopped_full - mean_full * mean_full) / stopped_full);
+
+    EXPECT_NEAR(mean_range, mean_full, 4 * std::sqrt(error_range * error_range + error_full * error_full));
+}
+
+TEST(Sector, BiasedSampling)
+{
+    Particle mu(MuMinusDef::Get());
+    Water water(1.0);
+    InterpolationDef interpolation_def;
+
+    Sector::Definition sector_def;
+    sector_def.SetMedium(water);
+    sector_def.cut_settings                = EnergyCutSettings(500, 0.05);
+    sector_def.do_exact_time_calculation   = false;
+    sector_def.do_continuous_randomization = false;
+    sector_def.stopping_decay              = false;
+
+    Sector::Definition sector_def_biased        = sector_def;
+    sector_def_biased.interaction_bias[DynamicData::NuclInt] = 10;
+    sector_def_biased.do_stochastic_loss_weighting = true;
+    sector_def_biased.stochastic_loss_weighting    = 1;
+    EXPECT_TRUE(sector_def != sector_def_biased);
+
+    Sector sector(mu, sector_def, interpolation_def);
+    Sector sector_biased(mu, sector_def_biased, interpolation_def);
+
+    double energy   = 1e6;
+    double distance = 1e4;
+    int statistic   = 2000;
+
+    // Number of photonuclear interactions and energy lost in stochastic
+    // losses per event, weighted
+    double nucl_int[2]    = {0, 0};
+    double energy_loss[2] = {0, 0};
+    Sector* sectors[2]    = {&sector, &sector_biased};
+
+    RandomGenerator::Get().SetSeed(1234);
+
+    for (int k = 0; k < 2; ++k)
+    {
+        auto sink = MakeSecondaryCallback([&](const Secondary& secondary) {
+            if (k == 0)
+            {
+                EXPECT_DOUBLE_EQ(secondary.weight, 1.);
+            }
+            if (secondary.type_id == DynamicData::NuclInt)
+            {
+                nucl_int[k] += secondary.weight;
+            }
+            energy_loss[k] += secondary.weight * secondary.energy;
+        });
+
+        for (int i = 0; i < statistic; ++i)
+        {
+            mu.SetEnergy(energy);
+            mu.SetPosition(Vector3D(0, 0, 0));
+            mu.SetDirection(Vector3D(0, 0, -1));
+            mu.SetPropagatedDistance(0);
+            mu.SetWeight(1);
+
+            sectors[k]->Propagate(distance, sink);
+        }
+    }
+
+    ASSERT_GT(nucl_int[0], 0);
+    EXPECT_NEAR(nucl_int[1] / nucl_int[0], 1., 0.2);
+    EXPECT_NEAR(energy_loss[1] / energy_loss[0], 1., 0.25);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
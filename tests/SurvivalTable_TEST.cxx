@@ -0,0 +1,165 @@
+
+#include "gtest/gtest.h"
+
+#include "PROPOSAL/PROPOSAL.h"
+
+using namespace PROPOSAL;
+
+Sector::Definition getSectorDefinition()
+{
+    Water water(1.0);
+    Sphere geometry(Vector3D(), 1e6, 0);
+
+    Sector::Definition sector_def;
+    sector_def.location = Sector::ParticleLocation::InsideDetector;
+    sector_def.SetMedium(water);
+    sector_def.SetGeometry(geometry);
+    sector_def.do_exact_time_calculation = false;
+    sector_def.cut_settings              = EnergyCutSettings(-1, 0.05);
+
+    return sector_def;
+}
+
+SurvivalTable::Definition getSurvivalDefinition()
+{
+    SurvivalTable::Definition survival_def;
+    survival_def.energy_min     = 1e4;
+    survival_def.energy_max     = 1e7;
+    survival_def.distance_min   = 1e2;
+    survival_def.distance_max   = 1e6;
+    survival_def.energy_nodes   = 8;
+    survival_def.distance_nodes = 12;
+    survival_def.quantile_nodes = 5;
+    survival_def.statistic      = 200;
+
+    return survival_def;
+}
+
+TEST(Comparison, Comparison_equal)
+{
+    InterpolationDef interpolation_def;
+    SurvivalTable table(MuMinusDef::Get(), getSectorDefinition(), interpolation_def, getSurvivalDefinition());
+    SurvivalTable table_2(table);
+
+    EXPECT_TRUE(table == table_2);
+    EXPECT_TRUE(table.GetDefinition() == getSurvivalDefinition());
+    EXPECT_TRUE(SurvivalTable::Definition() != getSurvivalDefinition());
+}
+
+TEST(SurvivalTable, Survival)
+{
+    InterpolationDef interpolation_def;
+    SurvivalTable table(MuMinusDef::Get(), getSectorDefinition(), interpolation_def, getSurvivalDefinition());
+
+    double energy = 1e6;
+
+    EXPECT_DOUBLE_EQ(table.GetSurvivalProbability(energy, 0), 1.);
+    EXPECT_NEAR(table.GetSurvivalProbability(energy, 1e3), 1., 1e-6);
+    EXPECT_NEAR(table.GetSurvivalProbability(energy, 1e6), 0., 1e-6);
+
+    double survival = 1.;
+    for (double distance = 1e2; distance <= 1e6; distance *= 2)
+    {
+        double survival_new = table.GetSurvivalProbability(energy, distance);
+        EXPECT_LE(survival_new, survival + 1e-6);
+        EXPECT_GE(survival_new, 0.);
+        survival = survival_new;
+    }
+
+    // More energetic muons reach further
+    EXPECT_GE(table.GetSurvivalProbability(1e7, 3e5), table.GetSurvivalProbability(1e5, 3e5));
+
+    // Linear extrapolation below the smallest distance
+    double survival_min = table.GetSurvivalProbability(energy, 1e2);
+    EXPECT_DOUBLE_EQ(table.GetSurvivalProbability(energy, 25), 1 - 0.25 * (1 - survival_min));
+
+    // Energies outside the tables are moved to the border
+    EXPECT_DOUBLE_EQ(table.GetSurvivalProbability(1e8, 3e5), table.GetSurvivalProbability(1e7, 3e5));
+}
+
+TEST(SurvivalTable, EnergyQuantile)
+{
+    InterpolationDef interpolation_def;
+    SurvivalTable table(MuMinusDef::Get(), getSectorDefinition(), interpolation_def, getSurvivalDefinition());
+
+    double energy   = 1e6;
+    double distance = 1e5;
+
+    EXPECT_DOUBLE_EQ(table.GetEnergyQuantile(energy, 0, 0.5), energy);
+
+    // Linear extrapolation of the energy loss below the smallest distance
+    double loss_min = energy - table.GetEnergyQuantile(energy, 1e2, 0.5);
+    EXPECT_NEAR(energy - table.GetEnergyQuantile(energy, 25, 0.5), 0.25 * loss_min, 1e-6 * loss_min);
+    EXPECT_LE(table.GetEnergyQuantile(energy, 1e2, 0.5), table.GetEnergyQuantile(energy, 25, 0.5));
+
+    double quantile = 0.;
+    for (double q = 0; q <= 1; q += 0.05)
+    {
+        double quantile_new = table.GetEnergyQuantile(energy, distance, q);
+        EXPECT_GE(quantile_new, quantile);
+        EXPECT_LE(quantile_new, energy);
+        quantile = quantile_new;
+    }
+
+    RandomGenerator::Get().SetSeed(1234);
+
+    double survival = table.GetSurvivalProbability(energy, distance);
+    int statistic   = 1000;
+    int survived    = 0;
+
+    for (int i = 0; i < statistic; ++i)
+    {
+        double final_energy = table.SampleEnergy(energy, distance, RandomGenerator::Get().RandomDouble());
+        EXPECT_LE(final_energy, energy);
+        EXPECT_GE(final_energy, 0.);
+
+        if (final_energy > 0)
+            ++survived;
+    }
+
+    EXPECT_NEAR(static_cast<double>(survived) / statistic, survival, 0.05);
+}
+
+TEST(SurvivalTable, Propagation)
+{
+    // The tables agree with propagating the muons directly
+    InterpolationDef interpolation_def;
+    Sector::Definition sector_def = getSectorDefinition();
+    SurvivalTable table(MuMinusDef::Get(), sector_def, interpolation_def, getSurvivalDefinition());
+
+    Particle mu(MuMinusDef::Get());
+    Sector sector(mu, sector_def, interpolation_def);
+
+    double energy   = 1e6;
+    double distance = 1e5;
+    int statistic   = 500;
+    int survived    = 0;
+    double sum      = 0;
+
+    RandomGenerator::Get().SetSeed(4321);
+
+    for (int i = 0; i < statistic; ++i)
+    {
+        mu.SetEnergy(energy);
+        mu.SetPosition(Vector3D(0, 0, 0));
+        mu.SetDirection(Vector3D(0, 0, -1));
+        mu.SetPropagatedDistance(0);
+
+        double final_energy = sector.Propagate(distance);
+        if (final_energy > 0)
+        {
+            ++survived;
+            sum += final_energy;
+        }
+    }
+
+    ASSERT_GT(survived, 0);
+    EXPECT_NEAR(static_cast<double>(survived) / statistic, table.GetSurvivalProbability(energy, distance), 0.1);
+    EXPECT_NEAR(sum / survived, table.GetEnergyQuantile(energy, distance, 0.5), 0.2 * energy);
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -184,39 +184,50 @@ TEST(Normalise, Operator)
     EXPECT_TRUE(A != C);
     EXPECT_TRUE(B != C);
     A.normalise();
-    C.SetSphericalCoordinates(1,0,0);
     EXPECT_TRUE(A == C);
     B.normalise();
     EXPECT_TRUE(B != C);
 }
 
-TEST(CalculateSphericalCoordinates, Conversion)
+TEST(GetSphericalCoordinates, Conversion)
 {
-    Vector3D A;
-    Vector3D B(1, 2, 2);
-    A.SetCartesianCoordinates(1, 2, 2);
+    Vector3D A(1, 2, 2);
+    Vector3D B(A);
+
+    Vector3D::SphericalCoordinates spherical = A.GetSphericalCoordinates();
     EXPECT_TRUE(A == B);
-    A.CalculateSphericalCoordinates();
-    EXPECT_TRUE(A != B);
-    B.SetSphericalCoordinates(3, std::atan2(2., 1.), std::acos(2. / 3.));
-    EXPECT_TRUE(B == A);
+    EXPECT_EQ(spherical.radius, 3);
+    EXPECT_EQ(spherical.azimuth, std::atan2(2., 1.));
+    EXPECT_EQ(spherical.zenith, std::acos(2. / 3.));
+
+    EXPECT_EQ(A.GetRadius(), spherical.radius);
+    EXPECT_EQ(A.GetPhi(), spherical.azimuth);
+    EXPECT_EQ(A.GetTheta(), spherical.zenith);
+
+    // The zenith of the null vector is set to zero
+    spherical = Vector3D().GetSphericalCoordinates();
+    EXPECT_EQ(spherical.radius, 0);
+    EXPECT_EQ(spherical.zenith, 0);
 }
 
-TEST(CalculateCartesianFromSpherical, Conversion)
+TEST(SetSphericalCoordinates, Conversion)
 {
     Vector3D A;
     Vector3D B;
     double epsilon = std::numeric_limits<double>::epsilon();
     A.SetCartesianCoordinates(1, 2, 2);
     B.SetSphericalCoordinates(3, std::atan2(2., 1.), std::acos(2. / 3.));
-    B.CalculateCartesianFromSpherical();
-    EXPECT_TRUE(A != B);
-    B.SetSphericalCoordinates(0, 0, 0);
     double error_factor = 2.;
     bool test_x = std::abs(A.GetX() - B.GetX()) < std::abs(std::min(A.GetX(), B.GetX())) * epsilon * error_factor;
     bool test_y = std::abs(A.GetY() - B.GetY()) < std::abs(std::min(A.GetY(), B.GetY())) * epsilon * error_factor;
     bool test_z = std::abs(A.GetZ() - B.GetZ()) < std::abs(std::min(A.GetZ(), B.GetZ())) * epsilon * error_factor;
-    EXPECT_TRUE(A == B || test_x && test_y && test_z);
+    EXPECT_TRUE(A == B || (test_x && test_y && test_z));
+}
+
+TEST(Size, Compact)
+{
+    // Just the cartesian coordinates are stored
+    EXPECT_EQ(sizeof(Vector3D), 3 * sizeof(double));
 }
 
 int main(int argc, char** argv)